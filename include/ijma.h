@@ -11,7 +11,16 @@
 
 #include "ijma/jma_factory.h"
 #include "ijma/sentence.h"
+#include "ijma/morpheme_graph.h"
+#include "ijma/morpheme_hierarchy.h"
+#include "ijma/morpheme_view.h"
+#include "ijma/morpheme_columns.h"
+#include "ijma/morpheme_sink.h"
+#include "ijma/token_stream.h"
+#include "ijma/term_frequency.h"
+#include "ijma/query_result.h"
 #include "ijma/analyzer.h"
+#include "ijma/analyzer_pool.h"
 #include "ijma/knowledge.h"
 
 #endif // IJMA_H
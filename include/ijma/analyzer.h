@@ -100,6 +100,20 @@ public:
      */
     virtual int runWithSentence(Sentence& sentence) = 0;
 
+    /**
+     * Execute the morphological analysis on each sentence as \e runWithSentence(), using multiple threads.
+     * Each thread has its own analyzer with the same options and knowledge, and the calling thread is one of them.
+     * The analyzers of the other threads are created in the first call needing them, and kept for the later calls
+     * until the knowledge is set again, so that a small batch does not pay for creating them.
+     * The sentences are split into chunks which are balanced among threads by work stealing,
+     * and it returns when all the sentences are analyzed.
+     * If threads are not supported on this platform, the sentences are analyzed in the calling thread.
+     * \param sentences the sentences to analyze, which are set as in \e runWithSentence()
+     * \param threadNum the number of threads, including the calling thread, which is better not more than the number of CPU cores
+     * \return 0 for fail on any sentence, 1 for success
+     */
+    virtual int runBatch(std::vector<Sentence>& sentences, int threadNum) = 0;
+
     /**
      * Execute the morphological analysis based on a paragraph string.
      * \param inStr paragraph string
@@ -301,16 +315,118 @@ public:
          */
         OPTION_TYPE_CONVERT_TO_UPPER_CASE,
 
+        /** Configure the maximum cost gap between the n-best results and the best result.
+         * If a positive value is configured, the n-best search stops expanding those paths,
+         * whose cost exceeds the cost of the best path by more than this value,
+         * so that fewer than \e OPTION_TYPE_NBEST results might be got, it is valid for below APIs:
+         * \e runWithSentence() when \e OPTION_TYPE_NBEST is larger than 1.
+         *
+         * It saves both memory and time on ambiguous sentences,
+         * as those candidates far worse than the best one are not searched at all.
+         *
+         * If a non-positive value is configured, there is no limit on the cost gap.
+         *
+         * Default value: 0
+         */
+        OPTION_TYPE_NBEST_COST_GAP,
+
+        /** Configure which fields of morphemes are given in the analysis result.
+         * The value is a bitwise-or combination of \e MorphemeField values,
+         * only the fields in the combination are extracted from dictionary,
+         * and the other fields are left as empty string, it is valid for below APIs:
+         * \e runWithSentence(), and also other APIs giving \e Morpheme as analysis result.
+         *
+         * As they are needed in analysis, the lexicon string and the index code of part-of-speech tag are always given.
+         * The output of \e runWithString() and \e runWithStream() is not affected by this option.
+         *
+         * Default value: \e MORPHEME_FIELD_ALL
+         */
+        OPTION_TYPE_MORPHEME_FIELDS,
+
+        /** Configure whether to output in the binary format of token stream, which is defined in "token_stream.h".
+         * If a non-zero value is configured, the one-best result is output as token stream in below APIs:
+         * \e runWithString(), \e runWithStream(),
+         * the input string of \e runWithString() or each input line of \e runWithStream() is output as a document,
+         * and in each token, the lexicon string is always written, while the POS string is written only if the option \e OPTION_TYPE_POS_TAGGING is non-zero.
+         * As the output might contain zero bytes, its length should be got by \e JMA_Analyzer::getOutputLength() in \e runWithString().
+         *
+         * If a zero value is configured, the output is in text format, such as "通常/名詞,一般  は/助詞,係助詞  ".
+         *
+         * Default value: 0
+         */
+        OPTION_TYPE_OUTPUT_TOKEN_STREAM,
+
+        /** Configure whether to normalize the input in analysis, using the character conversions enabled by
+         * \e OPTION_TYPE_CONVERT_TO_HIRAGANA, \e OPTION_TYPE_CONVERT_TO_KATAKANA,
+         * \e OPTION_TYPE_CONVERT_TO_HALF_WIDTH, \e OPTION_TYPE_CONVERT_TO_FULL_WIDTH,
+         * \e OPTION_TYPE_CONVERT_TO_LOWER_CASE and \e OPTION_TYPE_CONVERT_TO_UPPER_CASE.
+         * If a non-zero value is configured, each sentence is converted just before it is analyzed, it is valid for below APIs:
+         * \e runWithString(), \e runWithStream(), \e JMA_Analyzer::runWithView(), \e JMA_Analyzer::runWithColumns(),
+         * \e JMA_Analyzer::analyze() and \e JMA_Analyzer::analyzeSentence().
+         *
+         * In the analysis result, the lexicon of each morpheme is the normalized string,
+         * while its byte and character offsets are still in the original input,
+         * so that the original string could be got from the input.
+         * It avoids calling \e convertCharacters() on the whole input and keeping another copy of it.
+         *
+         * If a zero value is configured, the input is analyzed as it is.
+         *
+         * Default value: 0
+         */
+        OPTION_TYPE_NORMALIZE_INPUT,
+
+        /** Configure whether to analyze by greedy longest match instead of Viterbi search.
+         * If a non-zero value is configured, from the begin of each sentence, the longest word in system and user dictionaries is selected,
+         * the characters not in dictionaries are grouped into unknown words by character type,
+         * and the word with the lowest word cost is selected among the words in the same length.
+         * No lattice is built and no connection cost is used, so that it is faster while the boundaries and POS might differ from Viterbi search.
+         * It is valid for below APIs:
+         * \e runWithSentence() in one-best, \e runWithString(), \e runWithStream(), \e JMA_Analyzer::runWithView(), \e JMA_Analyzer::runWithColumns(),
+         * \e JMA_Analyzer::runWithHierarchy(), \e JMA_Analyzer::runWithTermFrequency(), \e JMA_Analyzer::runWithSegment(),
+         * \e JMA_Analyzer::analyze() and \e JMA_Analyzer::analyzeSentence(),
+         * while the n-best results and \e JMA_Analyzer::runGraph() are still got by Viterbi search.
+         *
+         * If a zero value is configured, the input is analyzed by Viterbi search.
+         *
+         * Default value: 0
+         */
+        OPTION_TYPE_LONGEST_MATCH,
+
+        /** Configure the number of worker threads to analyze the input lines in \e runWithStream().
+         * If a value larger than 1 is configured, the input is read in batches of lines,
+         * each batch is analyzed by one of the workers, which has its own analyzer with the same options and knowledge,
+         * and the output of batches is written in input order, so that it is the same as analyzing by one thread.
+         * The worker number is better not more than the number of CPU cores.
+         *
+         * If 0 or 1 is configured, or threads are not supported on this platform, the lines are analyzed in the calling thread.
+         *
+         * Default value: 0
+         */
+        OPTION_TYPE_STREAM_WORKER_NUM,
+
         OPTION_TYPE_NUM ///< the count of option types
     };
 
+    /**
+     * The optional fields of morpheme, used as the value of option \e OPTION_TYPE_MORPHEME_FIELDS.
+     */
+    enum MorphemeField
+    {
+        MORPHEME_FIELD_POS_STR = 1, ///< \e Morpheme::posStr_
+        MORPHEME_FIELD_BASE_FORM = 2, ///< \e Morpheme::baseForm_
+        MORPHEME_FIELD_READ_FORM = 4, ///< \e Morpheme::readForm_
+        MORPHEME_FIELD_NORM_FORM = 8, ///< \e Morpheme::normForm_
+        MORPHEME_FIELD_ALL = 15 ///< all the fields above
+    };
+
     /**
      * Set the option value for analysis.
      * \param nOption the option type
      * \param nValue the option value
      * \attention when \e nOption is \e OPTION_TYPE_NBEST, the invalid \e nValue less than 1 will take no effect.
+     * \note it could be overridden to update the settings depending on option values, and the overriding function should call this function.
      */
-    void setOption(OptionType nOption, double nValue);
+    virtual void setOption(OptionType nOption, double nValue);
 
     /**
      * Get the option value.
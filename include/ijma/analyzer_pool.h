@@ -0,0 +1,191 @@
+/** \file analyzer_pool.h
+ * Definition of class AnalyzerPool.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_ANALYZER_POOL_H
+#define JMA_ANALYZER_POOL_H
+
+#include "analyzer.h" // Analyzer::OptionType
+
+namespace jma
+{
+
+/**
+ * AnalyzerPool shares the analyzers of the same knowledge and options among threads.
+ * As an \e Analyzer must not be used by multiple threads at the same time,
+ * each thread checks out an analyzer from the pool, and returns it after analysis.
+ * The analyzers are created lazily until the maximum size, and the analyzer idle for a timeout is destroyed.
+ * A thread would get the analyzer it used last time if that one is idle, so that its memory is still in the CPU cache.
+ *
+ * Below is an example to analyze in a thread:
+ * \code
+ * // created once, and shared by threads
+ * AnalyzerPool* pool = JMA_Factory::instance()->createAnalyzerPool(knowledge, 8);
+ * pool->setOption(Analyzer::OPTION_TYPE_POS_TAGGING, 0);
+ *
+ * // in each thread
+ * {
+ *     AnalyzerPool::Handle handle(*pool); // wait if all the analyzers are in use
+ *     if(handle.get())
+ *         result = handle->runWithString("...");
+ * } // the analyzer is returned when handle is destroyed
+ * \endcode
+ */
+class AnalyzerPool
+{
+public:
+    /**
+     * Statistics is the counters of pool for monitoring.
+     */
+    struct Statistics
+    {
+        /** the maximum number of analyzers */
+        unsigned int maxSize_;
+
+        /** the number of analyzers created and not destroyed yet */
+        unsigned int size_;
+
+        /** the number of analyzers not checked out */
+        unsigned int idleSize_;
+
+        /** the number of checkouts */
+        unsigned long checkoutCount_;
+
+        /** the number of checkouts getting the analyzer used last time by the same thread */
+        unsigned long affinityCount_;
+
+        /** the number of checkouts waiting for an analyzer to be returned */
+        unsigned long waitCount_;
+
+        /** the total wait time in seconds */
+        double waitTime_;
+
+        /** the maximum wait time in seconds of a checkout */
+        double maxWaitTime_;
+
+        /** the number of analyzers created */
+        unsigned long createCount_;
+
+        /** the number of analyzers destroyed for idle */
+        unsigned long destroyCount_;
+    };
+
+    /**
+     * Handle checks out an analyzer when constructed, and returns it when destroyed.
+     */
+    class Handle
+    {
+    public:
+        /**
+         * Constructor, which waits if all the analyzers are in use.
+         * \param pool the pool to check out from
+         */
+        explicit Handle(AnalyzerPool& pool);
+
+        /**
+         * Destructor, which returns the analyzer to pool.
+         */
+        ~Handle();
+
+        /**
+         * Get the analyzer.
+         * \return the analyzer, 0 if it fails to create analyzer
+         */
+        Analyzer* get() const;
+
+        /**
+         * Access the analyzer.
+         * \return the analyzer
+         * \pre \e get() is not 0.
+         */
+        Analyzer* operator->() const;
+
+    private:
+        /** the pool */
+        AnalyzerPool& pool_;
+
+        /** the analyzer checked out */
+        Analyzer* analyzer_;
+
+        // disable copy
+        Handle(const Handle&);
+        Handle& operator=(const Handle&);
+    };
+
+    /**
+     * Constructor.
+     */
+    AnalyzerPool();
+
+    /**
+     * Destructor, which destroys all the analyzers.
+     * \pre all the analyzers are returned.
+     */
+    virtual ~AnalyzerPool();
+
+    /**
+     * Set the option value of all the analyzers, as \e Analyzer::setOption().
+     * The analyzers in use are not affected until they are checked out next time.
+     * \param nOption the option type
+     * \param nValue the option value
+     */
+    virtual void setOption(Analyzer::OptionType nOption, double nValue) = 0;
+
+    /**
+     * Get the option value of analyzers.
+     * \param nOption the option type
+     * \return the option value
+     */
+    virtual double getOption(Analyzer::OptionType nOption) const = 0;
+
+    /**
+     * Set the delimiter between word and POS tag of all the analyzers, as \e Analyzer::setPOSDelimiter().
+     * \param delimiter the delimiter, which should be kept while the pool is used
+     */
+    virtual void setPOSDelimiter(const char* delimiter) = 0;
+
+    /**
+     * Set the delimiter between words of all the analyzers, as \e Analyzer::setWordDelimiter().
+     * \param delimiter the delimiter, which should be kept while the pool is used
+     */
+    virtual void setWordDelimiter(const char* delimiter) = 0;
+
+    /**
+     * Set how long an analyzer could be idle before it is destroyed.
+     * \param seconds the timeout in seconds, negative value to keep the idle analyzers, the default value is 60
+     */
+    virtual void setIdleTimeout(double seconds) = 0;
+
+    /**
+     * Check out an analyzer, which waits if all the analyzers are in use and no more could be created.
+     * The options set in pool are applied, and those set on the analyzer by the last user are reset.
+     * \return the analyzer, 0 if it fails to create analyzer
+     * \attention the analyzer should be returned by \e checkin(), it is recommended to use \e Handle instead.
+     */
+    virtual Analyzer* checkout() = 0;
+
+    /**
+     * Return an analyzer.
+     * \param analyzer the analyzer got from \e checkout()
+     */
+    virtual void checkin(Analyzer* analyzer) = 0;
+
+    /**
+     * Destroy the analyzers idle for more than the timeout, which is also called in \e checkin().
+     * \return the number of analyzers destroyed
+     */
+    virtual unsigned int shrink() = 0;
+
+    /**
+     * Get the statistics.
+     * \param stat the statistics to set
+     */
+    virtual void getStatistics(Statistics& stat) const = 0;
+};
+
+} // namespace jma
+
+#endif // JMA_ANALYZER_POOL_H
@@ -14,6 +14,7 @@ namespace jma
 
 class Analyzer;
 class Knowledge;
+class AnalyzerPool;
 
 /**
  * JMA_Factory creates instances for Japanese morphological analysis.
@@ -39,6 +40,14 @@ public:
      */
     virtual Knowledge* createKnowledge();
 
+    /**
+     * Create an instance of \e AnalyzerPool, which creates the analyzers lazily.
+     * \param knowledge the knowledge of analyzers, whose dictionaries should be loaded, and which should be kept while the pool is used
+     * \param maxSize the maximum number of analyzers, which is better not more than the number of threads using the pool
+     * \return the pointer to instance, 0 if threads are not supported on this platform
+     */
+    virtual AnalyzerPool* createAnalyzerPool(Knowledge* knowledge, unsigned int maxSize);
+
 protected:
     /**
      * Constructor.
@@ -0,0 +1,142 @@
+/** \file morpheme_columns.h
+ * Definition of class MorphemeColumns.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_MORPHEME_COLUMNS_H
+#define JMA_MORPHEME_COLUMNS_H
+
+#include "sentence.h" // Morpheme, Sentence
+#include "morpheme_view.h" // MorphemeView
+
+#include <string>
+#include <vector>
+
+namespace jma
+{
+
+/**
+ * MorphemeColumns saves the one-best result in columns instead of a list of morphemes.
+ * Each field of the morphemes is saved in one contiguous array,
+ * and the strings of each field are saved in one string arena,
+ * so that the consumer could iterate a field in cache-friendly way without copying each string.
+ *
+ * Below is an example to iterate the lexicons:
+ * \code
+ * for(unsigned int i=0; i<columns.size(); ++i)
+ * {
+ *     const MorphemeColumns::Span& span = columns.lexicons_.spans_[i];
+ *     const char* lexicon = columns.lexicons_.arena_.data() + span.offset_;
+ *     // lexicon string is in range [lexicon, lexicon + span.length_)
+ *     columns.posCodes_[i] ...
+ * }
+ * \endcode
+ */
+struct MorphemeColumns
+{
+    /**
+     * Span is the position of a string, either in arena or in the analyzed sentence string.
+     */
+    struct Span
+    {
+        /** the byte or character offset */
+        unsigned int offset_;
+
+        /** the byte or character length */
+        unsigned int length_;
+    };
+
+    /**
+     * StringColumn saves the strings of a field.
+     */
+    struct StringColumn
+    {
+        /** the string arena, in which the strings are concatenated without separator */
+        std::string arena_;
+
+        /** the span of each string in arena */
+        std::vector<Span> spans_;
+
+        /**
+         * Append a string.
+         * \param str the string start
+         * \param length the byte length of string
+         */
+        void append(const char* str, unsigned int length);
+
+        /**
+         * Get a string.
+         * \param i the string index
+         * \param str the string to save the result
+         */
+        void get(unsigned int i, std::string& str) const;
+
+        /**
+         * Remove all the strings.
+         */
+        void clear();
+    };
+
+    /** the lexicon strings */
+    StringColumn lexicons_;
+
+    /** the index codes of part-of-speech tags */
+    std::vector<int> posCodes_;
+
+    /** the POS strings */
+    StringColumn posStrs_;
+
+    /** the term ids, -1 for those morphemes not in dictionary, see \e MorphemeView::termId_ */
+    std::vector<int> termIds_;
+
+    /** the base form strings */
+    StringColumn baseForms_;
+
+    /** the reading form strings */
+    StringColumn readForms_;
+
+    /** the normalized form strings */
+    StringColumn normForms_;
+
+    /** the byte offsets and lengths in the analyzed sentence string */
+    std::vector<Span> byteSpans_;
+
+    /** the character offsets and lengths in the analyzed sentence string */
+    std::vector<Span> charSpans_;
+
+    /**
+     * Get the number of morphemes.
+     * \return the number of morphemes
+     */
+    unsigned int size() const;
+
+    /**
+     * Remove all the morphemes.
+     * The memory of each column is reserved for reuse.
+     */
+    void clear();
+
+    /**
+     * Append a morpheme.
+     * \param view the morpheme view
+     */
+    void append(const MorphemeView& view);
+
+    /**
+     * Copy the morphemes into a morpheme list.
+     * \param list the list to append the morphemes
+     */
+    void toMorphemeList(MorphemeList& list) const;
+
+    /**
+     * Copy the morphemes as the one-best candidate of a sentence, which is the same as the result of \e Analyzer::runWithSentence() in one-best.
+     * \param sentence the sentence to add the candidate
+     */
+    void appendTo(Sentence& sentence) const;
+};
+
+} // namespace jma
+
+#endif // JMA_MORPHEME_COLUMNS_H
@@ -0,0 +1,92 @@
+/** \file morpheme_graph.h
+ * Definition of class MorphemeGraph.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_MORPHEME_GRAPH_H
+#define JMA_MORPHEME_GRAPH_H
+
+#include "sentence.h" // Morpheme
+
+#include <vector>
+
+namespace jma
+{
+
+/**
+ * MorphemeGraph saves the segmentation candidates of a sentence as a directed acyclic graph.
+ * Each graph node is a unique morpheme at its position in the sentence,
+ * and each path from \e BOS_INDEX to \e EOS_INDEX along the edges is a segmentation candidate,
+ * so that the morphemes shared by the candidates are saved only once.
+ * As the candidates are joined on their shared morphemes, a path might also join the parts of different candidates.
+ *
+ * Below is an example to iterate the edges:
+ * \code
+ * for(unsigned int i=0; i<graph.edges_.size(); ++i)
+ * {
+ *     const MorphemeGraph::Edge& edge = graph.edges_[i];
+ *     if(edge.from_ != MorphemeGraph::BOS_INDEX)
+ *         graph.nodes_[edge.from_].morpheme_ ...
+ *     if(edge.to_ != MorphemeGraph::EOS_INDEX)
+ *         graph.nodes_[edge.to_].morpheme_ ...
+ * }
+ * \endcode
+ */
+struct MorphemeGraph
+{
+    /** the node index of begin of sentence, used in \e Edge::from_ */
+    static const int BOS_INDEX = -1;
+
+    /** the node index of end of sentence, used in \e Edge::to_ */
+    static const int EOS_INDEX = -2;
+
+    /**
+     * Node is a morpheme with its position.
+     */
+    struct Node
+    {
+        /** the morpheme */
+        Morpheme morpheme_;
+
+        /** the byte offset of morpheme in the sentence */
+        int offset_;
+
+        /** the byte length of morpheme */
+        int length_;
+
+        /** whether the node is in the best path */
+        bool isBest_;
+    };
+
+    /**
+     * Edge connects two adjacent nodes.
+     */
+    struct Edge
+    {
+        /** the index of left node in \e nodes_, or \e BOS_INDEX */
+        int from_;
+
+        /** the index of right node in \e nodes_, or \e EOS_INDEX */
+        int to_;
+
+        /** whether the edge is in the best path */
+        bool isBest_;
+    };
+
+    /** the nodes in the order of their offsets */
+    std::vector<Node> nodes_;
+
+    /** the edges */
+    std::vector<Edge> edges_;
+
+    /**
+     * Remove all the nodes and edges.
+     */
+    void clear();
+};
+
+} // namespace jma
+
+#endif // JMA_MORPHEME_GRAPH_H
@@ -0,0 +1,65 @@
+/** \file morpheme_hierarchy.h
+ * Definition of class MorphemeHierarchy.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_MORPHEME_HIERARCHY_H
+#define JMA_MORPHEME_HIERARCHY_H
+
+#include "morpheme_view.h" // MorphemeViewList
+
+#include <vector>
+
+namespace jma
+{
+
+/**
+ * MorphemeHierarchy saves the analysis result of a sentence in two granularities.
+ * In the coarse-grained level, the compound words are combined and the user nouns are not decomposed,
+ * while in the fine-grained level, the compound words are not combined and the user nouns are decomposed.
+ * Each coarse-grained morpheme links to its fine-grained children in range [begin_, end_) of \e fine_.
+ *
+ * Below is an example to iterate the children:
+ * \code
+ * for(unsigned int i=0; i<hierarchy.coarse_.size(); ++i)
+ * {
+ *     const MorphemeView& coarse = hierarchy.coarse_[i];
+ *     for(unsigned int j=hierarchy.children_[i].begin_; j<hierarchy.children_[i].end_; ++j)
+ *         hierarchy.fine_[j] ...
+ * }
+ * \endcode
+ */
+struct MorphemeHierarchy
+{
+    /**
+     * Range is the children range in \e fine_.
+     */
+    struct Range
+    {
+        /** the index of first child */
+        unsigned int begin_;
+
+        /** the index after last child */
+        unsigned int end_;
+    };
+
+    /** the coarse-grained morphemes */
+    MorphemeViewList coarse_;
+
+    /** the fine-grained morphemes */
+    MorphemeViewList fine_;
+
+    /** the children range of each coarse-grained morpheme, which size is the same to \e coarse_ */
+    std::vector<Range> children_;
+
+    /**
+     * Remove all the morphemes.
+     */
+    void clear();
+};
+
+} // namespace jma
+
+#endif // JMA_MORPHEME_HIERARCHY_H
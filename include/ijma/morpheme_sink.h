@@ -0,0 +1,63 @@
+/** \file morpheme_sink.h
+ * Definition of class MorphemeSink.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_MORPHEME_SINK_H
+#define JMA_MORPHEME_SINK_H
+
+#include "morpheme_view.h" // MorphemeView
+
+namespace jma
+{
+
+/**
+ * MorphemeSink receives the analysis result in streaming way.
+ * In analysis, the sink methods are called in the order of each sentence and each morpheme,
+ * so that the result is consumed without saving it in \e Sentence or \e MorphemeList.
+ *
+ * Below is an example to count the morphemes:
+ * \code
+ * class CountSink : public MorphemeSink
+ * {
+ * public:
+ *     CountSink() : count_(0) {}
+ *     virtual void processMorpheme(const MorphemeView& view) { ++count_; }
+ *     int count_;
+ * };
+ *
+ * CountSink sink;
+ * analyzer->analyze(text, sink);
+ * \endcode
+ */
+class MorphemeSink
+{
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~MorphemeSink() {}
+
+    /**
+     * Called at the begin of each sentence.
+     * \param sentence the sentence string, which is valid until \e endSentence() is called
+     */
+    virtual void beginSentence(const char* sentence) {}
+
+    /**
+     * Called for each morpheme in the one-best result.
+     * \param view the morpheme view, whose strings are valid until \e endSentence() is called
+     */
+    virtual void processMorpheme(const MorphemeView& view) = 0;
+
+    /**
+     * Called at the end of each sentence.
+     */
+    virtual void endSentence() {}
+};
+
+} // namespace jma
+
+#endif // JMA_MORPHEME_SINK_H
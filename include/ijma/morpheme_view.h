@@ -0,0 +1,95 @@
+/** \file morpheme_view.h
+ * Definition of class MorphemeView.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_MORPHEME_VIEW_H
+#define JMA_MORPHEME_VIEW_H
+
+#include "sentence.h" // Morpheme
+
+#include <vector>
+
+namespace jma
+{
+
+/**
+ * MorphemeView is a morpheme whose strings are referred instead of copied.
+ * Each string is given by its start pointer and byte length, which is not null-terminated except \e posStr_.
+ * The strings refer into the input string, the dictionary and the analyzer,
+ * so that they are valid only until the next analysis by the same analyzer,
+ * and the input string should also be kept during that time.
+ */
+struct MorphemeView
+{
+    /** the lexicon string */
+    const char* lexicon_;
+
+    /** the byte length of lexicon string */
+    unsigned int lexiconLength_;
+
+    /** the index code of part-of-speech tag */
+    int posCode_;
+
+    /** the POS string, which is null-terminated */
+    const char* posStr_;
+
+    /**
+     * the term id, which is the entry index in system and user dictionaries.
+     * It is -1 for those morphemes not in dictionary, such as unknown word, compound word and decomposed user noun.
+     */
+    int termId_;
+
+    /** the base form string */
+    const char* baseForm_;
+
+    /** the byte length of base form string */
+    unsigned int baseFormLength_;
+
+    /** the reading form string */
+    const char* readForm_;
+
+    /** the byte length of reading form string */
+    unsigned int readFormLength_;
+
+    /** the normalized form string */
+    const char* normForm_;
+
+    /** the byte length of normalized form string */
+    unsigned int normFormLength_;
+
+    /** the byte offset in the analyzed sentence string, see \e Morpheme::byteOffset_ */
+    unsigned int byteOffset_;
+
+    /** the byte length in the analyzed sentence string */
+    unsigned int byteLength_;
+
+    /** the character offset in the analyzed sentence string */
+    unsigned int charOffset_;
+
+    /** the character length in the analyzed sentence string */
+    unsigned int charLength_;
+
+    /**
+     * Constructor.
+     * The strings are initialized with empty string,
+     * the index code of part-of-speech tag is initialized with -1, meaning that no part-of-speech tag is available,
+     * the term id is initialized with -1, and the offsets and lengths are initialized with 0.
+     */
+    MorphemeView();
+
+    /**
+     * Copy the strings and offsets into a morpheme.
+     * \param morph the morpheme to save the result
+     */
+    void toMorpheme(Morpheme& morph) const;
+};
+
+/** A list of morpheme views. */
+typedef std::vector<MorphemeView> MorphemeViewList;
+
+} // namespace jma
+
+#endif // JMA_MORPHEME_VIEW_H
@@ -0,0 +1,87 @@
+/** \file query_result.h
+ * Definition of class QueryResult.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_QUERY_RESULT_H
+#define JMA_QUERY_RESULT_H
+
+#include "morpheme_view.h" // MorphemeView, MorphemeViewList
+
+namespace jma
+{
+
+/**
+ * QueryResult saves the morpheme views of a short query, which is the result of \e JMA_Analyzer::runWithQuery().
+ * The first \e INLINE_CAPACITY views are stored inline in the instance,
+ * so that no heap memory is allocated for a short query,
+ * and the views more than that are appended into a vector.
+ *
+ * Below is an example to iterate the views:
+ * \code
+ * QueryResult result;
+ * analyzer->runWithQuery(query, result);
+ * for(unsigned int i=0; i<result.size(); ++i)
+ * {
+ *     const MorphemeView& view = result[i];
+ *     ...
+ * }
+ * \endcode
+ */
+class QueryResult
+{
+public:
+    /** the number of views stored inline */
+    static const unsigned int INLINE_CAPACITY = 32;
+
+    /**
+     * Constructor.
+     */
+    QueryResult();
+
+    /**
+     * Remove all the views, the memory is reserved for reuse.
+     */
+    void clear();
+
+    /**
+     * Append a view.
+     * \param view the morpheme view
+     */
+    void push_back(const MorphemeView& view);
+
+    /**
+     * Get the number of views.
+     * \return the view count
+     */
+    unsigned int size() const;
+
+    /**
+     * Check whether no view exists.
+     * \return true for empty, false for not
+     */
+    bool empty() const;
+
+    /**
+     * Get a view.
+     * \param i the view index, which should be less than \e size()
+     * \return the view
+     */
+    const MorphemeView& operator[](unsigned int i) const;
+
+private:
+    /** the views stored inline */
+    MorphemeView inlineViews_[INLINE_CAPACITY];
+
+    /** the views after the inline ones */
+    MorphemeViewList moreViews_;
+
+    /** the number of views */
+    unsigned int size_;
+};
+
+} // namespace jma
+
+#endif // JMA_QUERY_RESULT_H
@@ -48,10 +48,27 @@ struct Morpheme
      */
     std::string normForm_;
 
+    /**
+     * the byte offset of morpheme in the analyzed sentence string.
+     * For compound word, it is the range from its first to last combined morphemes,
+     * and for decomposed user noun, it is the range of each part within the user noun.
+     */
+    int byteOffset_;
+
+    /** the byte length of morpheme in the analyzed sentence string */
+    int byteLength_;
+
+    /** the character offset of morpheme in the analyzed sentence string, in the same range as \e byteOffset_ */
+    int charOffset_;
+
+    /** the character length of morpheme in the analyzed sentence string */
+    int charLength_;
+
     /**
      * Constructor.
      * The string value of lexicon, POS, base form, and reading form are initialized with empty string,
-     * and the index code of part-of-speech tag is initialized with -1, meaning that no part-of-speech tag is available.
+     * the index code of part-of-speech tag is initialized with -1, meaning that no part-of-speech tag is available,
+     * and the offsets and lengths are initialized with 0.
      */
     Morpheme();
 
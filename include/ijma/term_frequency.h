@@ -0,0 +1,186 @@
+/** \file term_frequency.h
+ * Definition of class TermFrequency.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_TERM_FREQUENCY_H
+#define JMA_TERM_FREQUENCY_H
+
+#include <string>
+#include <vector>
+
+namespace jma
+{
+
+/**
+ * TermFrequency counts the terms in a document, which is the result of \e JMA_Analyzer::runWithTermFrequency().
+ * The terms are accumulated in a hash table in open addressing,
+ * and each distinct term is saved once in the order of its first occurrence.
+ *
+ * Below is an example to iterate the terms:
+ * \code
+ * TermFrequency table(TermFrequency::KEY_TERM_ID);
+ * analyzer->runWithTermFrequency(text, table);
+ * for(unsigned int i=0; i<table.size(); ++i)
+ * {
+ *     const TermFrequency::Entry& entry = table.getEntry(i);
+ *     const char* str = table.getString(entry);
+ *     // term string is in range [str, str + entry.length_), which occurs entry.count_ times
+ * }
+ * \endcode
+ */
+class TermFrequency
+{
+public:
+    /**
+     * The key to identify a term.
+     */
+    enum KeyType
+    {
+        /**
+         * The morphemes in dictionary are identified by term id, so that the inflected forms are different terms,
+         * and the morphemes not in dictionary are identified by lexicon string.
+         */
+        KEY_TERM_ID,
+
+        /**
+         * The morphemes are identified by base form string, so that the inflected forms are the same term.
+         */
+        KEY_BASE_FORM
+    };
+
+    /**
+     * Entry is a distinct term.
+     */
+    struct Entry
+    {
+        /** the term id, -1 for the term identified by string */
+        int termId_;
+
+        /** the offset of term string in arena, which is the lexicon or base form of its first occurrence */
+        unsigned int offset_;
+
+        /** the byte length of term string */
+        unsigned int length_;
+
+        /** the number of occurrences */
+        unsigned int count_;
+
+        /** the hash value of key */
+        unsigned int hash_;
+    };
+
+    /**
+     * Constructor.
+     * \param keyType the key to identify a term
+     */
+    TermFrequency(KeyType keyType = KEY_TERM_ID);
+
+    /**
+     * Set the key to identify a term, which removes all the terms.
+     * \param keyType the key type
+     */
+    void setKeyType(KeyType keyType);
+
+    /**
+     * Get the key to identify a term.
+     * \return the key type
+     */
+    KeyType getKeyType() const;
+
+    /**
+     * Remove all the terms.
+     * The memory of the table is reserved for reuse.
+     */
+    void clear();
+
+    /**
+     * Add an occurrence of a term.
+     * \param termId the term id, -1 for not in dictionary, which is ignored in \e KEY_BASE_FORM
+     * \param str the lexicon in \e KEY_TERM_ID, or the base form in \e KEY_BASE_FORM
+     * \param length the byte length of \e str
+     */
+    void add(int termId, const char* str, unsigned int length);
+
+    /**
+     * Get the number of distinct terms.
+     * \return the number of terms
+     */
+    unsigned int size() const;
+
+    /**
+     * Get the total number of occurrences.
+     * \return the sum of counts
+     */
+    unsigned int getTotal() const;
+
+    /**
+     * Get a term in the order of its first occurrence.
+     * \param i the term index, which should be less than \e size()
+     * \return the term entry
+     */
+    const Entry& getEntry(unsigned int i) const;
+
+    /**
+     * Get the term string.
+     * \param entry the term entry
+     * \return the string start, which is not null-terminated, and valid until the table is modified
+     */
+    const char* getString(const Entry& entry) const;
+
+    /**
+     * Get the count of a term identified as in \e add().
+     * \param termId the term id, -1 for not in dictionary, which is ignored in \e KEY_BASE_FORM
+     * \param str the lexicon in \e KEY_TERM_ID, or the base form in \e KEY_BASE_FORM
+     * \param length the byte length of \e str
+     * \return the count, 0 for not exists
+     */
+    unsigned int getCount(int termId, const char* str, unsigned int length) const;
+
+private:
+    /**
+     * Get the hash value of a key.
+     * \param termId the term id, -1 for string key
+     * \param str the string key
+     * \param length the byte length of \e str
+     * \return the hash value
+     */
+    static unsigned int hashKey(int termId, const char* str, unsigned int length);
+
+    /**
+     * Find the slot of a key.
+     * \param termId the term id, -1 for string key
+     * \param str the string key
+     * \param length the byte length of \e str
+     * \param hash the hash value of key
+     * \return the slot index, which is either the slot of the key or an empty slot
+     */
+    unsigned int findSlot(int termId, const char* str, unsigned int length, unsigned int hash) const;
+
+    /**
+     * Double the slots, and insert the entries again.
+     */
+    void grow();
+
+private:
+    /** the key type */
+    KeyType keyType_;
+
+    /** the distinct terms in the order of first occurrence */
+    std::vector<Entry> entries_;
+
+    /** the hash table of entry index plus 1, 0 for empty slot, whose size is power of 2 */
+    std::vector<unsigned int> slots_;
+
+    /** the concatenated term strings */
+    std::string arena_;
+
+    /** the total number of occurrences */
+    unsigned int total_;
+};
+
+} // namespace jma
+
+#endif // JMA_TERM_FREQUENCY_H
@@ -0,0 +1,277 @@
+/** \file token_stream.h
+ * Definition of class TokenStreamWriter and TokenStreamReader.
+ *
+ * The token stream is a compact binary format of analysis result, which is a sequence of documents.
+ * Each unsigned integer is encoded as varint, that is, 7 bits in each byte from the lowest bits,
+ * with the highest bit set if more bytes follow.
+ * Each signed integer is zigzag encoded into unsigned integer as varint.
+ *
+ * \code
+ * document := payload-length payload
+ * payload  := fields token-count text-length token*
+ * token    := term-id+1 pos-code+1 byte-offset-delta byte-length char-offset-delta char-length [lexicon] [pos-string]
+ * string   := byte-length bytes
+ * \endcode
+ *
+ * The offset deltas are signed integers relative to the offsets of the previous token in the document,
+ * and the optional strings exist if the corresponding bits in \e fields are set.
+ * The \e text-length is the byte length of the document text, so that the reader could check each token is within the text.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_TOKEN_STREAM_H
+#define JMA_TOKEN_STREAM_H
+
+#include "morpheme_view.h" // MorphemeView
+
+#include <string>
+
+namespace jma
+{
+
+/**
+ * The optional strings in token stream.
+ */
+enum TokenStreamField
+{
+    TOKEN_STREAM_LEXICON = 1, ///< the lexicon string
+    TOKEN_STREAM_POS_STR = 2 ///< the POS string
+};
+
+/**
+ * TokenRecord is a token read from token stream.
+ */
+struct TokenRecord
+{
+    /** the term id, -1 for not in dictionary */
+    int termId_;
+
+    /** the index code of part-of-speech tag */
+    int posCode_;
+
+    /** the byte offset in document */
+    unsigned int byteOffset_;
+
+    /** the byte length */
+    unsigned int byteLength_;
+
+    /** the character offset in document */
+    unsigned int charOffset_;
+
+    /** the character length */
+    unsigned int charLength_;
+
+    /** the lexicon string, which is not null-terminated, empty if not in stream */
+    const char* lexicon_;
+
+    /** the byte length of lexicon string */
+    unsigned int lexiconLength_;
+
+    /** the POS string, which is not null-terminated, empty if not in stream */
+    const char* posStr_;
+
+    /** the byte length of POS string */
+    unsigned int posStrLength_;
+};
+
+/**
+ * TokenStreamWriter writes the morphemes into token stream.
+ *
+ * Below is an example to write a document:
+ * \code
+ * TokenStreamWriter writer(TOKEN_STREAM_LEXICON);
+ * writer.beginDocument();
+ * for(...)
+ *     writer.addToken(view);
+ * writer.endDocument(output);
+ * \endcode
+ */
+class TokenStreamWriter
+{
+public:
+    /**
+     * Constructor.
+     * \param fields the optional strings to write, the combination of \e TokenStreamField values
+     */
+    TokenStreamWriter(int fields = 0);
+
+    /**
+     * Set the optional strings to write, which takes effect from the next document.
+     * \param fields the combination of \e TokenStreamField values
+     */
+    void setFields(int fields);
+
+    /**
+     * Get the optional strings to write.
+     * \return the combination of \e TokenStreamField values
+     */
+    int getFields() const;
+
+    /**
+     * Start a new document, the tokens not ended by \e endDocument() are discarded.
+     */
+    void beginDocument();
+
+    /**
+     * Add a token into the current document.
+     * \param view the morpheme, whose offsets are in the document
+     */
+    void addToken(const MorphemeView& view);
+
+    /**
+     * End the current document, and append it to output.
+     * \param output the output to append the document
+     * \param textLength the byte length of the document text, which contains the tokens added
+     */
+    void endDocument(std::string& output, unsigned int textLength);
+
+private:
+    /** the optional strings to write */
+    int fields_;
+
+    /** the optional strings in current document */
+    int docFields_;
+
+    /** the number of tokens in current document */
+    unsigned int tokenCount_;
+
+    /** the byte offset of previous token */
+    unsigned int prevByteOffset_;
+
+    /** the character offset of previous token */
+    unsigned int prevCharOffset_;
+
+    /** the tokens in current document */
+    std::string tokens_;
+};
+
+/**
+ * TokenStreamReader reads the tokens from token stream in memory.
+ *
+ * Below is an example to read all the tokens:
+ * \code
+ * TokenStreamReader reader(data, length);
+ * TokenRecord token;
+ * while(reader.nextDocument())
+ * {
+ *     while(reader.nextToken(token))
+ *         ...
+ * }
+ * if(reader.isError())
+ *     ...
+ * \endcode
+ */
+class TokenStreamReader
+{
+public:
+    /**
+     * Constructor.
+     * \param data the start of token stream, which should be kept while reading
+     * \param length the byte length of token stream
+     */
+    TokenStreamReader(const char* data, unsigned int length);
+
+    /**
+     * Move to the next document, the rest tokens in current document are skipped.
+     * \return true for success, false if no more document exists or the stream is corrupted
+     */
+    bool nextDocument();
+
+    /**
+     * Read the next token in current document.
+     * \param token the token to save the result, whose strings refer into the stream
+     * \return true for success, false if no more token exists in current document or the stream is corrupted
+     */
+    bool nextToken(TokenRecord& token);
+
+    /**
+     * Get the optional strings in current document.
+     * \return the combination of \e TokenStreamField values
+     */
+    int getFields() const;
+
+    /**
+     * Get the number of tokens in current document.
+     * \return the number of tokens
+     */
+    unsigned int getTokenCount() const;
+
+    /**
+     * Get the byte length of the text of current document.
+     * \return the byte length
+     */
+    unsigned int getTextLength() const;
+
+    /**
+     * Check whether the stream is corrupted.
+     * \return true for corrupted, false for not
+     */
+    bool isError() const;
+
+private:
+    /**
+     * Read an unsigned integer.
+     * \param p the position to read, which is moved after the integer on success
+     * \param end the end of readable range
+     * \param value the value to save the result
+     * \return true for success, false for fail
+     */
+    bool readVarint(const char*& p, const char* end, unsigned int& value);
+
+    /**
+     * Read the offset and length of a token, and check the range is within the document text.
+     * \param p the position to read, which is moved after the integers on success
+     * \param prevOffset the offset of the previous token, which is within the document text
+     * \param offset the offset to save the result
+     * \param length the length to save the result
+     * \return true for success, false for fail
+     */
+    bool readRange(const char*& p, unsigned int prevOffset, unsigned int& offset, unsigned int& length);
+
+    /**
+     * Read a string.
+     * \param p the position to read, which is moved after the string on success
+     * \param end the end of readable range
+     * \param str the string start to save the result
+     * \param length the string length to save the result
+     * \return true for success, false for fail
+     */
+    bool readString(const char*& p, const char* end, const char*& str, unsigned int& length);
+
+private:
+    /** the current position */
+    const char* pos_;
+
+    /** the end of stream */
+    const char* end_;
+
+    /** the end of current document */
+    const char* docEnd_;
+
+    /** the optional strings in current document */
+    int fields_;
+
+    /** the number of tokens in current document */
+    unsigned int tokenCount_;
+
+    /** the number of tokens read in current document */
+    unsigned int readCount_;
+
+    /** the byte length of the text of current document */
+    unsigned int textLength_;
+
+    /** the byte offset of previous token */
+    unsigned int prevByteOffset_;
+
+    /** the character offset of previous token */
+    unsigned int prevCharOffset_;
+
+    /** whether the stream is corrupted */
+    bool isError_;
+};
+
+} // namespace jma
+
+#endif // JMA_TOKEN_STREAM_H
@@ -0,0 +1,163 @@
+/** \file batch_scheduler.h
+ * Definition of class BatchScheduler.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_BATCH_SCHEDULER_H
+#define JMA_BATCH_SCHEDULER_H
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // HAVE_PTHREAD_H
+#endif
+
+#include <vector>
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+
+/** whether the sentences could be analyzed by multiple threads */
+#define JMA_USE_BATCH_SCHEDULER 1
+#endif
+
+namespace jma
+{
+
+class JMA_Analyzer;
+class Sentence;
+
+#ifdef JMA_USE_BATCH_SCHEDULER
+
+/**
+ * BatchScheduler analyzes the sentences in parallel by work stealing, which is used by \e JMA_Analyzer::runBatch().
+ * The sentences are split into a contiguous range for each worker, in about the same number of bytes.
+ * Each worker takes a chunk from the front of its own range at a time,
+ * whose size decreases with the bytes left in range, so that the last chunks are small.
+ * When its own range is empty, a worker steals the back half of the range having the most bytes left,
+ * so that the workers are kept busy on skewed sentence lengths.
+ */
+class BatchScheduler
+{
+public:
+    /**
+     * Constructor.
+     * \param workers the analyzers configured in the same way, one for each worker, the first one is used in the calling thread
+     * \param sentences the sentences to analyze
+     */
+    BatchScheduler(const std::vector<JMA_Analyzer*>& workers, std::vector<Sentence>& sentences);
+
+    /**
+     * Destructor.
+     */
+    ~BatchScheduler();
+
+    /**
+     * Analyze all the sentences, which returns when all are done.
+     * \return 0 for fail on any sentence, 1 for success
+     */
+    int run();
+
+    /**
+     * Analyze the chunks got by a worker until all are done, which is called by each worker thread.
+     * \param worker the worker index
+     * \return 0 for fail on any sentence, 1 for success
+     */
+    int runWorker(unsigned int worker);
+
+    /**
+     * Get the number of ranges stolen in \e run().
+     * \return the steal count
+     */
+    unsigned long getStealCount() const;
+
+private:
+    /**
+     * Range is the sentences left for a worker, which is modified by its owner and thieves.
+     */
+    struct Range
+    {
+        /** the first sentence */
+        unsigned int begin_;
+
+        /** the end of sentences */
+        unsigned int end_;
+
+        /** the lock on range */
+        pthread_mutex_t mutex_;
+
+        /** avoid sharing cache line with other ranges */
+        char padding_[64];
+    };
+
+    /**
+     * Get the next chunk of a worker.
+     * \param worker the worker index
+     * \param begin the first sentence of chunk
+     * \param end the end of chunk
+     * \return true for success, false if all the sentences are taken
+     */
+    bool next(unsigned int worker, unsigned int& begin, unsigned int& end);
+
+    /**
+     * Take a chunk from the front of own range.
+     * \param worker the worker index
+     * \param begin the first sentence of chunk
+     * \param end the end of chunk
+     * \return true for success, false if own range is empty
+     */
+    bool take(unsigned int worker, unsigned int& begin, unsigned int& end);
+
+    /**
+     * Steal the back half of the range having the most bytes left into own range.
+     * \param worker the worker index
+     * \return true for success, false if all the ranges are empty
+     */
+    bool steal(unsigned int worker);
+
+    /**
+     * Get the bytes of sentences in range.
+     * \param begin the first sentence
+     * \param end the end of sentences
+     * \return the byte count
+     */
+    unsigned long getBytes(unsigned int begin, unsigned int end) const;
+
+    /**
+     * Get the first sentence ending after an offset in bytes.
+     * \param begin the first sentence to search
+     * \param end the end of sentences to search
+     * \param offset the byte offset from the first sentence in batch
+     * \return the sentence index in [begin, end]
+     */
+    unsigned int findSentence(unsigned int begin, unsigned int end, unsigned long offset) const;
+
+private:
+    /** the analyzers of workers */
+    std::vector<JMA_Analyzer*> workers_;
+
+    /** the sentences */
+    std::vector<Sentence>& sentences_;
+
+    /** the byte offset of each sentence as if they were concatenated, with the total bytes at last */
+    std::vector<unsigned long> offsets_;
+
+    /** the range of each worker */
+    std::vector<Range*> ranges_;
+
+    /** the number of ranges stolen */
+    unsigned long stealCount_;
+
+    /** the lock on \e stealCount_ */
+    pthread_mutex_t stealMutex_;
+
+    // disable copy
+    BatchScheduler(const BatchScheduler&);
+    BatchScheduler& operator=(const BatchScheduler&);
+};
+
+#endif // JMA_USE_BATCH_SCHEDULER
+
+} // namespace jma
+
+#endif // JMA_BATCH_SCHEDULER_H
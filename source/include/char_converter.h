@@ -0,0 +1,237 @@
+/** \file char_converter.h
+ * Definition of class CharConverter.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_CHAR_CONVERTER_H
+#define JMA_CHAR_CONVERTER_H
+
+#include "char_table.h" // CharTable::CharMap
+
+#include <string>
+#include <vector>
+
+namespace jma
+{
+
+class JMA_CType;
+
+/**
+ * OffsetMap maps the offsets in the converted string back to the original string.
+ * Only the characters converted into different length are saved,
+ * and the offsets between them are moved by the same distance.
+ */
+class OffsetMap
+{
+public:
+    /**
+     * Remove all the characters.
+     */
+    void clear();
+
+    /**
+     * Reserve the memory for the characters converted into different length.
+     * \param count the number of characters
+     */
+    void reserve(unsigned int count);
+
+    /**
+     * Add a converted character, which is saved only if its length is changed.
+     * The characters should be added in the order of offsets.
+     * \param origByte the byte offset in original string
+     * \param origByteLength the byte length in original string
+     * \param origChar the character offset in original string
+     * \param convByte the byte offset in converted string
+     * \param convByteLength the byte length in converted string
+     * \param convChar the character offset in converted string
+     * \param convCharLength the character length in converted string
+     */
+    void addChar(unsigned int origByte, unsigned int origByteLength, unsigned int origChar,
+            unsigned int convByte, unsigned int convByteLength, unsigned int convChar, unsigned int convCharLength);
+
+    /**
+     * Get the byte offset in original string.
+     * \param offset the byte offset in converted string
+     * \param isEnd if the offset is within the output of a character,
+     * true to return the end of that character, false to return its start
+     * \return the byte offset in original string
+     */
+    unsigned int toOriginalByte(unsigned int offset, bool isEnd) const;
+
+    /**
+     * Get the character offset in original string.
+     * \param offset the character offset in converted string
+     * \param isEnd if the offset is within the output of a character,
+     * true to return the end of that character, false to return its start
+     * \return the character offset in original string
+     */
+    unsigned int toOriginalChar(unsigned int offset, bool isEnd) const;
+
+private:
+    /**
+     * Segment is a character converted into different length.
+     */
+    struct Segment
+    {
+        /** the offset in converted string */
+        unsigned int convOffset_;
+
+        /** the length in converted string */
+        unsigned int convLength_;
+
+        /** the offset in original string */
+        unsigned int origOffset_;
+
+        /** the length in original string */
+        unsigned int origLength_;
+    };
+
+    /**
+     * Get the offset in original string.
+     * \param segments the segments in the order of offsets
+     * \param offset the offset in converted string
+     * \param isEnd whether to return the end of character if \e offset is within its output
+     * \return the offset in original string
+     */
+    static unsigned int toOriginal(const std::vector<Segment>& segments, unsigned int offset, bool isEnd);
+
+private:
+    /** the characters converted into different byte length */
+    std::vector<Segment> byteSegments_;
+
+    /** the characters converted into different character length */
+    std::vector<Segment> charSegments_;
+};
+
+/**
+ * CharConverter applies a chain of character conversions in one pass.
+ * The conversion steps, such as from hiragana to katakana and from upper to lower case,
+ * are compiled into one flat table, which maps each character to its output after all the steps.
+ *
+ * Below is an example to convert into katakana and lower case:
+ * \code
+ * CharConverter converter;
+ * converter.addStep(kanaTable.getMapToRight());
+ * converter.addStep(caseTable.getMapToLeft());
+ * converter.build(ctype);
+ * converter.convert(str, result);
+ * \endcode
+ */
+class CharConverter
+{
+public:
+    /**
+     * Constructor, no conversion is applied until steps are added and built.
+     */
+    CharConverter();
+
+    /**
+     * Remove all the conversion steps.
+     */
+    void clear();
+
+    /**
+     * Append a conversion step to the chain, which is applied on the output of the previous steps.
+     * \param charMap the mapping from each character to its output
+     */
+    void addStep(const CharTable::CharMap& charMap);
+
+    /**
+     * Compile the conversion steps into table, which should be called before \e convert().
+     * \param ctype the character encoding, which should be kept while converting
+     */
+    void build(const JMA_CType* ctype);
+
+    /**
+     * Check whether any character would be converted.
+     * \return true for no conversion, false for having conversion
+     */
+    bool empty() const;
+
+    /**
+     * Convert the characters.
+     * \param str the string to convert
+     * \param result the string to append the result
+     * \param offsetMap if not 0, it is cleared and the offsets in the appended result are mapped back to \e str
+     */
+    void convert(const char* str, std::string& result, OffsetMap* offsetMap = 0) const;
+
+    /**
+     * Convert the characters as \e convert(), while the string need not be null-terminated.
+     * \param str the string to convert
+     * \param length the byte length of string
+     * \param result the string to append the result
+     * \param offsetMap if not 0, it is cleared and the offsets in the appended result are mapped back to \e str
+     */
+    void convert(const char* str, unsigned int length, std::string& result, OffsetMap* offsetMap = 0) const;
+
+private:
+    /**
+     * Entry is the output of a character.
+     */
+    struct Entry
+    {
+        /** the character bytes packed in integer, 0 for empty entry */
+        unsigned int key_;
+
+        /** the output offset in \e outputs_ */
+        unsigned int offset_;
+
+        /** the output byte length */
+        unsigned int length_;
+
+        /** the output character length */
+        unsigned int charLength_;
+    };
+
+    /**
+     * Pack the character bytes into integer.
+     * \param p the character start
+     * \param length the character byte length, which is not more than 4
+     * \return the packed key
+     */
+    static unsigned int packKey(const char* p, unsigned int length);
+
+    /**
+     * Remove the compiled table, so that no character is converted.
+     */
+    void resetTable();
+
+    /**
+     * Find the entry of a multi-byte character.
+     * \param key the packed key
+     * \return the entry pointer, 0 if the character is not converted
+     */
+    const Entry* findEntry(unsigned int key) const;
+
+private:
+    /** the mapping after the steps added */
+    CharTable::CharMap chain_;
+
+    /** the character encoding */
+    const JMA_CType* ctype_;
+
+    /** the concatenated output strings */
+    std::string outputs_;
+
+    /** the hash table of multi-byte characters in open addressing, whose size is power of 2 */
+    std::vector<Entry> table_;
+
+    /** the output of each ASCII character, whose \e key_ is 0 if not converted */
+    Entry asciiEntries_[128];
+
+    /** the ASCII output byte, when each ASCII character is converted into one ASCII byte */
+    char asciiBytes_[128];
+
+    /** whether each ASCII character is converted into one ASCII byte */
+    bool isAsciiByteMap_;
+
+    /** whether no ASCII character is converted */
+    bool isAsciiIdentity_;
+};
+
+} // namespace jma
+
+#endif // JMA_CHAR_CONVERTER_H
@@ -28,6 +28,9 @@ namespace jma
 class CharTable
 {
 public:
+    /** type of mapping between characters */
+    typedef std::map<std::string, std::string> CharMap;
+
     /**
      * Constructor.
      */
@@ -57,10 +60,19 @@ public:
      */
     const char* toLeft(const char* str) const;
 
-private:
-    /** type of mapping between characters */
-    typedef std::map<std::string, std::string> CharMap;
+    /**
+     * Get the mapping from left to right type.
+     * \return the mapping table
+     */
+    const CharMap& getMapToRight() const;
+
+    /**
+     * Get the mapping from right to left type.
+     * \return the mapping table
+     */
+    const CharMap& getMapToLeft() const;
 
+private:
     /** map from left to right type */
     CharMap mapToRight_;
 
@@ -11,9 +11,22 @@
 
 #include "ijma/analyzer.h"
 #include "ijma/sentence.h"
+#include "ijma/morpheme_graph.h"
+#include "ijma/morpheme_hierarchy.h"
+#include "ijma/morpheme_view.h"
+#include "ijma/morpheme_columns.h"
+#include "ijma/morpheme_sink.h"
+#include "ijma/token_stream.h"
+#include "ijma/term_frequency.h"
+#include "ijma/query_result.h"
 #include "jma_knowledge.h"
 #include "pos_table.h"
+#include "char_converter.h"
+#include "nbest_cursor.h"
 #include "mecab.h" // MeCab::Node, Tagger
+#include "freelist.h" // MeCab::ChunkFreeList
+
+#include <iosfwd>
 
 namespace jma
 {
@@ -44,6 +57,13 @@ public:
      */
     virtual int setKnowledge(Knowledge* pKnowledge);
 
+    /**
+     * Set the option value for analysis, and update the analysis plan from the option values.
+     * \param nOption the option type
+     * \param nValue the option value
+     */
+    virtual void setOption(OptionType nOption, double nValue);
+
     /**
      * Execute the morphological analysis based on a sentence.
      * \param sentence the instance containing the raw sentence string and also to save the analysis result
@@ -54,6 +74,14 @@ public:
      */
     virtual int runWithSentence(Sentence& sentence);
 
+    /**
+     * Execute the morphological analysis on each sentence as \e runWithSentence(), using multiple threads.
+     * \param sentences the sentences to analyze
+     * \param threadNum the number of threads, including the calling thread
+     * \return 0 for fail on any sentence, 1 for success
+     */
+    virtual int runBatch(std::vector<Sentence>& sentences, int threadNum);
+
     /**
      * Execute the morphological analysis based on a paragraph string.
      * \param inStr paragraph string
@@ -70,6 +98,13 @@ public:
      */
     virtual int runWithStream(const char* inFileName, const char* outFileName);
 
+    /**
+     * Get the byte length of the result of the last \e runWithString() call.
+     * It is needed when the option \e OPTION_TYPE_OUTPUT_TOKEN_STREAM is non-zero, as the result might contain zero bytes.
+     * \return the byte length
+     */
+    unsigned int getOutputLength() const;
+
     /**
      * Split a paragraph string into sentences.
      * \param paragraph paragraph string
@@ -78,6 +113,14 @@ public:
      */
     virtual void splitSentence(const char* paragraph, std::vector<Sentence>& sentences);
 
+    /**
+     * Split a paragraph string into sentences as \e splitSentence(), while the sentences are given as spans instead of copied.
+     * \param paragraph paragraph string
+     * \param spans the list to append the sentence spans
+     * \attention the original elements in \e spans would not be removed.
+     */
+    void splitSentence(const char* paragraph, SentenceSpanList& spans) const;
+
     /**
      * The characters, configured by OPTION_TYPE_CONVERT_TO_*, are converted to their target types, other characters are kept as original.
      * \param str string to convert from
@@ -91,6 +134,14 @@ public:
      */
     bool isOutputPOS() const;
 
+    /**
+     * Analyze a string in one-best, by either Viterbi search or greedy longest match configured in \e plan_.
+     * \param str the string to analyze, which need not be null-terminated
+     * \param length the byte length of string
+     * \return the node as the begin of sentence, whose \e next links the nodes in the best path
+     */
+    const MeCab::Node* parseOneBest(const char* str, unsigned int length) const;
+
     /**
      * Execute the one-best morphological analysis based on a sentence.
      * \param sentence the instance containing the raw sentence string and also to save the analysis result
@@ -111,20 +162,253 @@ public:
      */
     bool runNBest(Sentence& sentence, int nbest) const;
 
+    /**
+     * Start the n-best morphological analysis based on a sentence, the candidates are analyzed on demand by \e NBestCursor::next().
+     * \param sentence the raw sentence string
+     * \return the cursor to iterate the n-best candidates
+     * \attention white-space characters are ignored in the analysis, which include " \t\n\v\f\r", and also space character in specific encoding.
+     * \attention if the sentence is too long to be parsed at once, only the one-best candidate is given.
+     * \attention the cursor becomes invalid once another analysis is executed by this analyzer.
+     */
+    NBestCursor beginNBest(const char* sentence);
+
+    /**
+     * Execute the morphological analysis based on a sentence, and get the segmentation candidates within a cost margin as a graph.
+     * \param sentence the raw sentence string
+     * \param graph the graph to save the analysis result
+     * \param costMargin the maximum cost gap between a candidate and the best candidate, zero to get the best candidate only
+     * \return true for success, false for fail
+     * \post on successful return, each candidate within \e costMargin is a path from \e MorphemeGraph::BOS_INDEX to \e MorphemeGraph::EOS_INDEX in \e graph,
+     * and the best candidate is the path along the edges with \e MorphemeGraph::Edge::isBest_.
+     * \attention \e graph is a superset of the candidates within \e costMargin, but not each path in it is within the margin,
+     * as a node or edge is kept if any candidate through it is within the margin,
+     * and the nodes of the same offset, length and POS are merged, so that a path might join the parts of different candidates.
+     * \attention if the sentence is too long to be parsed at once, the margin is applied to each part parsed separately,
+     * so that the cost gaps of the parts are added up in a path.
+     * \attention the graph nodes are the morphemes in dictionary, which are not combined into compound words, decomposed or filtered.
+     * \attention white-space characters are ignored in the analysis, which include " \t\n\v\f\r", and also space character in specific encoding.
+     */
+    bool runGraph(const char* sentence, MorphemeGraph& graph, long costMargin) const;
+
+    /**
+     * Execute the one-best morphological analysis based on a sentence, and get the result as morpheme views.
+     * Compared with \e runOneBest(), the strings in result are referred instead of copied,
+     * and the memory used by analyzer is reused in each call.
+     * \param sentence the raw sentence string
+     * \return the one-best result
+     * \attention the result and its strings are valid only until the next analysis by this analyzer,
+     * and \e sentence should also be kept during that time.
+     * \attention white-space characters are ignored in the analysis, which include " \t\n\v\f\r", and also space character in specific encoding.
+     */
+    const MorphemeViewList& runWithView(const char* sentence);
+
+    /**
+     * Execute the one-best morphological analysis based on a sentence, and get the result in columns.
+     * The result is the same as \e runOneBest(), while each field is saved in a contiguous array,
+     * and \e MorphemeColumns::appendTo() could be used to convert it to \e Sentence.
+     * \param sentence the raw sentence string
+     * \param columns the columns to save the result, its original content is cleared
+     * \attention white-space characters are ignored in the analysis, which include " \t\n\v\f\r", and also space character in specific encoding.
+     */
+    void runWithColumns(const char* sentence, MorphemeColumns& columns);
+
+    /**
+     * Execute the one-best morphological analysis based on a sentence, and get the result in both coarse and fine granularities.
+     * Both levels are got from one analysis, in which the coarse-grained morphemes are the same as \e runWithView()
+     * with \e OPTION_TYPE_COMPOUND_MORPHOLOGY non-zero and \e OPTION_TYPE_DECOMPOSE_USER_NOUN zero,
+     * and the fine-grained morphemes are the same as \e runWithView()
+     * with \e OPTION_TYPE_COMPOUND_MORPHOLOGY zero and \e OPTION_TYPE_DECOMPOSE_USER_NOUN non-zero,
+     * the other options take effect as \e runWithView().
+     * \param sentence the raw sentence string
+     * \param hierarchy the hierarchy to save the result, its original content is cleared
+     * \attention the strings in result are valid only until the next analysis by this analyzer,
+     * and \e sentence should also be kept during that time.
+     * \attention white-space characters are ignored in the analysis, which include " \t\n\v\f\r", and also space character in specific encoding.
+     */
+    void runWithHierarchy(const char* sentence, MorphemeHierarchy& hierarchy);
+
+    /**
+     * Execute the one-best morphological analysis based on a paragraph string, and give the result to a sink.
+     * The paragraph is split into sentences as \e splitSentence(),
+     * and for each sentence, the sink methods are called in the order of
+     * \e MorphemeSink::beginSentence(), \e MorphemeSink::processMorpheme() for each morpheme, and \e MorphemeSink::endSentence().
+     * \param text the paragraph string
+     * \param sink the sink to receive the result
+     * \attention white-space characters are ignored in the analysis, which include " \t\n\v\f\r", and also space character in specific encoding.
+     */
+    void analyze(const char* text, MorphemeSink& sink);
+
+    /**
+     * Execute the one-best morphological analysis based on a paragraph string, and count the terms in it.
+     * The paragraph is split into sentences as \e analyze(), and the morphemes are filtered in the same way,
+     * such as by \e setKeywordPOS() and the stop words, while no morpheme is output but only added into the table.
+     * \param text the paragraph string
+     * \param table the table to count the terms, its original content is cleared, and its key type decides how the terms are identified
+     * \attention white-space characters are ignored in the analysis, which include " \t\n\v\f\r", and also space character in specific encoding.
+     */
+    void runWithTermFrequency(const char* text, TermFrequency& table);
+
+    /**
+     * Segment a paragraph string into words only, which are the same words as the result of \e analyze(),
+     * while no field is extracted, and the one-best path is decoded without the lattice paths for n-best.
+     * \param text the paragraph string
+     * \param offsets the flat buffer to save the result, its original content is cleared,
+     * and the i-th word is in byte range [offsets[2*i], offsets[2*i+1]) of \e text
+     * \attention white-space characters are ignored in the analysis, which include " \t\n\v\f\r", and also space character in specific encoding.
+     */
+    void runWithSegment(const char* text, std::vector<unsigned int>& offsets);
+
+    /**
+     * Segment a paragraph string into words only as above, and get the word surfaces in \e text.
+     * \param text the paragraph string
+     * \param surfaces the flat buffer to append the result, in which each word is followed by \e getWordDelimiter()
+     */
+    void runWithSegment(const char* text, std::string& surfaces);
+
+    /**
+     * Preallocate the workspaces for the queries no longer than \e maxLength bytes,
+     * so that \e runWithQuery() on such a query allocates no heap memory in common cases.
+     * It could be called either before or after \e setKnowledge().
+     * \param maxLength the maximum byte length of query, 0 for no preallocation
+     */
+    void setQueryProfile(unsigned int maxLength);
+
+    /**
+     * Execute the one-best morphological analysis based on a short query, such as a search query in 1 to 20 characters.
+     * The result is the same as \e runWithView(), while the query is analyzed as one sentence without splitting,
+     * the one-best path is decoded without the lattice paths for n-best,
+     * and the views are saved into the inline storage of \e result.
+     * \param query the query string
+     * \param result the result to save the morpheme views, its original content is cleared
+     * \attention the strings in the views are valid until the next call of analysis, and the query string should also be kept during that time.
+     * \attention white-space characters are ignored in the analysis, which include " \t\n\v\f\r", and also space character in specific encoding.
+     */
+    void runWithQuery(const char* query, QueryResult& result);
+
+    /**
+     * Execute the one-best morphological analysis based on a sentence, and give each morpheme to \e MorphemeSink::processMorpheme().
+     * Compared with \e analyze(), the sentence is not split, and the other sink methods are not called.
+     * \param sentence the raw sentence string
+     * \param sink the sink to receive the result
+     * \attention white-space characters are ignored in the analysis, which include " \t\n\v\f\r", and also space character in specific encoding.
+     */
+    void analyzeSentence(const char* sentence, MorphemeSink& sink);
+
+    /**
+     * Get the maximum agenda size of the last n-best search, which shows the memory cost of the search.
+     * \return the maximum agenda size
+     */
+    size_t getNBestAgendaSize() const;
+
 private:
     /**
-     * Get feature string from list.
-     * \param featureList the feature list, like "動詞,自立,*,*,一段,未然形,見る,ミ,ミ"
-     * \param featureOffset the feature offset indexed from zero, each feature is delimited by comma ","
-     * \param retVal to store the feature string
+     * TextPosition is the start position of a string in the analyzed sentence string.
+     */
+    struct TextPosition
+    {
+        /** the byte offset */
+        unsigned int byteOffset_;
+
+        /** the character offset */
+        unsigned int charOffset_;
+
+        /**
+         * Constructor, the position is initialized as the start of sentence.
+         */
+        TextPosition() : byteOffset_(0), charOffset_(0) {}
+    };
+
+    /**
+     * MorphemePlan saves the settings in analysis, which are compiled from option values,
+     * so that the options are not checked for each morpheme.
      */
-    void getFeatureStr(const char* featureList, int featureOffset, std::string& retVal) const;
+    struct MorphemePlan
+    {
+        /** the fields to extract, the combination of \e Analyzer::MorphemeField values */
+        int fields_;
+
+        /** the POS output format */
+        POSTable::POSFormat posFormat_;
+
+        /** whether combine into compound words */
+        bool isCombine_;
+
+        /** whether decompose user noun */
+        bool isDecompose_;
+
+        /** whether normalize the input in analysis */
+        bool isNormalize_;
+
+        /** whether analyze in one-best by greedy longest match instead of Viterbi search */
+        bool isLongestMatch_;
+
+        /** the offset of base form in feature string */
+        int baseFormOffset_;
+
+        /** the offset of reading form in feature string */
+        int readFormOffset_;
+
+        /** the offset of normalized form in feature string */
+        int normFormOffset_;
+    };
+
+    friend class NBestCursor;
+
+    /**
+     * Analyze the next unique candidate of an n-best cursor, which is called by \e NBestCursor::next().
+     * \param cursor the cursor to append the candidate
+     * \return true for success, false if no more candidate exists
+     */
+    bool nextNBest(NBestCursor& cursor) const;
+
+    /**
+     * Append the nodes and paths in MeCab lattice to graph, which are on any path within a cost margin.
+     * \param bosNode the node as the begin of sentence, the lattice should contain all the paths
+     * \param costMargin the maximum cost gap between a path and the best path
+     * \param position the position of the lattice string in the sentence
+     * \param graph the graph to append, the edges from begin of sentence and to end of sentence are appended with \e MorphemeGraph::BOS_INDEX and \e MorphemeGraph::EOS_INDEX
+     */
+    void appendLattice(const MeCab::Node* bosNode, long costMargin, const TextPosition& position, MorphemeGraph& graph) const;
 
     /**
      * Release the resources owned by \e JMA_Analyzer itself.
      */
     void clear();
 
+    /**
+     * Preallocate the workspaces for the queries no longer than \e queryLength_ bytes.
+     */
+    void reserveQuery();
+
+    /**
+     * Analyze the lines in stream by multiple worker threads, which is used by \e runWithStream().
+     * \param in the input stream
+     * \param out the output stream
+     * \param workerNum the number of worker threads
+     * \return 0 for fail, 1 for success
+     */
+    int runStreamPipeline(std::istream& in, std::ostream& out, unsigned int workerNum);
+
+    /**
+     * Prepare the analyzers in \e workers_ with the same options and knowledge as this one, which are used by multiple threads.
+     * The analyzers are created only when less than \e workerNum are kept, as creating a tagger costs much more than analyzing a sentence,
+     * and the options and delimiters are copied to them in each call, in case they are changed since last call.
+     * \param workerNum the number of analyzers needed
+     * \return 0 for fail, 1 for success
+     */
+    int prepareWorkers(unsigned int workerNum);
+
+    /**
+     * Update \e plan_ from the option values and the knowledge.
+     */
+    void compilePlan();
+
+    /**
+     * Compile the enabled character conversions into \e converter_,
+     * which is skipped if the conversion options are not changed since last compilation.
+     */
+    void compileConverter();
+
     /**
      * Check whether output POS in the format of alphabet.
      * \return true for alphabet format such like "NP-S", false for Japanese format such like "名詞,固有名詞,人名,姓"
@@ -143,12 +427,28 @@ private:
      */
     bool isDecomposeUserNound() const;
 
+    /**
+     * Initialize the n-best search on a string, which is configured by \e OPTION_TYPE_NBEST_COST_GAP.
+     * \param str the string to analyze
+     * \return true for success, false for fail
+     */
+    bool initNBest(const char* str) const;
+
     /**
      * Get POS output format, such as "名詞,一般", "NC-G", "名詞,一般,*,*", which format type is configured by \e Analyzer::setOption().
      * \return POS output format
      */
     POSTable::POSFormat getPOSFormat() const;
 
+    /**
+     * Get feature string from list without copy.
+     * \param featureList the feature list, like "動詞,自立,*,*,一段,未然形,見る,ミ,ミ"
+     * \param featureOffset the feature offset indexed from zero, each feature is delimited by comma ","
+     * \param begin to store the start of feature string
+     * \param length to store the byte length of feature string
+     */
+    void getFeatureView(const char* featureList, int featureOffset, const char*& begin, unsigned int& length) const;
+
     /**
      * Convert from \e MeCab::Node to \e Morpheme.
      * \param node mecab node to convert from
@@ -157,19 +457,126 @@ private:
     Morpheme getMorpheme(const MeCab::Node* node) const;
 
     /**
-     * Combine MeCab nodes to morpheme using combination rules based on POS.
-     * \param[in] startNode the nodes starting from \e startNode are checked whether to combine by \e POSTable::combinePOS()
-     * \param[out] result the morpheme as combination result
+     * Convert from \e MeCab::Node to \e MorphemeView.
+     * \param node mecab node to convert from
+     * \param fields the fields to extract, the combination of \e Analyzer::MorphemeField values, the other fields are left empty
+     * \param view morpheme view result
+     */
+    void getMorphemeView(const MeCab::Node* node, int fields, MorphemeView& view) const;
+
+    /**
+     * Append a string to a string view.
+     * If the two strings are contiguous, the view is extended,
+     * otherwise, the combined string is copied into \e arena_.
+     * \param str the start of string view
+     * \param length the byte length of string view
+     * \param appendStr the start of string to append
+     * \param appendLength the byte length of string to append
+     */
+    void appendView(const char*& str, unsigned int& length, const char* appendStr, unsigned int appendLength) const;
+
+    /**
+     * Combine MeCab nodes to morpheme view using combination rules based on POS.
+     * \param[in] startNode the nodes starting from \e startNode are combined by the rules from \e POSTable::getCombineRule()
+     * \param[in] ruleNode the rule matched from \e startNode, 0 for no rule is matched
+     * \param[in] fields the fields to extract as \e getMorphemeView()
+     * \param[out] result the morpheme view as combination result
      * \return the including end node in the combination range
      */
-    MeCab::Node* combineNode(MeCab::Node* startNode, Morpheme& result) const;
+    MeCab::Node* combineNode(MeCab::Node* startNode, const RuleNode* ruleNode, int fields, MorphemeView& result) const;
+
+    /**
+     * Decompose the morpheme view of a user noun, and give each decomposed morpheme not filtered to processor.
+     * \param view the morpheme view of user noun
+     * \param begin the start of user noun in the analyzed string
+     * \param compound the compound index in \e JMA_Knowledge::DecompTable, which is positive
+     * \param fields the fields to extract as \e getMorphemeView()
+     * \param processor the morpheme view processor, its method \e process(const MorphemeView& view) would be called for each decomposed morpheme
+     */
+    template<class ViewProcessor> void decomposeView(const MorphemeView& view, const char* begin, unsigned int compound, int fields, ViewProcessor& processor) const;
+
+    /**
+     * Iterate the MeCab nodes combined into a compound word as fine-grained morphemes, in which the user nouns are decomposed.
+     * \param first the first node of compound word
+     * \param last the last node of compound word
+     * \param compoundView the morpheme view of compound word, to get the offsets of its nodes
+     * \param fields the fields to extract as \e getMorphemeView()
+     * \param processor the morpheme view processor, its method \e process(const MorphemeView& view) would be called for each morpheme not filtered
+     */
+    template<class ViewProcessor> void iterateFineView(const MeCab::Node* first, const MeCab::Node* last, const MorphemeView& compoundView, int fields, ViewProcessor& processor) const;
 
     /**
      * Iterate MeCab nodes from the node next to \e bosNode, and until the node before and excluding the last node.
      * \param bosNode the node as the begin of sentence
+     * \param position the position of the analyzed string in the sentence, to get the offsets of morphemes
      * \param processor the morpheme processor, in iteration, its method \e process(const Morpheme& morp) would be called for each morpheme node
      */
-    template<class MorphemeProcessor> void iterateNode(const MeCab::Node* bosNode, MorphemeProcessor& processor) const;
+    template<class MorphemeProcessor> void iterateNode(const MeCab::Node* bosNode, const TextPosition& position, MorphemeProcessor& processor) const;
+
+    /**
+     * Iterate MeCab nodes as \e iterateNode(), while the morphemes are given as views.
+     * \param bosNode the node as the begin of sentence
+     * \param position the position of the analyzed string in the sentence, to get the offsets of morphemes
+     * \param fields the fields to extract as \e getMorphemeView()
+     * \param processor the morpheme view processor, in iteration, its method \e process(const MorphemeView& view) would be called for each morpheme node
+     * \attention the strings in the views are valid until \e arena_ is freed.
+     * \attention if the processor builds \e MorphemeHierarchy, both coarse and fine granularities are given to it regardless of the options.
+     */
+    template<class ViewProcessor> void iterateNodeView(const MeCab::Node* bosNode, const TextPosition& position, int fields, ViewProcessor& processor) const;
+
+    /**
+     * Split the sentence into strings with limit size, analyze each string in one-best, and iterate the morpheme views as \e iterateNodeView().
+     * If \e OPTION_TYPE_NORMALIZE_INPUT is enabled, the sentence is normalized before analysis,
+     * and the offsets in the views are mapped back to the raw sentence.
+     * \param sentence the raw sentence string, which need not be null-terminated
+     * \param length the byte length of sentence
+     * \param start the position of sentence start, which is added to the offsets in the views
+     * \param fields the fields to extract as \e getMorphemeView(), usually \e MorphemePlan::fields_ in \e plan_
+     * \param processor the morpheme view processor, in iteration, its method \e process(const MorphemeView& view) would be called for each morpheme node
+     * \attention the strings in the views are valid until the next call.
+     */
+    template<class ViewProcessor> void iterateLimitView(const char* sentence, unsigned int length, const TextPosition& start, int fields, ViewProcessor& processor);
+
+    /**
+     * Split the sentence into strings with limit size, analyze each string in one-best, and iterate the morpheme views as \e iterateNodeView().
+     * \param sentence the sentence string to analyze, which need not be null-terminated
+     * \param length the byte length of sentence
+     * \param start the position of sentence start, which is added to the offsets in the views
+     * \param fields the fields to extract as \e getMorphemeView()
+     * \param processor the morpheme view processor
+     */
+    template<class ViewProcessor> void parseLimitView(const char* sentence, unsigned int length, const TextPosition& start, int fields, ViewProcessor& processor);
+
+    /**
+     * Analyze a paragraph string as \e analyze(), with the fields to extract instead of the option value.
+     * \param text the paragraph string
+     * \param fields the fields to extract as \e getMorphemeView()
+     * \param sink the sink to receive the sentences and morphemes
+     */
+    void analyzeWithFields(const char* text, int fields, MorphemeSink& sink);
+
+    /**
+     * Decode the characters of a text in one pass, and split it into sentences in \e sentSpans_.
+     * Until \e clearScan() is called, the character lengths are reused in splitting limit size and counting offsets,
+     * and the character types are reused in MeCab lookup, when the strings analyzed are within the text.
+     * \param text the text string
+     * \param length the byte length of text
+     */
+    void scanText(const char* text, unsigned int length);
+
+    /**
+     * Release the characters decoded in \e scanText().
+     */
+    void clearScan();
+
+    /**
+     * Get the character lengths decoded in \e scanText() for a string.
+     * \param str the string start
+     * \param length the byte length of string
+     * \return the byte length of the character starting at each byte of \e str,
+     * 0 if the string is not within the scanned text or not starting at a character
+     */
+    const unsigned char* getScanLengths(const char* str, unsigned int length) const;
 
     /**
      * Iterate sentences in a paragraph string.
@@ -179,12 +586,27 @@ private:
     template<class SentenceProcessor> void iterateSentence(const char* paragraph, SentenceProcessor& processor);
 
     /**
-     * Check whether to filter out the morpheme.
-     * \param morph the morpheme
+     * Check whether to filter out the morpheme view.
+     * \param view the morpheme view
      * \return true to filter out, false to reserve
      * \note white-space morphemes are also filtered out.
      */
-    bool isFilter(const Morpheme& morph) const;
+    bool isFilter(const MorphemeView& view) const;
+
+    /**
+     * Check whether to filter out the morpheme, which is used before the morpheme fields are extracted.
+     * \param posCode the index code of part-of-speech tag
+     * \param termId the term id, -1 for not in dictionary
+     * \param lexicon the lexicon string
+     * \param length the byte length of lexicon
+     * \return true to filter out, false to reserve
+     */
+    bool isFilter(int posCode, int termId, const char* lexicon, unsigned int length) const;
+
+    /**
+     * Compile the stop words in knowledge into \e stopTermFlags_.
+     */
+    void compileStopTerms() const;
 
     /**
      * Split string into each string with limit size.
@@ -194,6 +616,23 @@ private:
      */
     void splitLimitSize(const char* str, std::vector<std::string>& limitStrVec, unsigned int limitSize) const;
 
+    /**
+     * Split string into each string with limit size, and get the end offsets instead of the splitted strings.
+     * \param str the string to split, which need not be null-terminated
+     * \param length the byte length of string
+     * \param limitEnds the end offset of each splitted string
+     * \param limitSize the limit size, each splitted string size should be less than this size
+     */
+    void splitLimitOffset(const char* str, unsigned int length, std::vector<unsigned int>& limitEnds, unsigned int limitSize) const;
+
+    /**
+     * Move the position to the end of a string.
+     * \param position the position of the string start, which is moved to the string end on return
+     * \param str the string
+     * \param length the byte length of the string
+     */
+    void advancePosition(TextPosition& position, const char* str, unsigned int length) const;
+
     /**
      * Validate the correctness of string splitting result with limit size.
      * It combines the splitted string, and compares it with the original string,
@@ -221,6 +660,9 @@ private:
     /** the string buffer used in \e runWithString() */
     std::string strBuf_;
 
+    /** the sentence string analyzed by the cursor from \e beginNBest() */
+    std::string nbestStr_;
+
     /** POS table for POS string and index code */
     const POSTable* posTable_;
 
@@ -233,8 +675,68 @@ private:
     /** mapping table between lower and upper case characters */
     const CharTable* caseTable_;
 
-    /** decomposition map to decompose user defined noun */
-    const JMA_Knowledge::DecompMap* decompMap_;
+    /** the enabled conversions in \e convertCharacters() compiled into one table */
+    CharConverter converter_;
+
+    /** the conversion options compiled in \e converter_, -1 for not compiled */
+    int convertSteps_;
+
+    /** the flag of each term id whether its surface is a stop word, compiled from the stop words in knowledge */
+    mutable std::vector<bool> stopTermFlags_;
+
+    /** the revision of stop words compiled in \e stopTermFlags_ */
+    mutable unsigned int stopTermRevision_;
+
+    /** the normalized sentence in \e iterateLimitView() */
+    std::string normStr_;
+
+    /** the offsets in \e normStr_ mapped to the raw sentence */
+    OffsetMap offsetMap_;
+
+    /** decomposition table to decompose user defined noun */
+    const JMA_Knowledge::DecompTable* decompTable_;
+
+    /** the result of \e runWithView() */
+    MorphemeViewList viewList_;
+
+    /** the end offsets of each string with limit size in \e iterateLimitView() */
+    std::vector<unsigned int> limitEnds_;
+
+    /** the text decoded in \e scanText(), 0 for none */
+    const char* scanBegin_;
+
+    /** the end of text decoded in \e scanText() */
+    const char* scanEnd_;
+
+    /** the byte length of the character starting at each byte of text decoded in \e scanText() */
+    const unsigned char* scanLengths_;
+
+    /** the sentences of text split in \e scanText() */
+    SentenceSpanList sentSpans_;
+
+    /** the sentence copy given to sink in \e analyze() */
+    std::string sentenceStr_;
+
+    /** the word offsets in \e runWithSegment() */
+    std::vector<unsigned int> segmentOffsets_;
+
+    /** the maximum byte length of query to preallocate the workspaces, set by \e setQueryProfile() */
+    unsigned int queryLength_;
+
+    /** the analyzers kept for the worker threads in \e runBatch() and \e runWithStream(), which are released in \e clear() */
+    std::vector<JMA_Analyzer*> workers_;
+
+    /** the memory for the strings in morpheme views, which are not contiguous in input or dictionary */
+    mutable MeCab::ChunkFreeList<char> arena_;
+
+    /** the buffer to look up the string maps in knowledge */
+    mutable std::string keyBuf_;
+
+    /** the analysis plan compiled from option values */
+    MorphemePlan plan_;
+
+    /** the writer of token stream in \e runWithString() */
+    TokenStreamWriter tokenWriter_;
 };
 
 } // namespace jma
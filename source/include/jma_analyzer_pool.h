@@ -0,0 +1,172 @@
+/** \file jma_analyzer_pool.h
+ * Definition of class JMA_AnalyzerPool.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_ANALYZER_POOL_IMPL_H
+#define JMA_ANALYZER_POOL_IMPL_H
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // HAVE_PTHREAD_H
+#endif
+
+#include "ijma/analyzer_pool.h"
+
+#include <vector>
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+
+/** whether the analyzer pool is supported */
+#define JMA_USE_ANALYZER_POOL 1
+#endif
+
+#ifdef JMA_USE_ANALYZER_POOL
+
+namespace jma
+{
+
+class JMA_Analyzer;
+class JMA_Knowledge;
+
+/**
+ * JMA_AnalyzerPool shares the instances of \e JMA_Analyzer among threads.
+ * All the members are protected by one mutex, while the analyzers are created and destroyed out of it.
+ */
+class JMA_AnalyzerPool : public AnalyzerPool
+{
+public:
+    /**
+     * Constructor.
+     * \param knowledge the knowledge of analyzers, which should be kept while the pool is used
+     * \param maxSize the maximum number of analyzers
+     */
+    JMA_AnalyzerPool(Knowledge* knowledge, unsigned int maxSize);
+
+    /**
+     * Destructor.
+     */
+    ~JMA_AnalyzerPool();
+
+    virtual void setOption(Analyzer::OptionType nOption, double nValue);
+    virtual double getOption(Analyzer::OptionType nOption) const;
+    virtual void setPOSDelimiter(const char* delimiter);
+    virtual void setWordDelimiter(const char* delimiter);
+    virtual void setIdleTimeout(double seconds);
+    virtual Analyzer* checkout();
+    virtual void checkin(Analyzer* analyzer);
+    virtual unsigned int shrink();
+    virtual void getStatistics(Statistics& stat) const;
+
+private:
+    /**
+     * Slot is an analyzer in pool.
+     */
+    struct Slot
+    {
+        /** the analyzer */
+        JMA_Analyzer* analyzer_;
+
+        /** the unique id in pool, which is saved as the thread affinity */
+        unsigned long id_;
+
+        /** the revision of options applied in analyzer, 0 for not applied */
+        unsigned long revision_;
+
+        /** the time when it is returned */
+        double idleSince_;
+    };
+
+    /**
+     * Apply the options in pool to the analyzer.
+     * \param analyzer the analyzer
+     */
+    void applyOptions(JMA_Analyzer& analyzer) const;
+
+    /**
+     * Check whether the options of analyzer are the same as pool.
+     * \param analyzer the analyzer
+     * \return true for the same, false for different
+     */
+    bool isSameOptions(const JMA_Analyzer& analyzer) const;
+
+    /**
+     * Create an analyzer, which is called without lock.
+     * \return the slot, 0 for fail
+     */
+    Slot* createSlot();
+
+    /**
+     * Remove the slots idle for more than the timeout, which is called with lock.
+     * \param now the current time
+     * \param expired the removed slots to destroy without lock
+     */
+    void removeExpired(double now, std::vector<Slot*>& expired);
+
+    /**
+     * Destroy the slots, which is called without lock.
+     * \param slots the slots
+     */
+    static void destroySlots(const std::vector<Slot*>& slots);
+
+    /**
+     * Get the current time.
+     * \return the time in seconds
+     */
+    static double getTime();
+
+private:
+    /** the knowledge of analyzers */
+    JMA_Knowledge* knowledge_;
+
+    /** the option values */
+    std::vector<double> options_;
+
+    /** the delimiter between word and POS tag */
+    const char* posDelimiter_;
+
+    /** the delimiter between words */
+    const char* wordDelimiter_;
+
+    /** the revision of options, increased when they are changed */
+    unsigned long revision_;
+
+    /** the idle timeout in seconds */
+    double idleTimeout_;
+
+    /** all the analyzers created */
+    std::vector<Slot*> slots_;
+
+    /** the analyzers not checked out, in the order of their returned time */
+    std::vector<Slot*> idleSlots_;
+
+    /** the id of next slot */
+    unsigned long nextId_;
+
+    /** the statistics, whose \e size_ includes the analyzers in creation */
+    Statistics stat_;
+
+    /** the lock on the members */
+    mutable pthread_mutex_t mutex_;
+
+    /** signaled when an analyzer is returned or destroyed */
+    pthread_cond_t idleCond_;
+
+    /** the lock to create analyzers one at a time */
+    pthread_mutex_t createMutex_;
+
+    /** the thread specific key of the slot id used last time */
+    pthread_key_t affinityKey_;
+
+    // disable copy
+    JMA_AnalyzerPool(const JMA_AnalyzerPool&);
+    JMA_AnalyzerPool& operator=(const JMA_AnalyzerPool&);
+};
+
+} // namespace jma
+
+#endif // JMA_USE_ANALYZER_POOL
+
+#endif // JMA_ANALYZER_POOL_IMPL_H
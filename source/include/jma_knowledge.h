@@ -13,11 +13,13 @@
 #include "jma_ctype.h"
 #include "pos_table.h"
 #include "char_table.h"
+#include "sentence_splitter.h"
 #include "ijma/sentence.h"
 
 #include <string>
 #include <set>
 #include <map>
+#include <vector>
 #include <ostream>
 
 namespace MeCab
@@ -47,6 +49,21 @@ public:
      */
     typedef std::map<std::string, MorphemeList> DecompMap;
 
+    /**
+     * The table to decompose user defined noun, which is indexed by \e MeCab::Token::compound.
+     * The decomposed morphemes of all user nouns are saved in one flat list,
+     * those of compound index \e i are in range [morphemes_[offsets_[i-1]], morphemes_[offsets_[i]]),
+     * and compound index 0 is reserved for the noun not decomposed.
+     */
+    struct DecompTable
+    {
+        /** the decomposed morphemes of all user nouns */
+        MorphemeList morphemes_;
+
+        /** the end offset in \e morphemes_ of each compound index, starting with 0 */
+        std::vector<unsigned int> offsets_;
+    };
+
     /**
      * Constructor.
      */
@@ -131,6 +148,12 @@ public:
      */
     const DecompMap& getDecompMap() const;
 
+    /**
+     * Get the table to decompose user defined noun by its compound index.
+     * \return reference to the table instance.
+     */
+    const DecompTable& getDecompTable() const;
+
     /**
      * Whether the specific word is stop word.
      * \param word the word to be checked
@@ -144,6 +167,19 @@ public:
      */
     unsigned int stopWordCount() const;
 
+    /**
+     * Get the stop words loaded.
+     * \return reference to the stop words set.
+     */
+    const std::set<std::string>& getStopWords() const;
+
+    /**
+     * Get the revision of stop words, which is increased each time the stop words are loaded.
+     * It could be used to check whether the stop words are changed since last time.
+     * \return the revision number.
+     */
+    unsigned int getStopWordRevision() const;
+
     /**
      * Check whether is a seperator of sentence.
      * \param p pointer to the character string, it would check all the characters until null character
@@ -151,6 +187,12 @@ public:
      */
     bool isSentenceSeparator(const char* p) const;
 
+    /**
+     * Get the splitter compiled from sentence separators.
+     * \return reference to the splitter instance.
+     */
+    const SentenceSplitter& getSentenceSplitter() const;
+
     /**
      * Whether the specific part-of-speech tag is keyword
      *
@@ -260,12 +302,21 @@ private:
     /** the part-of-speech index codes as keywords */
     std::set<int> keywordPOSSet_;
 
+    /** the flag of each part-of-speech index code whether it is keyword, compiled from \e keywordPOSSet_ */
+    std::vector<bool> keywordPOSFlags_;
+
     /** stop words set */
     std::set<std::string> stopWords_;
 
+    /** the revision of \e stopWords_ */
+    unsigned int stopWordRevision_;
+
     /** sentence separators */
     std::set<std::string> sentSeps_;
 
+    /** the splitter compiled from \e sentSeps_ */
+    SentenceSplitter sentSplitter_;
+
     /** whether POS result is in the format of full category */
     bool isOutputFullPOS_;
 
@@ -304,6 +355,9 @@ private:
     /** the instance of decomposition map */
     DecompMap decompMap_;
 
+    /** the instance of decomposition table */
+    DecompTable decompTable_;
+
     /** the system dictionary instance */
     JMA_Dictionary* dictionary_;
 
@@ -0,0 +1,95 @@
+/** \file nbest_cursor.h
+ * Definition of class NBestCursor.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_NBEST_CURSOR_H
+#define JMA_NBEST_CURSOR_H
+
+#include "ijma/sentence.h" // MorphemeList
+
+#include <vector>
+
+namespace jma
+{
+
+class JMA_Analyzer;
+
+/**
+ * NBestCursor iterates the n-best candidates of a sentence one at a time.
+ * Each candidate is analyzed only when \e next() is called, so that the caller could stop as soon as enough candidates are got.
+ * The candidates are unique on segmentation (and POS if \e Analyzer::OPTION_TYPE_POS_TAGGING is set),
+ * which are in the same order as those given by \e JMA_Analyzer::runNBest().
+ *
+ * Below is an example to get the second candidate only when it is close enough to the first one:
+ * \code
+ * NBestCursor cursor = analyzer->beginNBest("...");
+ * if(cursor.next())
+ * {
+ *     long bestCost = cursor.getCost();
+ *     if(cursor.next() && cursor.getCost() - bestCost < MARGIN)
+ *         use(cursor.getMorphemeList());
+ * }
+ * \endcode
+ *
+ * \attention the cursor shares the lattice with the \e JMA_Analyzer creating it,
+ * so that it becomes invalid once another analysis is executed by that analyzer.
+ */
+class NBestCursor
+{
+public:
+    /**
+     * Constructor of an empty cursor, which has no candidate.
+     */
+    NBestCursor();
+
+    /**
+     * Move to the next candidate.
+     * \return true for success, false if no more candidate exists
+     */
+    bool next();
+
+    /**
+     * Get the current candidate.
+     * \return the morpheme list of the current candidate
+     * \pre \e next() has returned true.
+     */
+    const MorphemeList& getMorphemeList() const;
+
+    /**
+     * Get the path cost of the current candidate, the smaller cost is the better candidate.
+     * \return the path cost
+     * \pre \e next() has returned true.
+     */
+    long getCost() const;
+
+    /**
+     * Get the index of the current candidate.
+     * \return the index starting from zero, or -1 if \e next() has not been called yet
+     */
+    int getIndex() const;
+
+private:
+    friend class JMA_Analyzer;
+
+    /** the analyzer creating this cursor */
+    const JMA_Analyzer* analyzer_;
+
+    /** whether the input is too long to be analyzed in n-best, so that only the one-best candidate is given */
+    bool isOneBest_;
+
+    /** whether all the candidates have been iterated */
+    bool isEnd_;
+
+    /** the candidates already got, which are used to remove the duplicate ones */
+    std::vector<MorphemeList> candidates_;
+
+    /** the path cost of each candidate */
+    std::vector<long> costs_;
+};
+
+} // namespace jma
+
+#endif // JMA_NBEST_CURSOR_H
@@ -25,34 +25,25 @@ namespace jma
 {
 
 /**
- * RuleNode is a Trie node, the path from root to leaf means a rule to combine POS.
+ * RuleNode is a state in the automaton of combination rules, the path from start state to this state means a rule to combine POS.
  * For example, the rule below:
  * src1 src2 ... srcN => target,
  * would combine src1, src2, ..., srcN (N >= 1) into target.
  *
  * The corresponding path would be:
- * root src1Node src2Node ... srcNNode,
- * the target value is saved in srcNNode.
+ * start src1State src2State ... srcNState,
+ * the target value is saved in srcNState.
  */
 struct RuleNode
 {
-    int level_; ///< the node level in Trie, root node is 0, its child is 1, etc
-    int target_; ///< POS index code of target, -1 for no rule is defined with this ending node
-    std::vector<RuleNode*> children_; ///< the pointers to each child, the index is POS index code, pointer 0 for the child does not exist
+    int level_; ///< the number of POS from start state to this state, start state is 0
+    int target_; ///< POS index code of target, -1 for no rule is defined with this ending state
 
     /**
      * Constructor.
      */
-    RuleNode(int level, int childSize)
-        : level_(level), target_(-1), children_(childSize) {}
-
-    /**
-     * Destructor.
-     */
-    ~RuleNode() {
-        for(std::vector<RuleNode*>::iterator it=children_.begin(); it!=children_.end(); ++it)
-            delete *it;
-    }
+    RuleNode(int level)
+        : level_(level), target_(-1) {}
 };
 
 /**
@@ -116,7 +107,7 @@ public:
      * Get the longest matched rule to combine the nodes.
      * \param startPOS the POS index code of the start node
      * \param nextNode the node next to the start node, the matching process ends before the end-of-sentence node is reached.
-     * \return the leaf Trie node of the longest matched rule for combination, if no rule is found, 0 is returned.
+     * \return the ending state of the longest matched rule for combination, if no rule is found, 0 is returned.
      */
     const RuleNode* getCombineRule(int startPOS, const MeCab::Node* nextNode) const;
 
@@ -137,8 +128,14 @@ private:
     /** map from POS alphabet format to index code */
     std::map<std::string, int> alphaPOSMap_;
 
-    /** root node to rule Trie */
-    RuleNode* ruleRoot_;
+    /** the states of rule automaton, the first one is start state, empty if no rule is loaded */
+    std::vector<RuleNode> ruleStates_;
+
+    /**
+     * the dense transition table of rule automaton, in which the next state of (state, POS index code)
+     * is at index (state * tableSize_ + POS index code), 0 for no transition as start state is never reached again
+     */
+    std::vector<int> ruleTransitions_;
 };
 
 } // namespace jma
@@ -0,0 +1,107 @@
+/** \file sentence_splitter.h
+ * Definition of class SentenceSplitter.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_SENTENCE_SPLITTER_H
+#define JMA_SENTENCE_SPLITTER_H
+
+#include <set>
+#include <string>
+#include <vector>
+
+namespace jma
+{
+
+class JMA_CType;
+
+/**
+ * SentenceSpan is the range of a sentence in paragraph string.
+ */
+struct SentenceSpan
+{
+    /** the byte offset in paragraph string */
+    unsigned int offset_;
+
+    /** the byte length */
+    unsigned int length_;
+};
+
+/** A list of sentence spans. */
+typedef std::vector<SentenceSpan> SentenceSpanList;
+
+/**
+ * SentenceSplitter splits a paragraph into sentences after each separator character.
+ * The separators are compiled into a byte-level automaton,
+ * and in the encoding that no character starts within another character, such as UTF-8,
+ * the candidates of separator are found by scanning their anchor bytes a word at a time.
+ */
+class SentenceSplitter
+{
+public:
+    /**
+     * Constructor, no separator is matched until it is built.
+     */
+    SentenceSplitter();
+
+    /**
+     * Compile the separators into automaton.
+     * \param separators the separator characters, the strings not in one character are ignored
+     * \param ctype the character encoding, which should be kept while splitting
+     * \param isSelfSync whether no character starts within another character in the encoding,
+     * so that the separators could be matched at any byte
+     */
+    void build(const std::set<std::string>& separators, const JMA_CType* ctype, bool isSelfSync);
+
+    /**
+     * Split a paragraph into sentences, each sentence ends with a separator except the last one.
+     * \param str the paragraph string
+     * \param length the byte length of paragraph string
+     * \param spans the list to append the sentence spans
+     * \param charLengths if not 0, the byte length of the character starting at each byte, which is already decoded,
+     * otherwise, the characters are decoded by the encoding if needed
+     */
+    void split(const char* str, unsigned int length, SentenceSpanList& spans, const unsigned char* charLengths = 0) const;
+
+private:
+    /**
+     * Get the byte length of the separator matched at a position.
+     * \param p the position to match
+     * \param end the end of string
+     * \return the separator length, 0 for no separator is matched
+     */
+    unsigned int match(const unsigned char* p, const unsigned char* end) const;
+
+    /**
+     * Find the next anchor byte of separator.
+     * \param p the position to start searching
+     * \param end the end of string
+     * \return the position of anchor byte, \e end if not found
+     */
+    const unsigned char* findAnchor(const unsigned char* p, const unsigned char* end) const;
+
+private:
+    /** the character encoding */
+    const JMA_CType* ctype_;
+
+    /** whether the separators could be matched at any byte */
+    bool isSelfSync_;
+
+    /** the next state of each state and byte, at index (state * 256 + byte), 0 for no transition */
+    std::vector<int> transitions_;
+
+    /** whether each state is the end of separator */
+    std::vector<bool> accepts_;
+
+    /** for each byte value, the bit i is set if it is the anchor at offset i in any separator */
+    unsigned char anchorMasks_[256];
+
+    /** the anchor bytes repeated in each byte of a word, used to scan a word at a time */
+    std::vector<unsigned long> anchorWords_;
+};
+
+} // namespace jma
+
+#endif // JMA_SENTENCE_SPLITTER_H
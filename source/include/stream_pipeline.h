@@ -0,0 +1,149 @@
+/** \file stream_pipeline.h
+ * Definition of class StreamPipeline.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#ifndef JMA_STREAM_PIPELINE_H
+#define JMA_STREAM_PIPELINE_H
+
+#ifdef HAVE_CONFIG_H
+#include "config.h" // HAVE_PTHREAD_H
+#endif
+
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#ifdef HAVE_PTHREAD_H
+#include <pthread.h>
+
+/** whether the stream could be analyzed by multiple threads */
+#define JMA_USE_STREAM_PIPELINE 1
+#endif
+
+namespace jma
+{
+
+class JMA_Analyzer;
+
+#ifdef JMA_USE_STREAM_PIPELINE
+
+/**
+ * StreamBatch is a batch of input lines and their output.
+ */
+struct StreamBatch
+{
+    /** the sequence number in input */
+    unsigned long id_;
+
+    /** the input lines, whose strings are reused among batches */
+    std::vector<std::string> lines_;
+
+    /** the number of lines read into \e lines_ */
+    unsigned int count_;
+
+    /** the output of all the lines */
+    std::string output_;
+};
+
+/**
+ * StreamBatchQueue is a bounded blocking queue of batches shared among threads.
+ */
+class StreamBatchQueue
+{
+public:
+    /**
+     * Constructor.
+     * \param capacity the maximum number of batches in queue
+     */
+    StreamBatchQueue(unsigned int capacity);
+
+    /**
+     * Destructor.
+     */
+    ~StreamBatchQueue();
+
+    /**
+     * Append a batch, which waits while the queue is full.
+     * \param batch the batch, 0 as the end mark
+     */
+    void push(StreamBatch* batch);
+
+    /**
+     * Remove the first batch, which waits while the queue is empty.
+     * \return the batch, 0 as the end mark
+     */
+    StreamBatch* pop();
+
+private:
+    /** the batches in a ring buffer */
+    std::vector<StreamBatch*> ring_;
+
+    /** the position of the first batch */
+    unsigned int head_;
+
+    /** the number of batches */
+    unsigned int size_;
+
+    /** the lock on the members */
+    pthread_mutex_t mutex_;
+
+    /** signaled when a batch is pushed */
+    pthread_cond_t notEmpty_;
+
+    /** signaled when a batch is popped */
+    pthread_cond_t notFull_;
+
+    // disable copy
+    StreamBatchQueue(const StreamBatchQueue&);
+    StreamBatchQueue& operator=(const StreamBatchQueue&);
+};
+
+/**
+ * StreamPipeline analyzes a stream line by line in parallel, which is used by \e JMA_Analyzer::runWithStream().
+ * The calling thread reads the input into batches of lines,
+ * each worker thread analyzes a batch by its own analyzer,
+ * and a writer thread writes the output of batches in input order,
+ * so that the output is the same as analyzing each line in turn by one analyzer.
+ * The stages are connected by bounded queues, and a fixed number of batches are recycled among them,
+ * so that the memory is bounded however large the input is.
+ */
+class StreamPipeline
+{
+public:
+    /**
+     * Constructor.
+     * \param workers the analyzers configured in the same way, one for each worker thread
+     * \param isTokenStream true if the output is in token stream, false for text
+     */
+    StreamPipeline(const std::vector<JMA_Analyzer*>& workers, bool isTokenStream);
+
+    /**
+     * Analyze each line in input.
+     * \param in the input stream
+     * \param out the output stream
+     */
+    void run(std::istream& in, std::ostream& out);
+
+    /**
+     * Analyze the lines in a batch, which is called by each worker thread.
+     * \param analyzer the analyzer of worker
+     * \param batch the batch, whose \e output_ is filled
+     */
+    void analyzeBatch(JMA_Analyzer& analyzer, StreamBatch& batch) const;
+
+private:
+    /** the analyzers of workers */
+    std::vector<JMA_Analyzer*> workers_;
+
+    /** whether the output is in token stream */
+    bool isTokenStream_;
+};
+
+#endif // JMA_USE_STREAM_PIPELINE
+
+} // namespace jma
+
+#endif // JMA_STREAM_PIPELINE_H
@@ -34,6 +34,12 @@ Analyzer::Analyzer()
     options_[OPTION_TYPE_COMPOUND_MORPHOLOGY] = 1; // enable combining into compound words defaultly
     options_[OPTION_TYPE_CONVERT_TO_HIRAGANA] = 0; // disable conversion to Hiragana characters defaultly
     options_[OPTION_TYPE_CONVERT_TO_KATAKANA] = 0; // disable conversion to Katakana characters defaultly
+    options_[OPTION_TYPE_NBEST_COST_GAP] = 0; // no limit on the cost gap of n-best results defaultly
+    options_[OPTION_TYPE_MORPHEME_FIELDS] = MORPHEME_FIELD_ALL; // give all the fields of morphemes defaultly
+    options_[OPTION_TYPE_OUTPUT_TOKEN_STREAM] = 0; // output in text format defaultly
+    options_[OPTION_TYPE_NORMALIZE_INPUT] = 0; // analyze the input as it is defaultly
+    options_[OPTION_TYPE_LONGEST_MATCH] = 0; // analyze by Viterbi search defaultly
+    options_[OPTION_TYPE_STREAM_WORKER_NUM] = 0; // analyze the stream in the calling thread defaultly
 }
 
 Analyzer::~Analyzer()
@@ -0,0 +1,46 @@
+/** \file analyzer_pool.cpp
+ * Implementation of class AnalyzerPool.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma/analyzer_pool.h"
+
+#include <cassert>
+
+namespace jma
+{
+
+AnalyzerPool::Handle::Handle(AnalyzerPool& pool)
+    : pool_(pool), analyzer_(pool.checkout())
+{
+}
+
+AnalyzerPool::Handle::~Handle()
+{
+    if(analyzer_)
+        pool_.checkin(analyzer_);
+}
+
+Analyzer* AnalyzerPool::Handle::get() const
+{
+    return analyzer_;
+}
+
+Analyzer* AnalyzerPool::Handle::operator->() const
+{
+    assert(analyzer_);
+
+    return analyzer_;
+}
+
+AnalyzerPool::AnalyzerPool()
+{
+}
+
+AnalyzerPool::~AnalyzerPool()
+{
+}
+
+} // namespace jma
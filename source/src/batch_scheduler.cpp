@@ -0,0 +1,254 @@
+/** \file batch_scheduler.cpp
+ * Implementation of class BatchScheduler.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "batch_scheduler.h"
+
+#ifdef JMA_USE_BATCH_SCHEDULER
+
+#include "jma_analyzer.h"
+#include "thread.h" // MeCab::thread
+
+#include <algorithm> // lower_bound, min
+#include <cassert>
+#include <cstring> // strlen
+
+using namespace std;
+
+namespace
+{
+/** a worker takes this fraction of bytes left in its range as a chunk */
+const unsigned long CHUNK_DIVISOR = 8;
+
+/** the maximum bytes of a chunk, so that the chunks could still be stolen in a large range */
+const unsigned long MAX_CHUNK_BYTES = 16 * 1024;
+
+/**
+ * WorkerThread analyzes the chunks of a worker.
+ */
+class WorkerThread : public MeCab::thread
+{
+public:
+    WorkerThread(jma::BatchScheduler& scheduler, unsigned int worker)
+        : scheduler_(scheduler), worker_(worker), result_(1)
+    {}
+
+    void run()
+    {
+        result_ = scheduler_.runWorker(worker_);
+    }
+
+    int getResult() const
+    {
+        return result_;
+    }
+
+private:
+    jma::BatchScheduler& scheduler_;
+    unsigned int worker_;
+    int result_;
+};
+}
+
+namespace jma
+{
+
+BatchScheduler::BatchScheduler(const std::vector<JMA_Analyzer*>& workers, std::vector<Sentence>& sentences)
+    : workers_(workers), sentences_(sentences), stealCount_(0)
+{
+    assert(! workers_.empty());
+
+    offsets_.resize(sentences_.size() + 1);
+    offsets_[0] = 0;
+    for(unsigned int i=0; i<sentences_.size(); ++i)
+    {
+        // an empty sentence still costs a little
+        offsets_[i+1] = offsets_[i] + strlen(sentences_[i].getString()) + 1;
+    }
+
+    // split in about the same bytes
+    const unsigned int workerNum = workers_.size();
+    unsigned int begin = 0;
+    for(unsigned int i=0; i<workerNum; ++i)
+    {
+        Range* range = new Range;
+        const unsigned long endOffset = offsets_.back() * (i + 1) / workerNum;
+        range->begin_ = begin;
+        range->end_ = (i + 1 == workerNum) ? sentences_.size() : findSentence(begin, sentences_.size(), endOffset);
+        pthread_mutex_init(&range->mutex_, 0);
+        ranges_.push_back(range);
+
+        begin = range->end_;
+    }
+
+    pthread_mutex_init(&stealMutex_, 0);
+}
+
+BatchScheduler::~BatchScheduler()
+{
+    for(unsigned int i=0; i<ranges_.size(); ++i)
+    {
+        pthread_mutex_destroy(&ranges_[i]->mutex_);
+        delete ranges_[i];
+    }
+
+    pthread_mutex_destroy(&stealMutex_);
+}
+
+unsigned long BatchScheduler::getBytes(unsigned int begin, unsigned int end) const
+{
+    return offsets_[end] - offsets_[begin];
+}
+
+unsigned int BatchScheduler::findSentence(unsigned int begin, unsigned int end, unsigned long offset) const
+{
+    assert(begin <= end && end < offsets_.size());
+
+    const unsigned int pos = lower_bound(offsets_.begin() + begin, offsets_.begin() + end + 1, offset) - offsets_.begin();
+    return min(pos, end);
+}
+
+int BatchScheduler::run()
+{
+    vector<WorkerThread*> threads;
+    for(unsigned int i=1; i<workers_.size(); ++i)
+    {
+        threads.push_back(new WorkerThread(*this, i));
+        threads.back()->start();
+    }
+
+    // the calling thread is the first worker
+    int result = runWorker(0);
+
+    for(unsigned int i=0; i<threads.size(); ++i)
+    {
+        threads[i]->join();
+        if(! threads[i]->getResult())
+            result = 0;
+        delete threads[i];
+    }
+
+    return result;
+}
+
+int BatchScheduler::runWorker(unsigned int worker)
+{
+    assert(worker < workers_.size());
+
+    JMA_Analyzer& analyzer = *workers_[worker];
+    int result = 1;
+    unsigned int begin, end;
+    while(next(worker, begin, end))
+    {
+        for(unsigned int i=begin; i<end; ++i)
+        {
+            if(! analyzer.runWithSentence(sentences_[i]))
+                result = 0;
+        }
+    }
+
+    return result;
+}
+
+bool BatchScheduler::next(unsigned int worker, unsigned int& begin, unsigned int& end)
+{
+    while(! take(worker, begin, end))
+    {
+        if(! steal(worker))
+            return false;
+    }
+
+    return true;
+}
+
+bool BatchScheduler::take(unsigned int worker, unsigned int& begin, unsigned int& end)
+{
+    Range& range = *ranges_[worker];
+    bool result = false;
+
+    pthread_mutex_lock(&range.mutex_);
+    if(range.begin_ < range.end_)
+    {
+        // at least one sentence
+        const unsigned long bytes = min(getBytes(range.begin_, range.end_) / CHUNK_DIVISOR, MAX_CHUNK_BYTES);
+        begin = range.begin_;
+        end = findSentence(range.begin_ + 1, range.end_, offsets_[range.begin_] + bytes);
+        range.begin_ = end;
+        result = true;
+    }
+    pthread_mutex_unlock(&range.mutex_);
+
+    return result;
+}
+
+bool BatchScheduler::steal(unsigned int worker)
+{
+    while(true)
+    {
+        // the victim having the most bytes left
+        unsigned int victim = worker;
+        unsigned long victimBytes = 0;
+        for(unsigned int i=0; i<ranges_.size(); ++i)
+        {
+            if(i == worker)
+                continue;
+
+            Range& range = *ranges_[i];
+            pthread_mutex_lock(&range.mutex_);
+            const unsigned long bytes = getBytes(range.begin_, range.end_);
+            pthread_mutex_unlock(&range.mutex_);
+
+            if(bytes > victimBytes)
+            {
+                victim = i;
+                victimBytes = bytes;
+            }
+        }
+
+        // as the ranges only shrink, all the sentences are taken
+        if(victim == worker)
+            return false;
+
+        Range& range = *ranges_[victim];
+        unsigned int begin = 0, end = 0;
+        pthread_mutex_lock(&range.mutex_);
+        if(range.begin_ < range.end_)
+        {
+            end = range.end_;
+            if(range.end_ - range.begin_ == 1)
+                begin = range.begin_;
+            else
+                begin = findSentence(range.begin_ + 1, range.end_ - 1, (offsets_[range.begin_] + offsets_[range.end_]) / 2);
+            range.end_ = begin;
+        }
+        pthread_mutex_unlock(&range.mutex_);
+
+        // try again if the victim has taken its range meanwhile
+        if(begin == end)
+            continue;
+
+        Range& own = *ranges_[worker];
+        pthread_mutex_lock(&own.mutex_);
+        own.begin_ = begin;
+        own.end_ = end;
+        pthread_mutex_unlock(&own.mutex_);
+
+        pthread_mutex_lock(&stealMutex_);
+        ++stealCount_;
+        pthread_mutex_unlock(&stealMutex_);
+
+        return true;
+    }
+}
+
+unsigned long BatchScheduler::getStealCount() const
+{
+    return stealCount_;
+}
+
+} // namespace jma
+
+#endif // JMA_USE_BATCH_SCHEDULER
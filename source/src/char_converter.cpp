@@ -0,0 +1,363 @@
+/** \file char_converter.cpp
+ * Implementation of class CharConverter.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "char_converter.h"
+#include "jma_ctype.h"
+
+#include <algorithm> // upper_bound
+#include <cassert>
+#include <cstring> // strlen, memcpy
+
+using namespace std;
+
+namespace
+{
+/** the maximum byte length of a character in table */
+const unsigned int MAX_KEY_BYTES = 4;
+
+/** the bits with the highest bit of each byte set in a word */
+const unsigned long HIGH_BITS = ~0UL / 0xFF * 0x80;
+
+/**
+ * Check whether each byte in a word is ASCII.
+ * \param p the word start, which need not be aligned
+ * \return true for all ASCII, false for not
+ */
+inline bool isAsciiWord(const char* p)
+{
+    unsigned long word;
+    memcpy(&word, p, sizeof(word));
+    return (word & HIGH_BITS) == 0;
+}
+
+/**
+ * Get the hash value of a key.
+ * \param key the packed key
+ * \return the hash value
+ */
+inline unsigned int hashKey(unsigned int key)
+{
+    return (key * 2654435761U) >> 8;
+}
+
+/**
+ * Compare the offset in converted string with segment.
+ */
+struct SegmentLess
+{
+    template<class Segment>
+    bool operator()(unsigned int offset, const Segment& segment) const
+    {
+        return offset < segment.convOffset_;
+    }
+};
+}
+
+namespace jma
+{
+
+void OffsetMap::clear()
+{
+    byteSegments_.clear();
+    charSegments_.clear();
+}
+
+void OffsetMap::reserve(unsigned int count)
+{
+    byteSegments_.reserve(count);
+    charSegments_.reserve(count);
+}
+
+void OffsetMap::addChar(unsigned int origByte, unsigned int origByteLength, unsigned int origChar,
+        unsigned int convByte, unsigned int convByteLength, unsigned int convChar, unsigned int convCharLength)
+{
+    if(convByteLength != origByteLength)
+    {
+        Segment segment = {convByte, convByteLength, origByte, origByteLength};
+        byteSegments_.push_back(segment);
+    }
+
+    if(convCharLength != 1)
+    {
+        Segment segment = {convChar, convCharLength, origChar, 1};
+        charSegments_.push_back(segment);
+    }
+}
+
+unsigned int OffsetMap::toOriginalByte(unsigned int offset, bool isEnd) const
+{
+    return toOriginal(byteSegments_, offset, isEnd);
+}
+
+unsigned int OffsetMap::toOriginalChar(unsigned int offset, bool isEnd) const
+{
+    return toOriginal(charSegments_, offset, isEnd);
+}
+
+unsigned int OffsetMap::toOriginal(const std::vector<Segment>& segments, unsigned int offset, bool isEnd)
+{
+    // the last segment starting not after offset
+    vector<Segment>::const_iterator it = upper_bound(segments.begin(), segments.end(), offset, SegmentLess());
+    if(it == segments.begin())
+        return offset;
+
+    const Segment& segment = *(--it);
+    if(offset == segment.convOffset_ && segment.convLength_)
+        return segment.origOffset_;
+
+    if(offset < segment.convOffset_ + segment.convLength_)
+        return isEnd ? segment.origOffset_ + segment.origLength_ : segment.origOffset_;
+
+    return segment.origOffset_ + segment.origLength_ + (offset - segment.convOffset_ - segment.convLength_);
+}
+
+CharConverter::CharConverter()
+    : ctype_(0)
+{
+    clear();
+}
+
+void CharConverter::clear()
+{
+    chain_.clear();
+    resetTable();
+}
+
+void CharConverter::resetTable()
+{
+    outputs_.clear();
+    table_.clear();
+
+    memset(asciiEntries_, 0, sizeof(asciiEntries_));
+    for(int i=0; i<128; ++i)
+        asciiBytes_[i] = static_cast<char>(i);
+    isAsciiByteMap_ = isAsciiIdentity_ = true;
+}
+
+void CharConverter::addStep(const CharTable::CharMap& charMap)
+{
+    // apply this step on the output of previous steps
+    for(CharTable::CharMap::iterator it=chain_.begin(); it!=chain_.end(); ++it)
+    {
+        CharTable::CharMap::const_iterator stepIt = charMap.find(it->second);
+        if(stepIt != charMap.end())
+            it->second = stepIt->second;
+    }
+
+    // the characters not converted by previous steps
+    for(CharTable::CharMap::const_iterator it=charMap.begin(); it!=charMap.end(); ++it)
+        chain_.insert(*it);
+}
+
+unsigned int CharConverter::packKey(const char* p, unsigned int length)
+{
+    assert(length <= MAX_KEY_BYTES);
+
+    unsigned int key = 0;
+    for(unsigned int i=0; i<length; ++i)
+        key = (key << 8) | static_cast<unsigned char>(p[i]);
+
+    return key;
+}
+
+void CharConverter::build(const JMA_CType* ctype)
+{
+    assert(ctype);
+    ctype_ = ctype;
+    resetTable();
+
+    vector<Entry> entries;
+    for(CharTable::CharMap::const_iterator it=chain_.begin(); it!=chain_.end(); ++it)
+    {
+        const string& source = it->first;
+        const string& target = it->second;
+        const unsigned int length = source.size();
+
+        // only a single character could be matched in conversion
+        if(source == target || length == 0 || length > MAX_KEY_BYTES
+                || ctype->getByteCount(source.c_str()) != length)
+            continue;
+
+        Entry entry;
+        entry.key_ = packKey(source.data(), length);
+        entry.offset_ = outputs_.size();
+        entry.length_ = target.size();
+        entry.charLength_ = ctype->length(target.c_str());
+        outputs_ += target;
+
+        const unsigned char c = static_cast<unsigned char>(source[0]);
+        if(length == 1 && c < 0x80)
+        {
+            asciiEntries_[c] = entry;
+            isAsciiIdentity_ = false;
+
+            if(target.size() == 1 && static_cast<unsigned char>(target[0]) < 0x80)
+                asciiBytes_[c] = target[0];
+            else
+                isAsciiByteMap_ = false;
+        }
+        else
+            entries.push_back(entry);
+    }
+
+    if(isAsciiIdentity_ || ! isAsciiByteMap_)
+    {
+        for(int i=0; i<128; ++i)
+            asciiBytes_[i] = static_cast<char>(i);
+    }
+
+    if(entries.empty())
+        return;
+
+    // keep the load factor no more than 0.5
+    unsigned int size = 16;
+    while(size < entries.size() * 2)
+        size <<= 1;
+
+    Entry empty = {0, 0, 0, 0};
+    table_.assign(size, empty);
+    const unsigned int mask = size - 1;
+    for(unsigned int i=0; i<entries.size(); ++i)
+    {
+        unsigned int pos = hashKey(entries[i].key_) & mask;
+        while(table_[pos].key_)
+            pos = (pos + 1) & mask;
+        table_[pos] = entries[i];
+    }
+}
+
+bool CharConverter::empty() const
+{
+    return isAsciiIdentity_ && table_.empty();
+}
+
+const CharConverter::Entry* CharConverter::findEntry(unsigned int key) const
+{
+    if(table_.empty())
+        return 0;
+
+    const unsigned int mask = table_.size() - 1;
+    for(unsigned int pos = hashKey(key) & mask; table_[pos].key_; pos = (pos + 1) & mask)
+    {
+        if(table_[pos].key_ == key)
+            return &table_[pos];
+    }
+
+    return 0;
+}
+
+void CharConverter::convert(const char* str, std::string& result, OffsetMap* offsetMap) const
+{
+    assert(str);
+
+    convert(str, strlen(str), result, offsetMap);
+}
+
+void CharConverter::convert(const char* str, unsigned int length, std::string& result, OffsetMap* offsetMap) const
+{
+    assert(str);
+
+    const char* p = str;
+    const char* end = str + length;
+    const string::size_type resultStart = result.size();
+    result.reserve(resultStart + (end - str));
+
+    // the character offsets, which are counted only for offset map
+    unsigned int origChar = 0;
+    unsigned int convChar = 0;
+    if(offsetMap)
+        offsetMap->clear();
+
+    while(p < end)
+    {
+        // scan the ASCII characters a word at a time
+        const char* q = p;
+        while(static_cast<size_t>(end - q) >= sizeof(unsigned long) && isAsciiWord(q))
+            q += sizeof(unsigned long);
+        while(q < end && ! (*q & 0x80))
+            ++q;
+
+        if(q != p)
+        {
+            if(isAsciiIdentity_ || isAsciiByteMap_)
+            {
+                if(offsetMap)
+                {
+                    origChar += q - p;
+                    convChar += q - p;
+                }
+
+                if(isAsciiIdentity_)
+                {
+                    result.append(p, q - p);
+                    p = q;
+                }
+                else
+                {
+                    const string::size_type start = result.size();
+                    result.resize(start + (q - p));
+                    for(string::size_type i = start; p < q; ++p, ++i)
+                        result[i] = asciiBytes_[static_cast<unsigned char>(*p)];
+                }
+            }
+            else
+            {
+                for(; p < q; ++p)
+                {
+                    const Entry& entry = asciiEntries_[static_cast<unsigned char>(*p)];
+                    if(! entry.key_)
+                    {
+                        result += *p;
+                        if(offsetMap)
+                        {
+                            ++origChar;
+                            ++convChar;
+                        }
+                        continue;
+                    }
+
+                    if(offsetMap)
+                    {
+                        offsetMap->addChar(p - str, 1, origChar, result.size() - resultStart, entry.length_, convChar, entry.charLength_);
+                        ++origChar;
+                        convChar += entry.charLength_;
+                    }
+                    result.append(outputs_.data() + entry.offset_, entry.length_);
+                }
+            }
+
+            if(p == end)
+                break;
+        }
+
+        // convert a multi-byte character
+        unsigned int length = ctype_ ? ctype_->getByteCount(p) : 1;
+        if(length == 0 || length > static_cast<unsigned int>(end - p))
+            length = end - p;
+
+        const Entry* entry = length <= MAX_KEY_BYTES ? findEntry(packKey(p, length)) : 0;
+        if(entry)
+        {
+            if(offsetMap)
+            {
+                offsetMap->addChar(p - str, length, origChar, result.size() - resultStart, entry->length_, convChar, entry->charLength_);
+                convChar += entry->charLength_;
+            }
+            result.append(outputs_.data() + entry->offset_, entry->length_);
+        }
+        else
+        {
+            result.append(p, length);
+            ++convChar;
+        }
+
+        ++origChar;
+        p += length;
+    }
+}
+
+} // namespace jma
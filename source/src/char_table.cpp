@@ -124,4 +124,14 @@ const char* CharTable::toRight(const char* str) const
     return it->second.c_str();
 }
 
+const CharTable::CharMap& CharTable::getMapToRight() const
+{
+    return mapToRight_;
+}
+
+const CharTable::CharMap& CharTable::getMapToLeft() const
+{
+    return mapToLeft_;
+}
+
 } // namespace jma
@@ -15,10 +15,15 @@
 #include <vector>
 #include <cstring> // strlen
 #include <algorithm> // find
+#include <map>
+#include <set>
+#include <limits>
 
 #include "jma_analyzer.h"
 #include "tokenizer.h"
 #include "char_table.h"
+#include "stream_pipeline.h"
+#include "batch_scheduler.h"
 
 #define JMA_DEBUG_PRINT_COMBINE 0
 
@@ -34,6 +39,7 @@ const int BASE_NBEST_SCORE = 200;
  * while \e MeCab::Tagger::nextNode() gives results differing in segementation, POS, base form, reading, etc,
  * so that those results duplicated on segmentation/POS would be removed, and \e MeCab::Tagger::nextNode() would be called continuously until it gives the unique result.
  * To avoid calling it forever, limit the maximum count to be (N * NBEST_LIMIT_SCALE_FACTOR).
+ * In \e JMA_Analyzer::nextNBest(), the maximum count is NBEST_LIMIT_SCALE_FACTOR for each candidate.
  */
 const int NBEST_LIMIT_SCALE_FACTOR = 100;
 
@@ -63,6 +69,337 @@ private:
     jma::MorphemeList& morphList_;
 };
 
+/**
+ * In JMA_Analyzer::iterateNodeView(), used to count the character offsets while moving forward in string.
+ */
+class OffsetCounter
+{
+public:
+    /**
+     * Constructor.
+     * \param ctype the character type
+     * \param lengths the byte length of the character starting at each byte of string, 0 to decode by \e ctype
+     * \param str the string start
+     * \param charOffset the character offset of string start
+     */
+    OffsetCounter(const jma::JMA_CType* ctype, const unsigned char* lengths, const char* str, unsigned int charOffset)
+        :ctype_(ctype), lengths_(lengths), pos_(str), charOffset_(charOffset) {}
+
+    /**
+     * Move forward to a position in string.
+     * \param p the position, which should not be before the current position
+     * \return the character offset of \e p
+     */
+    unsigned int moveTo(const char* p) {
+        while(pos_ < p)
+        {
+            const unsigned int len = lengths_ ? *lengths_ : ctype_->getByteCount(pos_);
+            if(len == 0)
+                break;
+
+            pos_ += len;
+            if(lengths_)
+                lengths_ += len;
+            ++charOffset_;
+        }
+
+        return charOffset_;
+    }
+
+private:
+    /** the character type */
+    const jma::JMA_CType* ctype_;
+
+    /** the character lengths at the current position, 0 for not decoded */
+    const unsigned char* lengths_;
+
+    /** the current position */
+    const char* pos_;
+
+    /** the character offset of current position */
+    unsigned int charOffset_;
+};
+
+/** The chunk size of memory for the strings in morpheme views. */
+const size_t VIEW_ARENA_CHUNK_SIZE = 8192;
+
+/** The maximum ratio of byte length after character conversion to that before conversion. */
+const unsigned int MAX_CONVERT_EXPANSION = 4;
+
+/**
+ * In JMA_Analyzer::iterateNodeView(), used as ViewProcessor to convert each morpheme view to morpheme for MorphemeProcessor.
+ */
+template<class MorphemeProcessor>
+class ViewToMorpheme
+{
+public:
+    /**
+     * Constructor.
+     * \param processor the morpheme processor
+     */
+    ViewToMorpheme(MorphemeProcessor& processor) :processor_(processor) {}
+
+    /**
+     * The process method converts the view to morpheme, and calls the morpheme processor.
+     * \param view the morpheme view
+     */
+    void process(const jma::MorphemeView& view) {
+        view.toMorpheme(morph_);
+        processor_.process(morph_);
+    }
+
+private:
+    /** the morpheme processor */
+    MorphemeProcessor& processor_;
+
+    /** the morpheme buffer */
+    jma::Morpheme morph_;
+};
+
+/**
+ * In JMA_Analyzer::iterateNodeView(), used as ViewProcessor to append morpheme view to list.
+ */
+class ViewToList
+{
+public:
+    /**
+     * Constructor.
+     * \param list the morpheme view list
+     */
+    ViewToList(jma::MorphemeViewList& list) :viewList_(list) {}
+
+    /**
+     * The process method appends morpheme view to list.
+     * \param view the morpheme view to append
+     */
+    void process(const jma::MorphemeView& view) { viewList_.push_back(view); }
+
+private:
+    /** the morpheme view list */
+    jma::MorphemeViewList& viewList_;
+};
+
+/**
+ * In JMA_Analyzer::iterateNodeView(), used as ViewProcessor to append morpheme view to columns.
+ */
+class ViewToColumns
+{
+public:
+    /**
+     * Constructor.
+     * \param columns the morpheme columns
+     */
+    ViewToColumns(jma::MorphemeColumns& columns) :columns_(columns) {}
+
+    /**
+     * The process method appends morpheme view to columns.
+     * \param view the morpheme view to append
+     */
+    void process(const jma::MorphemeView& view) { columns_.append(view); }
+
+private:
+    /** the morpheme columns */
+    jma::MorphemeColumns& columns_;
+};
+
+/**
+ * In JMA_Analyzer::iterateNodeView(), used to check whether the ViewProcessor builds MorphemeHierarchy,
+ * and to give it the morpheme views in both granularities.
+ * Those processors not building hierarchy only get the coarse-grained morphemes by their \e process() method.
+ */
+template<class ViewProcessor>
+struct HierarchyTrait
+{
+    /** whether the processor builds hierarchy */
+    enum { IS_HIERARCHY = 0 };
+
+    /**
+     * Give the coarse-grained morpheme, which is followed by its children given in \e processFine().
+     * \param processor the view processor
+     * \param view the coarse-grained morpheme, 0 if it is filtered
+     */
+    static void beginCoarse(ViewProcessor& processor, const jma::MorphemeView* view) {}
+
+    /**
+     * Give the fine-grained morpheme.
+     * \param processor the view processor
+     * \param view the fine-grained morpheme
+     */
+    static void processFine(ViewProcessor& processor, const jma::MorphemeView& view) {}
+};
+
+/**
+ * In JMA_Analyzer::iterateLimitView(), used as ViewProcessor to map the offsets of each morpheme view from normalized sentence to raw sentence.
+ */
+template<class ViewProcessor>
+class ViewToOriginal
+{
+public:
+    /**
+     * Constructor.
+     * \param offsetMap the offset map from normalized sentence to raw sentence
+     * \param byteStart the byte offset of raw sentence, which is added to the mapped offsets
+     * \param charStart the character offset of raw sentence, which is added to the mapped offsets
+     * \param processor the view processor
+     */
+    ViewToOriginal(const jma::OffsetMap& offsetMap, unsigned int byteStart, unsigned int charStart, ViewProcessor& processor)
+        :offsetMap_(offsetMap), byteStart_(byteStart), charStart_(charStart), processor_(processor) {}
+
+    /**
+     * The process method maps the offsets, and calls the view processor.
+     * \param view the morpheme view in normalized sentence
+     */
+    void process(const jma::MorphemeView& view) {
+        processor_.process(toOriginal(view));
+    }
+
+    /**
+     * Map the offsets of coarse-grained morpheme, and give it to the view processor.
+     * \param view the morpheme view in normalized sentence, 0 if it is filtered
+     */
+    void beginCoarse(const jma::MorphemeView* view) {
+        HierarchyTrait<ViewProcessor>::beginCoarse(processor_, view ? &toOriginal(*view) : 0);
+    }
+
+    /**
+     * Map the offsets of fine-grained morpheme, and give it to the view processor.
+     * \param view the morpheme view in normalized sentence
+     */
+    void processFine(const jma::MorphemeView& view) {
+        HierarchyTrait<ViewProcessor>::processFine(processor_, toOriginal(view));
+    }
+
+private:
+    /**
+     * Map the offsets to raw sentence.
+     * \param view the morpheme view in normalized sentence
+     * \return the morpheme view in raw sentence, which is valid until the next call
+     */
+    const jma::MorphemeView& toOriginal(const jma::MorphemeView& view) {
+        view_ = view;
+        view_.byteOffset_ = offsetMap_.toOriginalByte(view.byteOffset_, false);
+        const unsigned int byteEnd = offsetMap_.toOriginalByte(view.byteOffset_ + view.byteLength_, view.byteLength_ != 0);
+        view_.byteLength_ = byteEnd > view_.byteOffset_ ? byteEnd - view_.byteOffset_ : 0;
+        view_.charOffset_ = offsetMap_.toOriginalChar(view.charOffset_, false);
+        const unsigned int charEnd = offsetMap_.toOriginalChar(view.charOffset_ + view.charLength_, view.charLength_ != 0);
+        view_.charLength_ = charEnd > view_.charOffset_ ? charEnd - view_.charOffset_ : 0;
+        view_.byteOffset_ += byteStart_;
+        view_.charOffset_ += charStart_;
+        return view_;
+    }
+
+    /** the offset map */
+    const jma::OffsetMap& offsetMap_;
+
+    /** the byte offset of raw sentence */
+    const unsigned int byteStart_;
+
+    /** the character offset of raw sentence */
+    const unsigned int charStart_;
+
+    /** the view processor */
+    ViewProcessor& processor_;
+
+    /** the morpheme view buffer */
+    jma::MorphemeView view_;
+};
+
+/**
+ * In JMA_Analyzer::runWithHierarchy(), used as ViewProcessor to build morpheme hierarchy.
+ */
+class ViewToHierarchy
+{
+public:
+    /**
+     * Constructor.
+     * \param hierarchy the morpheme hierarchy
+     */
+    ViewToHierarchy(jma::MorphemeHierarchy& hierarchy) :hierarchy_(hierarchy), isLinked_(false) {}
+
+    /**
+     * The process method is not called, as both granularities are given in hierarchy.
+     * \param view the morpheme view
+     */
+    void process(const jma::MorphemeView& view) { assert(false && "the hierarchy should be built by beginCoarse() and processFine()."); }
+
+    /**
+     * Append the coarse-grained morpheme, and link its children given in \e processFine().
+     * \param view the coarse-grained morpheme, 0 if it is filtered, so that its children are not linked
+     */
+    void beginCoarse(const jma::MorphemeView* view) {
+        isLinked_ = (view != 0);
+        if(view) {
+            hierarchy_.coarse_.push_back(*view);
+            const unsigned int fineSize = hierarchy_.fine_.size();
+            jma::MorphemeHierarchy::Range range = {fineSize, fineSize};
+            hierarchy_.children_.push_back(range);
+        }
+    }
+
+    /**
+     * Append the fine-grained morpheme as a child of the last coarse-grained morpheme.
+     * \param view the fine-grained morpheme
+     */
+    void processFine(const jma::MorphemeView& view) {
+        hierarchy_.fine_.push_back(view);
+        if(isLinked_)
+            hierarchy_.children_.back().end_ = hierarchy_.fine_.size();
+    }
+
+private:
+    /** the morpheme hierarchy */
+    jma::MorphemeHierarchy& hierarchy_;
+
+    /** whether the fine-grained morphemes are linked to the last coarse-grained morpheme */
+    bool isLinked_;
+};
+
+/**
+ * HierarchyTrait for ViewToHierarchy.
+ */
+template<>
+struct HierarchyTrait<ViewToHierarchy>
+{
+    enum { IS_HIERARCHY = 1 };
+    static void beginCoarse(ViewToHierarchy& processor, const jma::MorphemeView* view) { processor.beginCoarse(view); }
+    static void processFine(ViewToHierarchy& processor, const jma::MorphemeView& view) { processor.processFine(view); }
+};
+
+/**
+ * HierarchyTrait for ViewToOriginal, which is the same as its view processor.
+ */
+template<class ViewProcessor>
+struct HierarchyTrait<ViewToOriginal<ViewProcessor> >
+{
+    enum { IS_HIERARCHY = HierarchyTrait<ViewProcessor>::IS_HIERARCHY };
+    static void beginCoarse(ViewToOriginal<ViewProcessor>& processor, const jma::MorphemeView* view) { processor.beginCoarse(view); }
+    static void processFine(ViewToOriginal<ViewProcessor>& processor, const jma::MorphemeView& view) { processor.processFine(view); }
+};
+
+/**
+ * In JMA_Analyzer::iterateNodeView(), used as ViewProcessor to give each morpheme view as fine-grained morpheme in hierarchy.
+ */
+template<class ViewProcessor>
+class ViewToFine
+{
+public:
+    /**
+     * Constructor.
+     * \param processor the view processor building hierarchy
+     */
+    ViewToFine(ViewProcessor& processor) :processor_(processor) {}
+
+    /**
+     * The process method gives the view as fine-grained morpheme.
+     * \param view the morpheme view
+     */
+    void process(const jma::MorphemeView& view) { HierarchyTrait<ViewProcessor>::processFine(processor_, view); }
+
+private:
+    /** the view processor */
+    ViewProcessor& processor_;
+};
+
 /**
  * In JMA_Analyzer::iterateSentence(), used as SentenceProcessor to append sentence to list. 
  */
@@ -92,52 +429,172 @@ private:
 };
 
 /**
- * In JMA_Analyzer::iterateSentence(), used as SentenceProcessor to analyze each sentence and append the analysis result to buffer. 
+ * In JMA_Analyzer::runWithString(), used as ViewProcessor to write each morpheme view as token,
+ * whose offsets are already in the whole input string.
  */
-class SentenceToAnalyzerBuffer
+class ViewToTokenStream
 {
 public:
     /**
      * Constructor.
-     * \param analyzer the sentence analyzer
-     * \param buf the result buffer
+     * \param writer the token stream writer, whose document should have begun
      */
-    SentenceToAnalyzerBuffer(jma::JMA_Analyzer& analyzer, string& buf)
-        :analyzer_(analyzer), buffer_(buf) {}
+    ViewToTokenStream(jma::TokenStreamWriter& writer) :writer_(writer) {}
 
     /**
-     * The process method analyzes sentence to buffer.
-     * \param str the sentence string
+     * The process method writes morpheme view as token.
+     * \param view the morpheme view
      */
-    void process(const char* str) {
-        assert(str);
+    void process(const jma::MorphemeView& view) { writer_.addToken(view); }
+
+private:
+    /** the token stream writer */
+    jma::TokenStreamWriter& writer_;
+};
+
+/**
+ * In JMA_Analyzer::runWithTermFrequency(), used as ViewProcessor to count each morpheme view as term.
+ */
+class ViewToTermFrequency
+{
+public:
+    /**
+     * Constructor.
+     * \param table the term frequency table
+     */
+    ViewToTermFrequency(jma::TermFrequency& table)
+        :table_(table), isBaseForm_(table.getKeyType() == jma::TermFrequency::KEY_BASE_FORM) {}
 
-        jma::Sentence sentence(str);
-        analyzer_.runOneBest(sentence);
+    /**
+     * The process method adds morpheme view as term.
+     * \param view the morpheme view
+     */
+    void process(const jma::MorphemeView& view) {
+        if(isBaseForm_)
+            table_.add(view.termId_, view.baseForm_, view.baseFormLength_);
+        else
+            table_.add(view.termId_, view.lexicon_, view.lexiconLength_);
+    }
 
-        // get result only if it exists
-        if(sentence.getListSize()) {
-            assert(sentence.getListSize() == 1 && "one best analyze should contain only one result");
+private:
+    /** the term frequency table */
+    jma::TermFrequency& table_;
 
-            int index = 0;
-            bool isPOS = analyzer_.isOutputPOS();
-            const char* posDelim = analyzer_.getPOSDelimiter();
-            const char* wordDelim = analyzer_.getWordDelimiter();
+    /** whether the terms are identified by base form */
+    const bool isBaseForm_;
+};
 
-            for(int j=0; j<sentence.getCount(index); ++j) {
-                buffer_ += sentence.getLexicon(index, j);
-                if(isPOS) {
-                    buffer_ += posDelim;
-                    buffer_ += sentence.getStrPOS(index, j);
-                }
-                buffer_ += wordDelim;
-            }
+/**
+ * In JMA_Analyzer::runWithSegment(), used as ViewProcessor to save the byte range of each morpheme view.
+ */
+class ViewToSegment
+{
+public:
+    /**
+     * Constructor.
+     * \param offsets the flat buffer of start and end offsets
+     */
+    ViewToSegment(vector<unsigned int>& offsets) :offsets_(offsets) {}
+
+    /**
+     * The process method appends the byte range of morpheme view.
+     * \param view the morpheme view
+     */
+    void process(const jma::MorphemeView& view) {
+        offsets_.push_back(view.byteOffset_);
+        offsets_.push_back(view.byteOffset_ + view.byteLength_);
+    }
+
+private:
+    /** the flat buffer of start and end offsets */
+    vector<unsigned int>& offsets_;
+};
+
+/**
+ * In JMA_Analyzer::runWithQuery(), used as ViewProcessor to append morpheme view to query result.
+ */
+class ViewToQuery
+{
+public:
+    /**
+     * Constructor.
+     * \param result the query result
+     */
+    ViewToQuery(jma::QueryResult& result) :result_(result) {}
+
+    /**
+     * The process method appends morpheme view to query result.
+     * \param view the morpheme view to append
+     */
+    void process(const jma::MorphemeView& view) { result_.push_back(view); }
+
+private:
+    /** the query result */
+    jma::QueryResult& result_;
+};
+
+/**
+ * In JMA_Analyzer::iterateNodeView(), used as ViewProcessor to give each morpheme view to sink.
+ */
+class ViewToSink
+{
+public:
+    /**
+     * Constructor.
+     * \param sink the morpheme sink
+     */
+    ViewToSink(jma::MorphemeSink& sink) :sink_(sink) {}
+
+    /**
+     * The process method gives morpheme view to sink.
+     * \param view the morpheme view
+     */
+    void process(const jma::MorphemeView& view) { sink_.processMorpheme(view); }
+
+private:
+    /** the morpheme sink */
+    jma::MorphemeSink& sink_;
+};
+
+/**
+ * In JMA_Analyzer::runWithString(), used as MorphemeSink to append the analysis result to buffer.
+ */
+class AnalyzerBufferSink : public jma::MorphemeSink
+{
+public:
+    /**
+     * Constructor.
+     * \param analyzer the analyzer, whose options decide the output format
+     * \param buf the result buffer
+     */
+    AnalyzerBufferSink(const jma::JMA_Analyzer& analyzer, string& buf)
+        :isPOS_(analyzer.isOutputPOS()),
+        posDelim_(analyzer.getPOSDelimiter()),
+        wordDelim_(analyzer.getWordDelimiter()),
+        buffer_(buf) {}
+
+    /**
+     * Append the morpheme to buffer.
+     * \param view the morpheme view
+     */
+    virtual void processMorpheme(const jma::MorphemeView& view) {
+        buffer_.append(view.lexicon_, view.lexiconLength_);
+        if(isPOS_) {
+            buffer_ += posDelim_;
+            buffer_ += view.posStr_;
         }
+        buffer_ += wordDelim_;
     }
 
 private:
-    /** the sentence analyzer */
-    jma::JMA_Analyzer& analyzer_;
+    /** whether output POS */
+    const bool isPOS_;
+
+    /** the delimiter between word and POS */
+    const char* posDelim_;
+
+    /** the delimiter between words */
+    const char* wordDelim_;
 
     /** the result buffer */
     string& buffer_;
@@ -195,8 +652,12 @@ inline bool isSameMorphemeList( const MorphemeList* list1, const MorphemeList* l
 JMA_Analyzer::JMA_Analyzer()
     : knowledge_(0), tagger_(0),
     posTable_(0), kanaTable_(0),
-    widthTable_(0), caseTable_(0)
+    widthTable_(0), caseTable_(0),
+    convertSteps_(-1), stopTermRevision_(0),
+    scanBegin_(0), scanEnd_(0), scanLengths_(0),
+    queryLength_(0), arena_(VIEW_ARENA_CHUNK_SIZE)
 {
+    compilePlan();
 }
 
 JMA_Analyzer::~JMA_Analyzer()
@@ -207,6 +668,82 @@ JMA_Analyzer::~JMA_Analyzer()
 void JMA_Analyzer::clear()
 {
     delete tagger_;
+
+    // the workers refer to the knowledge set before
+    for(unsigned int i=0; i<workers_.size(); ++i)
+        delete workers_[i];
+    workers_.clear();
+}
+
+void JMA_Analyzer::setOption(OptionType nOption, double nValue)
+{
+    Analyzer::setOption(nOption, nValue);
+
+    compilePlan();
+}
+
+void JMA_Analyzer::compilePlan()
+{
+    plan_.fields_ = static_cast<int>(getOption(OPTION_TYPE_MORPHEME_FIELDS));
+    plan_.posFormat_ = getPOSFormat();
+    plan_.isCombine_ = isCombineCompound();
+    plan_.isDecompose_ = isDecomposeUserNound();
+    plan_.isNormalize_ = (getOption(OPTION_TYPE_NORMALIZE_INPUT) != 0);
+    plan_.isLongestMatch_ = (getOption(OPTION_TYPE_LONGEST_MATCH) != 0);
+
+    if(knowledge_)
+    {
+        plan_.baseFormOffset_ = knowledge_->getBaseFormOffset();
+        plan_.readFormOffset_ = knowledge_->getReadFormOffset();
+        plan_.normFormOffset_ = knowledge_->getNormFormOffset();
+    }
+    else
+    {
+        plan_.baseFormOffset_ = plan_.readFormOffset_ = plan_.normFormOffset_ = -1;
+    }
+
+    compileConverter();
+}
+
+void JMA_Analyzer::compileConverter()
+{
+    if(! knowledge_ || ! knowledge_->getCType())
+        return;
+
+    // the conversion steps in the order of applying them
+    const struct
+    {
+        OptionType option_;
+        const CharTable* table_;
+        bool isToRight_;
+    } steps[] = {
+        {OPTION_TYPE_CONVERT_TO_HIRAGANA, kanaTable_, false},
+        {OPTION_TYPE_CONVERT_TO_KATAKANA, kanaTable_, true},
+        {OPTION_TYPE_CONVERT_TO_HALF_WIDTH, widthTable_, false},
+        {OPTION_TYPE_CONVERT_TO_FULL_WIDTH, widthTable_, true},
+        {OPTION_TYPE_CONVERT_TO_LOWER_CASE, caseTable_, false},
+        {OPTION_TYPE_CONVERT_TO_UPPER_CASE, caseTable_, true}
+    };
+    const int stepNum = sizeof(steps) / sizeof(steps[0]);
+
+    int convertSteps = 0;
+    for(int i=0; i<stepNum; ++i)
+    {
+        if(getOption(steps[i].option_) != 0)
+            convertSteps |= 1 << i;
+    }
+
+    if(convertSteps == convertSteps_)
+        return;
+
+    converter_.clear();
+    for(int i=0; i<stepNum; ++i)
+    {
+        if(convertSteps & (1 << i))
+            converter_.addStep(steps[i].isToRight_ ? steps[i].table_->getMapToRight() : steps[i].table_->getMapToLeft());
+    }
+    converter_.build(knowledge_->getCType());
+    convertSteps_ = convertSteps;
 }
 
 bool JMA_Analyzer::isPOSFormatAlphabet() const
@@ -229,6 +766,26 @@ bool JMA_Analyzer::isDecomposeUserNound() const
     return (getOption(OPTION_TYPE_DECOMPOSE_USER_NOUN) != 0);
 }
 
+bool JMA_Analyzer::initNBest(const char* str) const
+{
+    tagger_->set_nbest_cost_gap(static_cast<long>(getOption(OPTION_TYPE_NBEST_COST_GAP)));
+
+    if(!tagger_->parseNBestInit(str))
+    {
+        cerr << "error: fail to init nbest analyze on string: " << str << endl;
+        return false;
+    }
+
+    return true;
+}
+
+size_t JMA_Analyzer::getNBestAgendaSize() const
+{
+    assert(tagger_);
+
+    return tagger_->nbest_agenda_size();
+}
+
 POSTable::POSFormat JMA_Analyzer::getPOSFormat() const
 {
     POSTable::POSFormat type = POSTable::POS_FORMAT_DEFAULT;
@@ -272,7 +829,12 @@ int JMA_Analyzer::setKnowledge(Knowledge* pKnowledge)
     kanaTable_ = &knowledge_->getKanaTable();
     widthTable_ = &knowledge_->getWidthTable();
     caseTable_ = &knowledge_->getCaseTable();
-    decompMap_ = &knowledge_->getDecompMap();
+    decompTable_ = &knowledge_->getDecompTable();
+
+    convertSteps_ = -1;
+    compilePlan();
+    compileStopTerms();
+    reserveQuery();
 
     return 1;
 }
@@ -303,8 +865,35 @@ const char* JMA_Analyzer::runWithString(const char* inStr)
     assert(inStr);
 
     strBuf_.clear();
-    SentenceToAnalyzerBuffer processor(*this, strBuf_);
-    iterateSentence(inStr, processor);
+
+    // only the lexicon and POS string are output
+    const int fields = isOutputPOS() ? MORPHEME_FIELD_POS_STR : 0;
+
+    if(getOption(OPTION_TYPE_OUTPUT_TOKEN_STREAM) != 0)
+    {
+        tokenWriter_.setFields(isOutputPOS() ? (TOKEN_STREAM_LEXICON | TOKEN_STREAM_POS_STR) : TOKEN_STREAM_LEXICON);
+        tokenWriter_.beginDocument();
+
+        // the sentences are analyzed in place, with their offsets in the whole input string
+        const unsigned int inLength = strlen(inStr);
+        scanText(inStr, inLength);
+
+        ViewToTokenStream processor(tokenWriter_);
+        TextPosition position;
+        for(SentenceSpanList::const_iterator it=sentSpans_.begin(); it!=sentSpans_.end(); ++it)
+        {
+            iterateLimitView(inStr + it->offset_, it->length_, position, fields, processor);
+            advancePosition(position, inStr + it->offset_, it->length_);
+        }
+
+        clearScan();
+        tokenWriter_.endDocument(strBuf_, inLength);
+    }
+    else
+    {
+        AnalyzerBufferSink sink(*this, strBuf_);
+        analyzeWithFields(inStr, fields, sink);
+    }
 
     return strBuf_.c_str();
 }
@@ -322,20 +911,123 @@ int JMA_Analyzer::runWithStream(const char* inFileName, const char* outFileName)
         return 0;
     }
 
-    ofstream out(outFileName);
+    const bool isTokenStream = (getOption(OPTION_TYPE_OUTPUT_TOKEN_STREAM) != 0);
+    ofstream out(outFileName, isTokenStream ? ios::out | ios::binary : ios::out);
     if(!out)
     {
         cerr<<"[Error] The output file "<<outFileName<<" could not be created!"<<endl;
         return 0;
     }
 
+#ifdef JMA_USE_STREAM_PIPELINE
+    const int workerNum = static_cast<int>(getOption(OPTION_TYPE_STREAM_WORKER_NUM));
+    if(workerNum > 1)
+        return runStreamPipeline(in, out, workerNum);
+#endif
+
     string line;
-    while(getline(in, line))
-        out << runWithString(line.c_str()) << endl;
+    if(isTokenStream)
+    {
+        // each line is a document
+        while(getline(in, line))
+        {
+            runWithString(line.c_str());
+            out.write(strBuf_.data(), strBuf_.size());
+        }
+    }
+    else
+    {
+        while(getline(in, line))
+            out << runWithString(line.c_str()) << endl;
+    }
+
+    return 1;
+}
+
+int JMA_Analyzer::prepareWorkers(unsigned int workerNum)
+{
+    // each worker has its own tagger and buffers, with the same knowledge
+    while(workers_.size() < workerNum)
+    {
+        JMA_Analyzer* worker = new JMA_Analyzer;
+        if(! worker->setKnowledge(knowledge_))
+        {
+            delete worker;
+            return 0;
+        }
+        workers_.push_back(worker);
+    }
+
+    // the plan of a worker is compiled again only if its options are changed
+    for(unsigned int i=0; i<workerNum; ++i)
+    {
+        JMA_Analyzer* worker = workers_[i];
+        for(int option=0; option<OPTION_TYPE_NUM; ++option)
+        {
+            const OptionType type = static_cast<OptionType>(option);
+            if(worker->getOption(type) != getOption(type))
+                worker->setOption(type, getOption(type));
+        }
+        worker->setPOSDelimiter(getPOSDelimiter());
+        worker->setWordDelimiter(getWordDelimiter());
+    }
 
     return 1;
 }
 
+int JMA_Analyzer::runStreamPipeline(std::istream& in, std::ostream& out, unsigned int workerNum)
+{
+#ifdef JMA_USE_STREAM_PIPELINE
+    if(! prepareWorkers(workerNum))
+        return 0;
+
+    const vector<JMA_Analyzer*> workers(workers_.begin(), workers_.begin() + workerNum);
+    StreamPipeline pipeline(workers, getOption(OPTION_TYPE_OUTPUT_TOKEN_STREAM) != 0);
+    pipeline.run(in, out);
+
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+int JMA_Analyzer::runBatch(std::vector<Sentence>& sentences, int threadNum)
+{
+    assert(knowledge_ && knowledge_->getCType() && tagger_);
+
+#ifdef JMA_USE_BATCH_SCHEDULER
+    if(threadNum > static_cast<int>(sentences.size()))
+        threadNum = sentences.size();
+
+    if(threadNum > 1)
+    {
+        if(! prepareWorkers(threadNum - 1))
+            return 0;
+
+        // this analyzer is the first worker, used in the calling thread
+        vector<JMA_Analyzer*> workers(1, this);
+        workers.insert(workers.end(), workers_.begin(), workers_.begin() + (threadNum - 1));
+
+        BatchScheduler scheduler(workers, sentences);
+        return scheduler.run();
+    }
+#endif
+
+    int result = 1;
+    for(unsigned int i=0; i<sentences.size(); ++i)
+    {
+        if(! runWithSentence(sentences[i]))
+            result = 0;
+    }
+
+    return result;
+}
+
+unsigned int JMA_Analyzer::getOutputLength() const
+{
+    return strBuf_.size();
+}
+
 void JMA_Analyzer::splitSentence(const char* paragraph, std::vector<Sentence>& sentences)
 {
     assert(knowledge_ && knowledge_->getCType());
@@ -345,85 +1037,136 @@ void JMA_Analyzer::splitSentence(const char* paragraph, std::vector<Sentence>& s
     iterateSentence(paragraph, processor);
 }
 
-void JMA_Analyzer::getFeatureStr(const char* featureList, int featureOffset, std::string& retVal) const
+void JMA_Analyzer::splitSentence(const char* paragraph, SentenceSpanList& spans) const
+{
+    assert(knowledge_ && knowledge_->getCType());
+    assert(paragraph);
+
+    knowledge_->getSentenceSplitter().split(paragraph, strlen(paragraph), spans);
+}
+
+Morpheme JMA_Analyzer::getMorpheme(const MeCab::Node* node) const
+{
+    assert(node);
+
+    MorphemeView view;
+    getMorphemeView(node, plan_.fields_, view);
+
+    Morpheme result;
+    view.toMorpheme(result);
+    return result;
+}
+
+void JMA_Analyzer::getFeatureView(const char* featureList, int featureOffset, const char*& begin, unsigned int& length) const
 {
     assert(featureList && featureOffset >= 0);
-    
+
     const char delimit = ',';
     const char* str = featureList;
-    const char* stre = featureList + strlen(featureList);
-    const char* begin = 0;
-    const char* end = 0;
-
-    const int size = featureOffset + 1; // how many ',' to find
     int count = 0; // how many ',' have been found
 
-    while(count < size && str < stre)
+    while(count < featureOffset)
     {
-        begin = str;
-        end = find(str, stre, delimit);
-        ++count; // also when 'end' reaches 'stre'
-
-        if(end == stre)
-            break;
+        str = strchr(str, delimit);
+        if(! str)
+        {
+            begin = "";
+            length = 0;
+            return;
+        }
 
-        str = end + 1;
+        ++str;
+        ++count;
     }
 
-    if(count == size)
+    const char* end = strchr(str, delimit);
+    length = end ? end - str : strlen(str);
+    begin = str;
+
+    if(length == 1 && *str == '*')
     {
-        retVal = string(begin, end - begin);
-        if(retVal == "*")
-            retVal = "";
+        begin = "";
+        length = 0;
     }
-    else
-        retVal = "";
 }
 
-Morpheme JMA_Analyzer::getMorpheme(const MeCab::Node* node) const
+void JMA_Analyzer::getMorphemeView(const MeCab::Node* node, int fields, MorphemeView& view) const
 {
     assert(node);
 
-    Morpheme result;
+    view.lexicon_ = node->surface;
+    view.lexiconLength_ = node->length;
 
-    result.lexicon_.assign(node->surface, node->length);
+    // the fields not in plan are left empty
+    view.baseForm_ = view.readForm_ = view.normForm_ = "";
+    view.baseFormLength_ = view.readFormLength_ = view.normFormLength_ = 0;
 
-    getFeatureStr(node->feature, knowledge_->getBaseFormOffset(), result.baseForm_);
-    if(result.baseForm_.empty())
-        result.baseForm_ = result.lexicon_;
+    if(fields & MORPHEME_FIELD_BASE_FORM)
+    {
+        getFeatureView(node->feature, plan_.baseFormOffset_, view.baseForm_, view.baseFormLength_);
+        if(view.baseFormLength_ == 0)
+        {
+            view.baseForm_ = view.lexicon_;
+            view.baseFormLength_ = view.lexiconLength_;
+        }
+    }
+
+    if(fields & MORPHEME_FIELD_READ_FORM)
+        getFeatureView(node->feature, plan_.readFormOffset_, view.readForm_, view.readFormLength_);
+
+    if(fields & MORPHEME_FIELD_NORM_FORM)
+    {
+        getFeatureView(node->feature, plan_.normFormOffset_, view.normForm_, view.normFormLength_);
+        if(view.normFormLength_ == 0)
+        {
+            view.normForm_ = view.lexicon_;
+            view.normFormLength_ = view.lexiconLength_;
+        }
+    }
 
-    getFeatureStr(node->feature, knowledge_->getReadFormOffset(), result.readForm_);
+    view.posCode_ = (int)node->posid;
+    view.posStr_ = (fields & MORPHEME_FIELD_POS_STR) ? posTable_->getPOS(view.posCode_, plan_.posFormat_) : "";
+    view.termId_ = tagger_->term_id(node);
+}
 
-    getFeatureStr(node->feature, knowledge_->getNormFormOffset(), result.normForm_);
-    if(result.normForm_.empty())
-        result.normForm_ = result.lexicon_;
+void JMA_Analyzer::appendView(const char*& str, unsigned int& length, const char* appendStr, unsigned int appendLength) const
+{
+    if(appendLength == 0)
+        return;
 
-    result.posCode_ = (int)node->posid;
-    result.posStr_ = posTable_->getPOS(result.posCode_, getPOSFormat());
+    if(length == 0)
+    {
+        str = appendStr;
+        length = appendLength;
+        return;
+    }
 
-    return result;
+    if(str + length == appendStr)
+    {
+        length += appendLength;
+        return;
+    }
+
+    char* buf = arena_.alloc(length + appendLength);
+    memcpy(buf, str, length);
+    memcpy(buf + length, appendStr, appendLength);
+    str = buf;
+    length += appendLength;
 }
 
-MeCab::Node* JMA_Analyzer::combineNode(MeCab::Node* startNode, Morpheme& result) const
+MeCab::Node* JMA_Analyzer::combineNode(MeCab::Node* startNode, const RuleNode* ruleNode, int fields, MorphemeView& result) const
 {
     assert(startNode && startNode->next && "it is invalid to combine NULL or EOS node");
 
-    result = getMorpheme(startNode);
-
-    // check option
-    if(! isCombineCompound())
-        return startNode;
+    getMorphemeView(startNode, fields, result);
 
     MeCab::Node* node = startNode;
-    int startPOS = (int)node->posid;
-    while(node->next)
+    MorphemeView morp;
+    for(; ruleNode; ruleNode = node->next ? posTable_->getCombineRule(result.posCode_, node->next) : 0)
     {
-        const RuleNode* ruleNode = posTable_->getCombineRule(startPOS, node->next);
-        if(! ruleNode)
-            break;
 
 #if JMA_DEBUG_PRINT_COMBINE
-        cerr << result.lexicon_ << "/" << result.posStr_;
+        cerr << string(result.lexicon_, result.lexiconLength_) << "/" << result.posStr_;
 #endif
 
         // start from next node
@@ -432,22 +1175,31 @@ MeCab::Node* JMA_Analyzer::combineNode(MeCab::Node* startNode, Morpheme& result)
             node = node->next;
             assert(node->next && "the node should not be end-of-sentence node.");
 
-            Morpheme morp = getMorpheme(node);
+            getMorphemeView(node, fields, morp);
 #if JMA_DEBUG_PRINT_COMBINE
-            cerr << "\t+\t" << morp.lexicon_ << "/" << morp.posStr_;
+            cerr << "\t+\t" << string(morp.lexicon_, morp.lexiconLength_) << "/" << morp.posStr_;
 #endif
-            result.baseForm_ = result.lexicon_ + morp.baseForm_; // combined base form = previous lexicon + last base form
-            result.lexicon_ += morp.lexicon_;
-            result.readForm_ += morp.readForm_;
-            result.normForm_ += morp.normForm_;
+            // combined base form = previous lexicon + last base form
+            if(fields & MORPHEME_FIELD_BASE_FORM)
+            {
+                result.baseForm_ = result.lexicon_;
+                result.baseFormLength_ = result.lexiconLength_;
+                appendView(result.baseForm_, result.baseFormLength_, morp.baseForm_, morp.baseFormLength_);
+            }
+
+            appendView(result.lexicon_, result.lexiconLength_, morp.lexicon_, morp.lexiconLength_);
+            appendView(result.readForm_, result.readFormLength_, morp.readForm_, morp.readFormLength_);
+            appendView(result.normForm_, result.normFormLength_, morp.normForm_, morp.normFormLength_);
         }
 
         result.posCode_ = ruleNode->target_;
-        result.posStr_ = posTable_->getPOS(result.posCode_, getPOSFormat());
-        startPOS = result.posCode_; // to match rules from this combined result
+        if(fields & MORPHEME_FIELD_POS_STR)
+            result.posStr_ = posTable_->getPOS(result.posCode_, plan_.posFormat_);
+        result.termId_ = -1; // compound word is not in dictionary
+        // to match rules from this combined result in the next loop
 
 #if JMA_DEBUG_PRINT_COMBINE
-        cerr << "\t=>\t" << result.lexicon_ << "/" << result.posStr_ << endl;
+        cerr << "\t=>\t" << string(result.lexicon_, result.lexiconLength_) << "/" << result.posStr_ << endl;
 #endif
     }
 
@@ -455,39 +1207,166 @@ MeCab::Node* JMA_Analyzer::combineNode(MeCab::Node* startNode, Morpheme& result)
 }
 
 template<class MorphemeProcessor>
-void JMA_Analyzer::iterateNode(const MeCab::Node* bosNode, MorphemeProcessor& processor) const
+void JMA_Analyzer::iterateNode(const MeCab::Node* bosNode, const TextPosition& position, MorphemeProcessor& processor) const
 {
-    Morpheme morp;
-    bool isDecompose = isDecomposeUserNound();
-    JMA_Knowledge::DecompMap::const_iterator iter;
-    for(MeCab::Node *node = bosNode->next; node->next; node=node->next)
+    // the views are converted to morphemes at once
+    arena_.free();
+
+    ViewToMorpheme<MorphemeProcessor> viewProcessor(processor);
+    iterateNodeView(bosNode, position, plan_.fields_, viewProcessor);
+}
+
+template<class ViewProcessor>
+void JMA_Analyzer::decomposeView(const MorphemeView& view, const char* begin, unsigned int compound, int fields, ViewProcessor& processor) const
+{
+    assert(compound > 0 && compound < decompTable_->offsets_.size());
+
+    const bool isReadForm = (fields & MORPHEME_FIELD_READ_FORM);
+    const char* const end = begin + view.byteLength_;
+    MorphemeView decomp;
+
+    // decompose into morpheme list
+    const MorphemeList& morphList = decompTable_->morphemes_;
+    const MorphemeList::const_iterator morphEnd = morphList.begin() + decompTable_->offsets_[compound];
+    OffsetCounter decompCounter(knowledge_->getCType(), getScanLengths(begin, view.byteLength_), begin, view.charOffset_);
+    const char* part = begin;
+    for(MorphemeList::const_iterator miter = morphList.begin() + decompTable_->offsets_[compound-1]; miter!=morphEnd; ++miter)
     {
-        node = combineNode(node, morp);
+        // each part is in its range within user noun,
+        // or in the whole range if it is not a substring as expected
+        const unsigned int partLength = miter->lexicon_.length();
+        if(part + partLength <= end && ! miter->lexicon_.compare(0, partLength, part, partLength))
+        {
+            decomp.byteOffset_ = view.byteOffset_ + (part - begin);
+            decomp.byteLength_ = partLength;
+            decomp.charOffset_ = decompCounter.moveTo(part);
+            decomp.charLength_ = decompCounter.moveTo(part + partLength) - decomp.charOffset_;
+            part += partLength;
+        }
+        else
+        {
+            decomp.byteOffset_ = view.byteOffset_;
+            decomp.byteLength_ = view.byteLength_;
+            decomp.charOffset_ = view.charOffset_;
+            decomp.charLength_ = view.charLength_;
+        }
+
+        decomp.lexicon_ = miter->lexicon_.c_str();
+        decomp.lexiconLength_ = miter->lexicon_.length();
+        decomp.readForm_ = isReadForm ? miter->readForm_.c_str() : "";
+        decomp.readFormLength_ = isReadForm ? miter->readForm_.length() : 0;
+        decomp.posCode_ = miter->posCode_;
+        decomp.posStr_ = miter->posStr_.c_str();
+        decomp.termId_ = -1; // decomposed noun is not in dictionary
+        if(isFilter(decomp))
+            continue;
+
+        // no variant for user noun
+        decomp.baseForm_ = (fields & MORPHEME_FIELD_BASE_FORM) ? decomp.lexicon_ : "";
+        decomp.baseFormLength_ = (fields & MORPHEME_FIELD_BASE_FORM) ? decomp.lexiconLength_ : 0;
+        decomp.normForm_ = (fields & MORPHEME_FIELD_NORM_FORM) ? decomp.lexicon_ : "";
+        decomp.normFormLength_ = (fields & MORPHEME_FIELD_NORM_FORM) ? decomp.lexiconLength_ : 0;
+        decomp.posCode_ = view.posCode_; // index of POS user noun
+        decomp.posStr_ = view.posStr_; // string of POS user noun
+        processor.process(decomp);
+    }
+}
+
+template<class ViewProcessor>
+void JMA_Analyzer::iterateFineView(const MeCab::Node* first, const MeCab::Node* last, const MorphemeView& compoundView, int fields, ViewProcessor& processor) const
+{
+    const unsigned int decompSize = decompTable_->offsets_.size();
+    OffsetCounter counter(knowledge_->getCType(), getScanLengths(first->surface, compoundView.byteLength_), first->surface, compoundView.charOffset_);
+    MorphemeView view;
+
+    for(const MeCab::Node* node = first; ; node = node->next)
+    {
+        getMorphemeView(node, fields, view);
+        view.byteOffset_ = compoundView.byteOffset_ + (node->surface - first->surface);
+        view.byteLength_ = node->length;
+        view.charOffset_ = counter.moveTo(node->surface);
+        view.charLength_ = counter.moveTo(node->surface + node->length) - view.charOffset_;
+
+        if(node->token && node->token->compound && node->token->compound < decompSize)
+            decomposeView(view, node->surface, node->token->compound, fields, processor);
+        else if(! isFilter(view))
+            processor.process(view);
+
+        if(node == last)
+            break;
+    }
+}
+
+template<class ViewProcessor>
+void JMA_Analyzer::iterateNodeView(const MeCab::Node* bosNode, const TextPosition& position, int fields, ViewProcessor& processor) const
+{
+    // both combination and decomposition are needed in hierarchy
+    typedef HierarchyTrait<ViewProcessor> Hierarchy;
+    const bool isHierarchy = Hierarchy::IS_HIERARCHY;
+    const bool isCombine = plan_.isCombine_ || isHierarchy;
+    const bool isDecompose = plan_.isDecompose_ || isHierarchy;
+
+    MorphemeView view;
+    const unsigned int decompSize = decompTable_->offsets_.size();
+    const char* const bosStr = bosNode->surface;
+    OffsetCounter counter(knowledge_->getCType(), getScanLengths(bosStr, 0), bosStr, position.charOffset_);
+    ViewToFine<ViewProcessor> fineProcessor(processor);
 
-        if(isDecompose
-                && morp.posCode_ == knowledge_->getUserNounPOSIndex()
-                && (iter = decompMap_->find(morp.lexicon_)) != decompMap_->end())
+    if(stopTermRevision_ != knowledge_->getStopWordRevision())
+        compileStopTerms();
+
+    for(MeCab::Node *node = bosNode->next; node->next; node=node->next)
+    {
+        // the compound word is in the range from its first to last node
+        MeCab::Node* const first = node;
+        const char* begin = node->surface;
+        bool isChecked = false;
+        const RuleNode* ruleNode = isCombine ? posTable_->getCombineRule(node->posid, node->next) : 0;
+
+        // the user noun to decompose has its index in decomposition table
+        unsigned int compound = 0;
+        if(isDecompose && ! ruleNode && node->token && node->token->compound < decompSize)
+            compound = node->token->compound;
+
+        if(! ruleNode && ! compound)
         {
-            // decompose into morpheme list
-            const MorphemeList& morphList = iter->second;
-            for(MorphemeList::const_iterator miter = morphList.begin(); miter!=morphList.end(); ++miter)
-            {
-                if(isFilter(*miter))
-                    continue;
+            // the single node is filtered before its fields are extracted
+            if(isFilter(node->posid, (knowledge_->stopWordCount() ? tagger_->term_id(node) : -1), node->surface, node->length))
+                continue;
 
-                Morpheme decomp(*miter);
-                decomp.baseForm_ = decomp.normForm_ = decomp.lexicon_; // no variant for user noun
-                decomp.posCode_ = morp.posCode_; // index of POS user noun
-                decomp.posStr_ = morp.posStr_; // string of POS user noun
-                processor.process(decomp);
-            }
+            getMorphemeView(node, fields, view);
+            isChecked = true;
         }
         else
+            node = combineNode(node, ruleNode, fields, view);
+        const char* end = node->surface + node->length;
+
+        view.byteOffset_ = position.byteOffset_ + (begin - bosStr);
+        view.byteLength_ = end - begin;
+        view.charOffset_ = counter.moveTo(begin);
+        view.charLength_ = counter.moveTo(end) - view.charOffset_;
+
+        if(isHierarchy)
         {
-            if(isFilter(morp))
+            // the coarse-grained morpheme is followed by its fine-grained children
+            const bool isCoarse = isChecked || ! isFilter(view);
+            Hierarchy::beginCoarse(processor, isCoarse ? &view : 0);
+
+            if(ruleNode)
+                iterateFineView(first, node, view, fields, fineProcessor);
+            else if(compound)
+                decomposeView(view, begin, compound, fields, fineProcessor);
+            else if(isCoarse)
+                Hierarchy::processFine(processor, view);
+        }
+        else if(compound)
+            decomposeView(view, begin, compound, fields, processor);
+        else
+        {
+            if(! isChecked && isFilter(view))
                 continue;
 
-            processor.process(morp);
+            processor.process(view);
         }
     }
 }
@@ -497,58 +1376,61 @@ std::string JMA_Analyzer::convertCharacters(const char* str) const
     assert(knowledge_ && knowledge_->getCType());
     assert(str);
 
+    if(converter_.empty())
+        return str;
+
     string result;
-    CTypeTokenizer tokenizer(knowledge_->getCType());
-    tokenizer.assign(str);
+    converter_.convert(str, result);
+    return result;
+}
 
-    for(const char* p=tokenizer.next(); p; p=tokenizer.next())
+bool JMA_Analyzer::isFilter(const MorphemeView& view) const
+{
+    return isFilter(view.posCode_, view.termId_, view.lexicon_, view.lexiconLength_);
+}
+
+bool JMA_Analyzer::isFilter(int posCode, int termId, const char* lexicon, unsigned int length) const
+{
+    // in the order of cheaper check first
+    if(! knowledge_->isKeywordPOS(posCode))
+        return true;
+
+    if(knowledge_->stopWordCount())
     {
-        const char* q;
-        if(getOption(OPTION_TYPE_CONVERT_TO_HIRAGANA) != 0)
-        {
-            if((q = kanaTable_->toLeft(p)) != NULL)
-                p = q;
-        }
-        if(getOption(OPTION_TYPE_CONVERT_TO_KATAKANA) != 0)
-        {
-            if((q = kanaTable_->toRight(p)) != NULL)
-                p = q;
-        }
-        if(getOption(OPTION_TYPE_CONVERT_TO_HALF_WIDTH) != 0)
+        // the surface of dictionary term is checked by flag
+        if(termId >= 0)
         {
-            if((q = widthTable_->toLeft(p)) != NULL)
-                p = q;
+            if(termId < static_cast<int>(stopTermFlags_.size()) && stopTermFlags_[termId])
+                return true;
         }
-        if(getOption(OPTION_TYPE_CONVERT_TO_FULL_WIDTH) != 0)
-        {
-            if((q = widthTable_->toRight(p)) != NULL)
-                p = q;
-        }
-        if(getOption(OPTION_TYPE_CONVERT_TO_LOWER_CASE) != 0)
-        {
-            if((q = caseTable_->toLeft(p)) != NULL)
-                p = q;
-        }
-        if(getOption(OPTION_TYPE_CONVERT_TO_UPPER_CASE) != 0)
-        {
-            if((q = caseTable_->toRight(p)) != NULL)
-                p = q;
-        }
-
-        result += p;
+        else if(knowledge_->isStopWord(keyBuf_.assign(lexicon, length)))
+            return true;
     }
 
-    return result;
+    if(length && knowledge_->getCType()->isSpace(lexicon))
+        return true;
+
+    return false;
 }
 
-bool JMA_Analyzer::isFilter(const Morpheme& morph) const
+void JMA_Analyzer::compileStopTerms() const
 {
-    if(knowledge_->getCType()->isSpace(morph.lexicon_.c_str())
-            || knowledge_->isStopWord(morph.lexicon_)
-            || ! knowledge_->isKeywordPOS(morph.posCode_))
-        return true;
+    stopTermFlags_.clear();
+    stopTermRevision_ = knowledge_->getStopWordRevision();
 
-    return false;
+    const set<string>& stopWords = knowledge_->getStopWords();
+    vector<int> termIds;
+    for(set<string>::const_iterator it=stopWords.begin(); it!=stopWords.end(); ++it)
+    {
+        termIds.clear();
+        tagger_->term_ids(it->c_str(), &termIds);
+        for(vector<int>::const_iterator idIt=termIds.begin(); idIt!=termIds.end(); ++idIt)
+        {
+            if(*idIt >= static_cast<int>(stopTermFlags_.size()))
+                stopTermFlags_.resize(*idIt + 1, false);
+            stopTermFlags_[*idIt] = true;
+        }
+    }
 }
 
 template<class SentenceProcessor>
@@ -556,53 +1438,103 @@ void JMA_Analyzer::iterateSentence(const char* paragraph, SentenceProcessor& pro
 {
     assert(paragraph);
 
+    SentenceSpanList spans;
+    splitSentence(paragraph, spans);
+
     string sentenceStr;
-    CTypeTokenizer tokenizer(knowledge_->getCType());
-    tokenizer.assign(paragraph);
+    for(SentenceSpanList::const_iterator it=spans.begin(); it!=spans.end(); ++it)
+    {
+        sentenceStr.assign(paragraph + it->offset_, it->length_);
+        processor.process(sentenceStr.c_str());
+    }
+}
 
+void JMA_Analyzer::splitLimitSize(const char* str, std::vector<std::string>& limitStrVec, unsigned int limitSize) const
+{
+    string limitStr;
+    CTypeTokenizer tokenizer(knowledge_->getCType());
+    tokenizer.assign(str);
     for(const char* p=tokenizer.next(); p; p=tokenizer.next())
     {
-        sentenceStr += p;
-
-        if(knowledge_->isSentenceSeparator(p))
+        if(limitStr.length() + strlen(p) >= limitSize)
         {
-            processor.process(sentenceStr.c_str());
-            sentenceStr.clear();
+            limitStrVec.push_back(limitStr);
+            limitStr.clear();
         }
+
+        limitStr += p;
     }
 
-    // in case the last character is not sentence separator
-    if(! sentenceStr.empty())
+    // the rest characters
+    if(! limitStr.empty())
     {
-        processor.process(sentenceStr.c_str());
-        sentenceStr.clear();
+        limitStrVec.push_back(limitStr);
+        limitStr.clear();
     }
+
+    assert(validateSplitLimitResult(str, limitStrVec, limitSize));
 }
 
-void JMA_Analyzer::splitLimitSize(const char* str, std::vector<std::string>& limitStrVec, unsigned int limitSize) const
+void JMA_Analyzer::splitLimitOffset(const char* str, unsigned int length, std::vector<unsigned int>& limitEnds, unsigned int limitSize) const
 {
-    string limitStr;
-    CTypeTokenizer tokenizer(knowledge_->getCType());
-    tokenizer.assign(str);
-    for(const char* p=tokenizer.next(); p; p=tokenizer.next())
+    const JMA_CType* ctype = knowledge_->getCType();
+    const unsigned char* lengths = getScanLengths(str, length);
+    unsigned int start = 0;
+    unsigned int end = 0;
+    while(end < length)
     {
-        if(limitStr.length() + strlen(p) >= limitSize)
+        unsigned int len = lengths ? lengths[end] : ctype->getByteCount(str + end);
+        if(len == 0 || len > length - end)
+            len = length - end;
+
+        if(end - start + len >= limitSize)
         {
-            limitStrVec.push_back(limitStr);
-            limitStr.clear();
+            limitEnds.push_back(end);
+            start = end;
         }
 
-        limitStr += p;
+        end += len;
     }
 
     // the rest characters
-    if(! limitStr.empty())
-    {
-        limitStrVec.push_back(limitStr);
-        limitStr.clear();
-    }
+    if(end > start)
+        limitEnds.push_back(end);
+}
 
-    assert(validateSplitLimitResult(str, limitStrVec, limitSize));
+void JMA_Analyzer::scanText(const char* text, unsigned int length)
+{
+    assert(text);
+
+    // the only pass to decode the characters, as the separators in self-synchronizing encoding are matched in bytes
+    scanBegin_ = text;
+    scanEnd_ = text + length;
+    scanLengths_ = tagger_->scan_chars(text, length);
+
+    sentSpans_.clear();
+    knowledge_->getSentenceSplitter().split(text, length, sentSpans_, scanLengths_);
+}
+
+void JMA_Analyzer::clearScan()
+{
+    tagger_->clear_chars();
+    scanBegin_ = scanEnd_ = 0;
+    scanLengths_ = 0;
+}
+
+const unsigned char* JMA_Analyzer::getScanLengths(const char* str, unsigned int length) const
+{
+    if(! scanLengths_ || str < scanBegin_ || str >= scanEnd_ || length > static_cast<unsigned int>(scanEnd_ - str))
+        return 0;
+
+    const unsigned char* lengths = scanLengths_ + (str - scanBegin_);
+    return *lengths ? lengths : 0;
+}
+
+void JMA_Analyzer::advancePosition(TextPosition& position, const char* str, unsigned int length) const
+{
+    OffsetCounter counter(knowledge_->getCType(), getScanLengths(str, length), str, position.charOffset_);
+    position.charOffset_ = counter.moveTo(str + length);
+    position.byteOffset_ += length;
 }
 
 bool JMA_Analyzer::validateSplitLimitResult(const char* str, const std::vector<std::string>& limitStrVec, unsigned int limitSize) const
@@ -639,6 +1571,14 @@ int JMA_Analyzer::getCodeFromStr(const std::string& posStr) const
     return posTable_->getIndexFromAlphaPOS(posStr);
 }
 
+const MeCab::Node* JMA_Analyzer::parseOneBest(const char* str, unsigned int length) const
+{
+    if(plan_.isLongestMatch_)
+        return tagger_->parseToNodeLongest(str, length);
+
+    return tagger_->parseToNode(str, length);
+}
+
 void JMA_Analyzer::runOneBest(Sentence& sentence) const
 {
     vector<string> limitStrVec;
@@ -647,10 +1587,12 @@ void JMA_Analyzer::runOneBest(Sentence& sentence) const
     MorphemeList list;
     MorphemeToList processor(list);
 
+    TextPosition position;
     for(vector<string>::const_iterator it=limitStrVec.begin(); it!=limitStrVec.end(); ++it)
     {
-        const MeCab::Node* bosNode = tagger_->parseToNode(it->c_str());
-        iterateNode(bosNode, processor);
+        const MeCab::Node* bosNode = parseOneBest(it->c_str(), it->length());
+        iterateNode(bosNode, position, processor);
+        advancePosition(position, it->c_str(), it->length());
     }
 
     // ignore empty result
@@ -672,13 +1614,11 @@ bool JMA_Analyzer::runNBest(Sentence& sentence, int nbest) const
     vector<MorphemeList> totalNBestVec;
     vector<double> totalScoreVec;
 
+    TextPosition position;
     for(vector<string>::const_iterator it=limitStrVec.begin(); it!=limitStrVec.end(); ++it)
     {
-        if(!tagger_->parseNBestInit(it->c_str()))
-        {
-            cerr << "error: fail to init nbest analyze on string: " << *it << endl;
+        if(! initNBest(it->c_str()))
             return false;
-        }
 
         // nbest result for each buffer
         vector<MorphemeList> limitNBestVec;
@@ -693,7 +1633,7 @@ bool JMA_Analyzer::runNBest(Sentence& sentence, int nbest) const
 
             MorphemeList list;
             MorphemeToList processor(list);
-            iterateNode(bosNode, processor);
+            iterateNode(bosNode, position, processor);
 
             // ignore empty result
             if(list.empty())
@@ -728,6 +1668,7 @@ bool JMA_Analyzer::runNBest(Sentence& sentence, int nbest) const
             limitScoreVec.push_back(dScore);
         }
         assert(limitNBestVec.size() == limitScoreVec.size() && "the size of nbest and score limit results should be equal");
+        advancePosition(position, it->c_str(), it->length());
 
         // ignore empty nbest limit results
         if(limitNBestVec.empty())
@@ -782,4 +1723,512 @@ bool JMA_Analyzer::runNBest(Sentence& sentence, int nbest) const
     return true;
 }
 
+NBestCursor JMA_Analyzer::beginNBest(const char* sentence)
+{
+    assert(knowledge_ && knowledge_->getCType() && tagger_);
+    assert(sentence);
+
+    NBestCursor cursor;
+    cursor.analyzer_ = this;
+    cursor.isEnd_ = false;
+
+    vector<string> limitStrVec;
+    splitLimitSize(sentence, limitStrVec, LIMIT_PARSE_LENGTH);
+
+    if(limitStrVec.empty())
+    {
+        cursor.isEnd_ = true;
+    }
+    else if(limitStrVec.size() > 1)
+    {
+        // the one-best candidate is analyzed in nextNBest()
+        cursor.isOneBest_ = true;
+        nbestStr_ = sentence;
+    }
+    else
+    {
+        // keep the string until the cursor is iterated, as the nodes refer to it
+        nbestStr_.swap(limitStrVec.front());
+        if(! initNBest(nbestStr_.c_str()))
+            cursor.isEnd_ = true;
+    }
+
+    return cursor;
+}
+
+bool JMA_Analyzer::nextNBest(NBestCursor& cursor) const
+{
+    assert(cursor.analyzer_ == this);
+
+    if(cursor.isOneBest_)
+    {
+        if(! cursor.candidates_.empty())
+            return false;
+
+        vector<string> limitStrVec;
+        splitLimitSize(nbestStr_.c_str(), limitStrVec, LIMIT_PARSE_LENGTH);
+
+        MorphemeList list;
+        MorphemeToList processor(list);
+        long cost = 0;
+
+        TextPosition position;
+        for(vector<string>::const_iterator it=limitStrVec.begin(); it!=limitStrVec.end(); ++it)
+        {
+            const MeCab::Node* node = tagger_->parseToNode(it->c_str());
+            iterateNode(node, position, processor);
+            advancePosition(position, it->c_str(), it->length());
+
+            // the cost of end-of-sentence node is the cost of the whole path
+            while(node->next)
+                node = node->next;
+            cost += node->cost;
+        }
+
+        // ignore empty result
+        if(list.empty())
+            return false;
+
+        cursor.candidates_.push_back(MorphemeList());
+        cursor.candidates_.back().swap(list);
+        cursor.costs_.push_back(cost);
+        return true;
+    }
+
+    bool isPOS = isOutputPOS();
+    // j to count steps to avoid iterating forever
+    for(int j=0; j<NBEST_LIMIT_SCALE_FACTOR; ++j)
+    {
+        const MeCab::Node* bosNode = tagger_->nextNode();
+        if(! bosNode)
+            break;
+
+        MorphemeList list;
+        MorphemeToList processor(list);
+        iterateNode(bosNode, TextPosition(), processor);
+
+        // ignore empty result
+        if(list.empty())
+            continue;
+
+        bool isDupl = false;
+        // check the current result with previous results
+        for(vector<MorphemeList>::const_reverse_iterator rit=cursor.candidates_.rbegin(); rit<cursor.candidates_.rend(); ++rit)
+        {
+            if(isSameMorphemeList(&*rit, &list, isPOS))
+            {
+                isDupl = true;
+                break;
+            }
+        }
+        // ignore the duplicate results
+        if(isDupl)
+            continue;
+
+        cursor.candidates_.push_back(MorphemeList());
+        cursor.candidates_.back().swap(list);
+        cursor.costs_.push_back(tagger_->nextScore());
+        return true;
+    }
+
+    return false;
+}
+
+template<class ViewProcessor>
+void JMA_Analyzer::iterateLimitView(const char* sentence, unsigned int length, const TextPosition& start, int fields, ViewProcessor& processor)
+{
+    if(plan_.isNormalize_ && ! converter_.empty())
+    {
+        normStr_.clear();
+        converter_.convert(sentence, length, normStr_, &offsetMap_);
+
+        ViewToOriginal<ViewProcessor> originalProcessor(offsetMap_, start.byteOffset_, start.charOffset_, processor);
+        parseLimitView(normStr_.c_str(), normStr_.size(), TextPosition(), fields, originalProcessor);
+    }
+    else
+        parseLimitView(sentence, length, start, fields, processor);
+}
+
+template<class ViewProcessor>
+void JMA_Analyzer::parseLimitView(const char* sentence, unsigned int length, const TextPosition& start, int fields, ViewProcessor& processor)
+{
+    arena_.free();
+
+    limitEnds_.clear();
+    splitLimitOffset(sentence, length, limitEnds_, LIMIT_PARSE_LENGTH);
+
+    TextPosition position = start;
+    unsigned int begin = 0;
+    for(vector<unsigned int>::const_iterator it=limitEnds_.begin(); it!=limitEnds_.end(); ++it)
+    {
+        const MeCab::Node* bosNode = parseOneBest(sentence + begin, *it - begin);
+        iterateNodeView(bosNode, position, fields, processor);
+        advancePosition(position, sentence + begin, *it - begin);
+        begin = *it;
+    }
+}
+
+const MorphemeViewList& JMA_Analyzer::runWithView(const char* sentence)
+{
+    assert(knowledge_ && knowledge_->getCType() && tagger_);
+    assert(sentence);
+
+    viewList_.clear();
+
+    ViewToList processor(viewList_);
+    iterateLimitView(sentence, strlen(sentence), TextPosition(), plan_.fields_, processor);
+
+    return viewList_;
+}
+
+void JMA_Analyzer::runWithColumns(const char* sentence, MorphemeColumns& columns)
+{
+    assert(knowledge_ && knowledge_->getCType() && tagger_);
+    assert(sentence);
+
+    columns.clear();
+
+    ViewToColumns processor(columns);
+    iterateLimitView(sentence, strlen(sentence), TextPosition(), plan_.fields_, processor);
+}
+
+void JMA_Analyzer::runWithHierarchy(const char* sentence, MorphemeHierarchy& hierarchy)
+{
+    assert(knowledge_ && knowledge_->getCType() && tagger_);
+    assert(sentence);
+
+    hierarchy.clear();
+
+    ViewToHierarchy processor(hierarchy);
+    iterateLimitView(sentence, strlen(sentence), TextPosition(), plan_.fields_, processor);
+}
+
+void JMA_Analyzer::setQueryProfile(unsigned int maxLength)
+{
+    queryLength_ = maxLength;
+    reserveQuery();
+}
+
+void JMA_Analyzer::reserveQuery()
+{
+    if(! queryLength_ || ! tagger_)
+        return;
+
+    tagger_->reserve(queryLength_ * MAX_CONVERT_EXPANSION);
+
+    normStr_.reserve(queryLength_ * MAX_CONVERT_EXPANSION);
+    offsetMap_.reserve(queryLength_);
+    limitEnds_.reserve(1);
+
+    // the first chunk is kept after free()
+    arena_.alloc(queryLength_ * MAX_CONVERT_EXPANSION);
+    arena_.free();
+}
+
+void JMA_Analyzer::runWithQuery(const char* query, QueryResult& result)
+{
+    assert(knowledge_ && knowledge_->getCType() && tagger_);
+    assert(query);
+
+    result.clear();
+
+    // the paths for n-best are not connected
+    tagger_->set_lattice_level(0);
+
+    ViewToQuery processor(result);
+    iterateLimitView(query, strlen(query), TextPosition(), plan_.fields_, processor);
+
+    tagger_->set_lattice_level(1);
+}
+
+void JMA_Analyzer::analyze(const char* text, MorphemeSink& sink)
+{
+    analyzeWithFields(text, plan_.fields_, sink);
+}
+
+void JMA_Analyzer::analyzeWithFields(const char* text, int fields, MorphemeSink& sink)
+{
+    assert(knowledge_ && knowledge_->getCType() && tagger_);
+    assert(text);
+
+    scanText(text, strlen(text));
+
+    ViewToSink processor(sink);
+    for(SentenceSpanList::const_iterator it=sentSpans_.begin(); it!=sentSpans_.end(); ++it)
+    {
+        // the sink is given a copy of sentence, while the sentence is analyzed in place
+        sentenceStr_.assign(text + it->offset_, it->length_);
+        sink.beginSentence(sentenceStr_.c_str());
+        iterateLimitView(text + it->offset_, it->length_, TextPosition(), fields, processor);
+        sink.endSentence();
+    }
+
+    clearScan();
+}
+
+void JMA_Analyzer::runWithTermFrequency(const char* text, TermFrequency& table)
+{
+    assert(knowledge_ && knowledge_->getCType() && tagger_);
+    assert(text);
+
+    table.clear();
+
+    // only the field used as key is extracted
+    const int fields = (table.getKeyType() == TermFrequency::KEY_BASE_FORM) ? MORPHEME_FIELD_BASE_FORM : 0;
+
+    scanText(text, strlen(text));
+
+    ViewToTermFrequency processor(table);
+    for(SentenceSpanList::const_iterator it=sentSpans_.begin(); it!=sentSpans_.end(); ++it)
+        iterateLimitView(text + it->offset_, it->length_, TextPosition(), fields, processor);
+
+    clearScan();
+}
+
+void JMA_Analyzer::runWithSegment(const char* text, std::vector<unsigned int>& offsets)
+{
+    assert(knowledge_ && knowledge_->getCType() && tagger_);
+    assert(text);
+
+    offsets.clear();
+
+    // no field is extracted, and the paths for n-best are not connected
+    tagger_->set_lattice_level(0);
+
+    scanText(text, strlen(text));
+
+    // only the byte offsets in text are needed, the character offsets are left relative to each sentence
+    ViewToSegment processor(offsets);
+    TextPosition position;
+    for(SentenceSpanList::const_iterator it=sentSpans_.begin(); it!=sentSpans_.end(); ++it)
+    {
+        position.byteOffset_ = it->offset_;
+        iterateLimitView(text + it->offset_, it->length_, position, 0, processor);
+    }
+
+    clearScan();
+    tagger_->set_lattice_level(1);
+}
+
+void JMA_Analyzer::runWithSegment(const char* text, std::string& surfaces)
+{
+    runWithSegment(text, segmentOffsets_);
+
+    const char* wordDelim = getWordDelimiter();
+    for(unsigned int i=0; i<segmentOffsets_.size(); i+=2)
+    {
+        surfaces.append(text + segmentOffsets_[i], segmentOffsets_[i+1] - segmentOffsets_[i]);
+        surfaces += wordDelim;
+    }
+}
+
+void JMA_Analyzer::analyzeSentence(const char* sentence, MorphemeSink& sink)
+{
+    assert(knowledge_ && knowledge_->getCType() && tagger_);
+    assert(sentence);
+
+    ViewToSink processor(sink);
+    iterateLimitView(sentence, strlen(sentence), TextPosition(), plan_.fields_, processor);
+}
+
+bool JMA_Analyzer::runGraph(const char* sentence, MorphemeGraph& graph, long costMargin) const
+{
+    assert(knowledge_ && knowledge_->getCType() && tagger_);
+    assert(sentence);
+
+    graph.clear();
+    if(costMargin < 0)
+        costMargin = 0;
+
+    vector<string> limitStrVec;
+    splitLimitSize(sentence, limitStrVec, LIMIT_PARSE_LENGTH);
+
+    TextPosition position;
+    // edges to end of sentence in the previous string,
+    // which are connected to the nodes from begin of sentence in the current string
+    vector<MorphemeGraph::Edge> prevEndEdges;
+    for(vector<string>::const_iterator it=limitStrVec.begin(); it!=limitStrVec.end(); ++it)
+    {
+        const MeCab::Node* bosNode = tagger_->parseToNode(it->c_str());
+        if(! bosNode)
+        {
+            cerr << "error: fail to analyze string: " << *it << endl;
+            return false;
+        }
+
+        const unsigned int edgeStart = graph.edges_.size();
+        appendLattice(bosNode, costMargin, position, graph);
+        advancePosition(position, it->c_str(), it->length());
+
+        vector<MorphemeGraph::Edge> limitEdges(graph.edges_.begin() + edgeStart, graph.edges_.end());
+        graph.edges_.resize(edgeStart);
+
+        const bool isFirst = (it == limitStrVec.begin());
+        const bool isLast = (it + 1 == limitStrVec.end());
+        vector<MorphemeGraph::Edge> endEdges;
+        for(unsigned int i=0; i<limitEdges.size(); ++i)
+        {
+            vector<MorphemeGraph::Edge> joints;
+            if(! isFirst && limitEdges[i].from_ == MorphemeGraph::BOS_INDEX)
+            {
+                for(unsigned int j=0; j<prevEndEdges.size(); ++j)
+                {
+                    MorphemeGraph::Edge joint = limitEdges[i];
+                    joint.from_ = prevEndEdges[j].from_;
+                    joint.isBest_ = joint.isBest_ && prevEndEdges[j].isBest_;
+                    joints.push_back(joint);
+                }
+            }
+            else
+                joints.push_back(limitEdges[i]);
+
+            for(unsigned int j=0; j<joints.size(); ++j)
+            {
+                if(! isLast && joints[j].to_ == MorphemeGraph::EOS_INDEX)
+                    endEdges.push_back(joints[j]);
+                else
+                    graph.edges_.push_back(joints[j]);
+            }
+        }
+        prevEndEdges.swap(endEdges);
+    }
+
+    return true;
+}
+
+void JMA_Analyzer::appendLattice(const MeCab::Node* bosNode, long costMargin, const TextPosition& position, MorphemeGraph& graph) const
+{
+    assert(bosNode && bosNode->begin_node_list);
+
+    const long INFINITE_COST = numeric_limits<long>::max();
+    const unsigned int len = bosNode->sentence_length;
+    MeCab::Node** beginNodeList = bosNode->begin_node_list;
+    const MeCab::Node* eosNode = beginNodeList[len];
+    assert(eosNode && eosNode->stat == MECAB_EOS_NODE && "the last node in lattice should be end-of-sentence node");
+
+    // the node id of end-of-sentence node is the maximum one
+    const unsigned int nodeCount = eosNode->id + 1;
+
+    // the minimum cost from each node to end-of-sentence node
+    vector<long> backCosts(nodeCount, INFINITE_COST);
+    backCosts[eosNode->id] = 0;
+    for(long pos=static_cast<long>(len)-1; pos>=0; --pos)
+    {
+        for(const MeCab::Node* node=beginNodeList[pos]; node; node=node->bnext)
+        {
+            long& backCost = backCosts[node->id];
+            for(const MeCab::Path* path=node->rpath; path; path=path->rnext)
+            {
+                const long rightCost = backCosts[path->rnode->id];
+                if(rightCost != INFINITE_COST && path->cost + rightCost < backCost)
+                    backCost = path->cost + rightCost;
+            }
+        }
+    }
+
+    // the cost of end-of-sentence node is the cost of the best path
+    const long maxCost = (eosNode->cost < INFINITE_COST - costMargin) ? eosNode->cost + costMargin : INFINITE_COST;
+
+    vector<bool> isBestNode(nodeCount, false);
+    for(const MeCab::Node* node=bosNode; node; node=node->next)
+        isBestNode[node->id] = true;
+
+    // the character offset of each byte position in lattice string
+    vector<unsigned int> charOffsets(len + 1);
+    OffsetCounter counter(knowledge_->getCType(), 0, bosNode->surface, position.charOffset_);
+    for(unsigned int i=0; i<=len; ++i)
+        charOffsets[i] = counter.moveTo(bosNode->surface + i);
+
+    // nodes on any path within cost margin, as the minimum cost through node is its cost from begin plus its cost to end
+    const int NOT_IN_GRAPH = numeric_limits<int>::min();
+    vector<int> graphIndex(nodeCount, NOT_IN_GRAPH);
+    for(unsigned int pos=0; pos<len; ++pos)
+    {
+        const unsigned int posStart = graph.nodes_.size();
+        for(const MeCab::Node* node=beginNodeList[pos]; node; node=node->bnext)
+        {
+            const long backCost = backCosts[node->id];
+            if(backCost == INFINITE_COST || node->cost > maxCost - backCost)
+                continue;
+
+            const int nodeOffset = position.byteOffset_ + (node->surface - bosNode->surface);
+            const int nodeLength = node->length;
+
+            // the nodes starting from the same position are unique on length and POS
+            unsigned int i = posStart;
+            for(; i<graph.nodes_.size(); ++i)
+            {
+                const MorphemeGraph::Node& graphNode = graph.nodes_[i];
+                if(graphNode.offset_ == nodeOffset && graphNode.length_ == nodeLength
+                        && graphNode.morpheme_.posCode_ == static_cast<int>(node->posid))
+                    break;
+            }
+
+            bool isUpdate = true;
+            if(i == graph.nodes_.size())
+            {
+                graph.nodes_.push_back(MorphemeGraph::Node());
+                MorphemeGraph::Node& graphNode = graph.nodes_.back();
+                graphNode.offset_ = nodeOffset;
+                graphNode.length_ = nodeLength;
+                graphNode.isBest_ = isBestNode[node->id];
+            }
+            else if(isBestNode[node->id])
+            {
+                // the best candidate keeps the forms of its own node
+                graph.nodes_[i].isBest_ = true;
+            }
+            else
+                isUpdate = false;
+
+            if(isUpdate)
+            {
+                Morpheme& morph = graph.nodes_[i].morpheme_;
+                morph = getMorpheme(node);
+
+                const unsigned int latticeOffset = node->surface - bosNode->surface;
+                morph.byteOffset_ = nodeOffset;
+                morph.byteLength_ = nodeLength;
+                morph.charOffset_ = charOffsets[latticeOffset];
+                morph.charLength_ = charOffsets[latticeOffset + nodeLength] - morph.charOffset_;
+            }
+            graphIndex[node->id] = i;
+        }
+    }
+
+    // edges on any path within cost margin
+    map<pair<int, int>, unsigned int> edgeIndex;
+    for(unsigned int pos=0; pos<=len; ++pos)
+    {
+        for(const MeCab::Node* node=beginNodeList[pos]; node; node=node->bnext)
+        {
+            const int to = (node == eosNode) ? MorphemeGraph::EOS_INDEX : graphIndex[node->id];
+            if(to == NOT_IN_GRAPH)
+                continue;
+
+            for(const MeCab::Path* path=node->lpath; path; path=path->lnext)
+            {
+                const MeCab::Node* leftNode = path->lnode;
+                const int from = (leftNode == bosNode) ? MorphemeGraph::BOS_INDEX : graphIndex[leftNode->id];
+                if(from == NOT_IN_GRAPH || leftNode->cost + path->cost > maxCost - backCosts[node->id])
+                    continue;
+
+                const bool isBest = isBestNode[node->id] && node->prev == leftNode;
+                pair<map<pair<int, int>, unsigned int>::iterator, bool> result =
+                    edgeIndex.insert(make_pair(make_pair(from, to), graph.edges_.size()));
+                if(result.second)
+                {
+                    MorphemeGraph::Edge edge;
+                    edge.from_ = from;
+                    edge.to_ = to;
+                    edge.isBest_ = isBest;
+                    graph.edges_.push_back(edge);
+                }
+                else if(isBest)
+                    graph.edges_[result.first->second].isBest_ = true;
+            }
+        }
+    }
+}
+
 } // namespace jma
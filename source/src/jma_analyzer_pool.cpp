@@ -0,0 +1,360 @@
+/** \file jma_analyzer_pool.cpp
+ * Implementation of class JMA_AnalyzerPool.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "jma_analyzer_pool.h"
+
+#ifdef JMA_USE_ANALYZER_POOL
+
+#include "jma_analyzer.h"
+#include "jma_knowledge.h"
+
+#include <sys/time.h> // gettimeofday
+#include <cassert>
+#include <cstddef> // size_t
+#include <iostream>
+
+using namespace std;
+
+namespace
+{
+/** the default idle timeout in seconds */
+const double DEFAULT_IDLE_TIMEOUT = 60;
+}
+
+namespace jma
+{
+
+JMA_AnalyzerPool::JMA_AnalyzerPool(Knowledge* knowledge, unsigned int maxSize)
+    : knowledge_(dynamic_cast<JMA_Knowledge*>(knowledge)),
+    options_(Analyzer::OPTION_TYPE_NUM),
+    revision_(1), idleTimeout_(DEFAULT_IDLE_TIMEOUT), nextId_(1)
+{
+    assert(knowledge_);
+    assert(maxSize > 0);
+
+    // the default options of analyzer
+    const JMA_Analyzer analyzer;
+    for(int i=0; i<Analyzer::OPTION_TYPE_NUM; ++i)
+        options_[i] = analyzer.getOption(static_cast<Analyzer::OptionType>(i));
+    posDelimiter_ = analyzer.getPOSDelimiter();
+    wordDelimiter_ = analyzer.getWordDelimiter();
+
+    stat_.maxSize_ = maxSize;
+    stat_.size_ = 0;
+    stat_.idleSize_ = 0;
+    stat_.checkoutCount_ = 0;
+    stat_.affinityCount_ = 0;
+    stat_.waitCount_ = 0;
+    stat_.waitTime_ = 0;
+    stat_.maxWaitTime_ = 0;
+    stat_.createCount_ = 0;
+    stat_.destroyCount_ = 0;
+
+    pthread_mutex_init(&mutex_, 0);
+    pthread_cond_init(&idleCond_, 0);
+    pthread_mutex_init(&createMutex_, 0);
+    pthread_key_create(&affinityKey_, 0);
+}
+
+JMA_AnalyzerPool::~JMA_AnalyzerPool()
+{
+    assert(idleSlots_.size() == slots_.size() && "all the analyzers should be returned");
+
+    destroySlots(slots_);
+
+    pthread_key_delete(affinityKey_);
+    pthread_mutex_destroy(&createMutex_);
+    pthread_cond_destroy(&idleCond_);
+    pthread_mutex_destroy(&mutex_);
+}
+
+void JMA_AnalyzerPool::setOption(Analyzer::OptionType nOption, double nValue)
+{
+    // the same check as Analyzer::setOption()
+    if(nOption == Analyzer::OPTION_TYPE_NBEST && nValue < 1)
+        return;
+
+    pthread_mutex_lock(&mutex_);
+    if(options_[nOption] != nValue)
+    {
+        options_[nOption] = nValue;
+        ++revision_;
+    }
+    pthread_mutex_unlock(&mutex_);
+}
+
+double JMA_AnalyzerPool::getOption(Analyzer::OptionType nOption) const
+{
+    pthread_mutex_lock(&mutex_);
+    const double value = options_[nOption];
+    pthread_mutex_unlock(&mutex_);
+
+    return value;
+}
+
+void JMA_AnalyzerPool::setPOSDelimiter(const char* delimiter)
+{
+    pthread_mutex_lock(&mutex_);
+    posDelimiter_ = delimiter;
+    ++revision_;
+    pthread_mutex_unlock(&mutex_);
+}
+
+void JMA_AnalyzerPool::setWordDelimiter(const char* delimiter)
+{
+    pthread_mutex_lock(&mutex_);
+    wordDelimiter_ = delimiter;
+    ++revision_;
+    pthread_mutex_unlock(&mutex_);
+}
+
+void JMA_AnalyzerPool::setIdleTimeout(double seconds)
+{
+    pthread_mutex_lock(&mutex_);
+    idleTimeout_ = seconds;
+    pthread_mutex_unlock(&mutex_);
+}
+
+void JMA_AnalyzerPool::applyOptions(JMA_Analyzer& analyzer) const
+{
+    for(int i=0; i<Analyzer::OPTION_TYPE_NUM; ++i)
+        analyzer.setOption(static_cast<Analyzer::OptionType>(i), options_[i]);
+    analyzer.setPOSDelimiter(posDelimiter_);
+    analyzer.setWordDelimiter(wordDelimiter_);
+}
+
+bool JMA_AnalyzerPool::isSameOptions(const JMA_Analyzer& analyzer) const
+{
+    for(int i=0; i<Analyzer::OPTION_TYPE_NUM; ++i)
+    {
+        if(analyzer.getOption(static_cast<Analyzer::OptionType>(i)) != options_[i])
+            return false;
+    }
+
+    return analyzer.getPOSDelimiter() == posDelimiter_
+        && analyzer.getWordDelimiter() == wordDelimiter_;
+}
+
+Analyzer* JMA_AnalyzerPool::checkout()
+{
+    const unsigned long affinity = reinterpret_cast<size_t>(pthread_getspecific(affinityKey_));
+    Slot* slot = 0;
+    double waitStart = 0;
+
+    pthread_mutex_lock(&mutex_);
+    ++stat_.checkoutCount_;
+    while(idleSlots_.empty() && stat_.size_ >= stat_.maxSize_)
+    {
+        if(waitStart == 0)
+        {
+            waitStart = getTime();
+            ++stat_.waitCount_;
+        }
+        pthread_cond_wait(&idleCond_, &mutex_);
+    }
+
+    if(waitStart != 0)
+    {
+        const double waitTime = getTime() - waitStart;
+        stat_.waitTime_ += waitTime;
+        if(waitTime > stat_.maxWaitTime_)
+            stat_.maxWaitTime_ = waitTime;
+    }
+
+    if(! idleSlots_.empty())
+    {
+        // the one used last time by this thread, otherwise the one returned latest
+        vector<Slot*>::iterator it = idleSlots_.end() - 1;
+        for(vector<Slot*>::iterator affinityIt = it; affinity; --affinityIt)
+        {
+            if((*affinityIt)->id_ == affinity)
+            {
+                it = affinityIt;
+                ++stat_.affinityCount_;
+                break;
+            }
+
+            if(affinityIt == idleSlots_.begin())
+                break;
+        }
+
+        slot = *it;
+        idleSlots_.erase(it);
+
+        if(slot->revision_ != revision_)
+        {
+            applyOptions(*slot->analyzer_);
+            slot->revision_ = revision_;
+        }
+    }
+    else
+    {
+        // reserve the size for the analyzer to create
+        ++stat_.size_;
+    }
+    pthread_mutex_unlock(&mutex_);
+
+    if(! slot)
+    {
+        slot = createSlot();
+        if(! slot)
+            return 0;
+    }
+
+    pthread_setspecific(affinityKey_, reinterpret_cast<void*>(static_cast<size_t>(slot->id_)));
+
+    return slot->analyzer_;
+}
+
+JMA_AnalyzerPool::Slot* JMA_AnalyzerPool::createSlot()
+{
+    JMA_Analyzer* analyzer = new JMA_Analyzer;
+
+    pthread_mutex_lock(&mutex_);
+    applyOptions(*analyzer);
+    const unsigned long revision = revision_;
+    pthread_mutex_unlock(&mutex_);
+
+    // the taggers are created one at a time, while the other analyzers could be checked out and returned
+    pthread_mutex_lock(&createMutex_);
+    const int result = analyzer->setKnowledge(knowledge_);
+    pthread_mutex_unlock(&createMutex_);
+
+    Slot* slot = 0;
+    pthread_mutex_lock(&mutex_);
+    if(result)
+    {
+        slot = new Slot;
+        slot->analyzer_ = analyzer;
+        slot->id_ = nextId_++;
+        slot->revision_ = revision;
+        slot->idleSince_ = 0;
+        slots_.push_back(slot);
+        ++stat_.createCount_;
+    }
+    else
+    {
+        // another thread could create it
+        --stat_.size_;
+        pthread_cond_signal(&idleCond_);
+    }
+    pthread_mutex_unlock(&mutex_);
+
+    if(! slot)
+    {
+        cerr << "[Error] fail to create analyzer in pool" << endl;
+        delete analyzer;
+    }
+
+    return slot;
+}
+
+void JMA_AnalyzerPool::checkin(Analyzer* analyzer)
+{
+    assert(analyzer);
+
+    vector<Slot*> expired;
+    pthread_mutex_lock(&mutex_);
+
+    Slot* slot = 0;
+    for(vector<Slot*>::const_iterator it=slots_.begin(); it!=slots_.end(); ++it)
+    {
+        if((*it)->analyzer_ == analyzer)
+        {
+            slot = *it;
+            break;
+        }
+    }
+
+    if(! slot)
+    {
+        pthread_mutex_unlock(&mutex_);
+        cerr << "[Error] the analyzer is not checked out from this pool" << endl;
+        return;
+    }
+
+    // reset the options changed by user in next checkout
+    if(slot->revision_ == revision_ && ! isSameOptions(*slot->analyzer_))
+        slot->revision_ = 0;
+
+    const double now = getTime();
+    slot->idleSince_ = now;
+    idleSlots_.push_back(slot);
+    removeExpired(now, expired);
+
+    pthread_cond_signal(&idleCond_);
+    pthread_mutex_unlock(&mutex_);
+
+    destroySlots(expired);
+}
+
+unsigned int JMA_AnalyzerPool::shrink()
+{
+    vector<Slot*> expired;
+
+    pthread_mutex_lock(&mutex_);
+    removeExpired(getTime(), expired);
+    pthread_mutex_unlock(&mutex_);
+
+    destroySlots(expired);
+
+    return expired.size();
+}
+
+void JMA_AnalyzerPool::removeExpired(double now, std::vector<Slot*>& expired)
+{
+    if(idleTimeout_ < 0)
+        return;
+
+    // the idle slots are in the order of returned time
+    vector<Slot*>::iterator idleIt = idleSlots_.begin();
+    for(; idleIt!=idleSlots_.end() && now - (*idleIt)->idleSince_ > idleTimeout_; ++idleIt)
+    {
+        expired.push_back(*idleIt);
+        for(vector<Slot*>::iterator it=slots_.begin(); it!=slots_.end(); ++it)
+        {
+            if(*it == *idleIt)
+            {
+                slots_.erase(it);
+                break;
+            }
+        }
+    }
+
+    const unsigned int count = idleIt - idleSlots_.begin();
+    idleSlots_.erase(idleSlots_.begin(), idleIt);
+    stat_.size_ -= count;
+    stat_.destroyCount_ += count;
+}
+
+void JMA_AnalyzerPool::destroySlots(const std::vector<Slot*>& slots)
+{
+    for(vector<Slot*>::const_iterator it=slots.begin(); it!=slots.end(); ++it)
+    {
+        delete (*it)->analyzer_;
+        delete *it;
+    }
+}
+
+void JMA_AnalyzerPool::getStatistics(Statistics& stat) const
+{
+    pthread_mutex_lock(&mutex_);
+    stat = stat_;
+    stat.idleSize_ = idleSlots_.size();
+    pthread_mutex_unlock(&mutex_);
+}
+
+double JMA_AnalyzerPool::getTime()
+{
+    timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+} // namespace jma
+
+#endif // JMA_USE_ANALYZER_POOL
@@ -9,6 +9,7 @@
 #include "ijma/jma_factory.h"
 #include "jma_analyzer.h"
 #include "jma_knowledge.h"
+#include "jma_analyzer_pool.h"
 
 namespace jma
 {
@@ -35,6 +36,15 @@ Knowledge* JMA_Factory::createKnowledge()
     return new JMA_Knowledge;
 }
 
+AnalyzerPool* JMA_Factory::createAnalyzerPool(Knowledge* knowledge, unsigned int maxSize)
+{
+#ifdef JMA_USE_ANALYZER_POOL
+    return new JMA_AnalyzerPool(knowledge, maxSize);
+#else
+    return 0;
+#endif
+}
+
 JMA_Factory::JMA_Factory()
 {
 }
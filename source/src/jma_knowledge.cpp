@@ -170,10 +170,11 @@ inline string* getMapValue(map<string, string>& map, const string& key)
 }
 
 JMA_Knowledge::JMA_Knowledge()
-    : isOutputFullPOS_(false), baseFormOffset_(0), readFormOffset_(0), normFormOffset_(0),
+    : stopWordRevision_(0), isOutputFullPOS_(false), baseFormOffset_(0), readFormOffset_(0), normFormOffset_(0),
     ctype_(0), configEncodeType_(Knowledge::ENCODE_TYPE_NUM),
     dictionary_(JMA_Dictionary::instance()), userDictionary_(JMA_UserDictionary::instance())
 {
+    decompTable_.offsets_.push_back(0);
 }
 
 JMA_Knowledge::~JMA_Knowledge()
@@ -216,6 +217,8 @@ bool JMA_Knowledge::compileUserDict()
 
     // remove existing decompostion map
     decompMap_.clear();
+    decompTable_.morphemes_.clear();
+    decompTable_.offsets_.assign(1, 0);
 
     ostringstream osst;
     // append source files of user dictionary
@@ -351,6 +354,11 @@ const JMA_Knowledge::DecompMap& JMA_Knowledge::getDecompMap() const
     return decompMap_;
 }
 
+const JMA_Knowledge::DecompTable& JMA_Knowledge::getDecompTable() const
+{
+    return decompTable_;
+}
+
 void JMA_Knowledge::loadDictConfig()
 {
     map<string, string> configMap;
@@ -551,6 +559,7 @@ int JMA_Knowledge::loadStopWordDict(const char* fileName)
 
     // remove existing stop words
     stopWords_.clear();
+    ++stopWordRevision_;
 
     string line;
     while(getline(in, line))
@@ -704,17 +713,32 @@ unsigned int JMA_Knowledge::stopWordCount() const
     return stopWords_.size();
 }
 
+const std::set<std::string>& JMA_Knowledge::getStopWords() const
+{
+    return stopWords_;
+}
+
+unsigned int JMA_Knowledge::getStopWordRevision() const
+{
+    return stopWordRevision_;
+}
+
 bool JMA_Knowledge::isSentenceSeparator(const char* p) const
 {
     return sentSeps_.find(p) != sentSeps_.end();
 }
 
+const SentenceSplitter& JMA_Knowledge::getSentenceSplitter() const
+{
+    return sentSplitter_;
+}
+
 bool JMA_Knowledge::isKeywordPOS(int pos) const
 {
     if(keywordPOSSet_.empty())
         return true;
 
-    return keywordPOSSet_.find(pos) != keywordPOSSet_.end();
+    return pos >= 0 && pos < static_cast<int>(keywordPOSFlags_.size()) && keywordPOSFlags_[pos];
 }
 
 unsigned int JMA_Knowledge::keywordPOSCount() const
@@ -780,6 +804,10 @@ bool JMA_Knowledge::loadSentenceSeparatorConfig(const char* fileName, MeCab::Ico
         sentSeps_.insert(line);
     }
 
+    // UTF-8 characters never start within another character
+    assert(ctype_ && "the character type should be created before loading sentence separators");
+    sentSplitter_.build(sentSeps_, ctype_, encodeType_ == Knowledge::ENCODE_TYPE_UTF8);
+
 #if JMA_DEBUG_PRINT
     cout << "Sentence separators loaded from " << fileName << ": ";
     for(set<string>::const_iterator it=sentSeps_.begin(); it!=sentSeps_.end(); ++it)
@@ -860,14 +888,14 @@ unsigned int JMA_Knowledge::convertTxtToCSV(const UserDictFileType& userDicFile,
         iss.str(line);
         ostrs.str(""); // reset output string stream to empty
 
-        if(iss >> word)
-            ostrs << word << ",-1,-1," << USER_NOUN_COST;
-        else
+        if(! (iss >> word))
         {
             cerr << "no word is defined in line: " << line << endl;
             continue;
         }
 
+        // the compound index in decomposition table, 0 for not decomposed
+        unsigned int compound = 0;
         ostrs << "," << userNounPOS;
         for(int i=posSize; i<readFormOffset_; ++i)
         {
@@ -953,6 +981,9 @@ unsigned int JMA_Knowledge::convertTxtToCSV(const UserDictFileType& userDicFile,
                 }
 
                 decompMap_[word] = decompList;
+                decompTable_.morphemes_.insert(decompTable_.morphemes_.end(), decompList.begin(), decompList.end());
+                decompTable_.offsets_.push_back(decompTable_.morphemes_.size());
+                compound = decompTable_.offsets_.size() - 1;
 #if JMA_DEBUG_PRINT
                 cout << "word " << word << " is decomposed into: ";
                 for(unsigned int i=0; i<decompList.size(); ++i)
@@ -984,6 +1015,10 @@ unsigned int JMA_Knowledge::convertTxtToCSV(const UserDictFileType& userDicFile,
         else
             ostrs << ",*";
 
+        // the compound index follows the cost, which is saved in MeCab::Token::compound
+        ost << word << ",-1,-1," << USER_NOUN_COST;
+        if(compound)
+            ost << ":" << compound;
         ost << ostrs.str() << endl;
         ++count;
     }
@@ -1057,6 +1092,11 @@ int JMA_Knowledge::setKeywordPOS(const std::vector<std::string>& posVec)
             keywordPOSSet_.insert(posIndex);
     }
 
+    // compile into flags indexed by POS code
+    keywordPOSFlags_.assign(keywordPOSSet_.empty() ? 0 : *keywordPOSSet_.rbegin() + 1, false);
+    for(set<int>::const_iterator it=keywordPOSSet_.begin(); it!=keywordPOSSet_.end(); ++it)
+        keywordPOSFlags_[*it] = true;
+
     return keywordPOSSet_.size();
 }
 
@@ -78,6 +78,7 @@
 
 #define NBEST_MAX 512
 #define NODE_FREELIST_SIZE 512
+#define RESERVE_NODE_PER_BYTE 16
 #define PATH_FREELIST_SIZE 2048
 #define MIN_INPUT_BUFFER_SIZE 8192
 #define MAX_INPUT_BUFFER_SIZE 8192*640
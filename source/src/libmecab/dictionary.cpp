@@ -20,6 +20,7 @@
 
 #include <sstream> // ostringstream, istringstream
 #include <string> // string
+#include <cstring> // strchr
 #include "jma_dictionary.h" // JMA_UserDictionary
 
 namespace MeCab {
@@ -104,6 +105,7 @@ bool Dictionary::compile(const Param &param,
   scoped_ptr<ContextID> cid(0);
   scoped_ptr<Writer> writer(0);
   scoped_ptr<StringBuffer> os(0);
+  Writer::Format compiled_format;
   Node node;
 
   std::vector<std::pair<std::string, Token*> > dic;
@@ -138,6 +140,9 @@ bool Dictionary::compile(const Param &param,
     writer.reset(new Writer);
     os.reset(new StringBuffer);
     memset(&node, 0, sizeof(node));
+    CHECK_DIE(writer->compile(node_format.c_str(), &compiled_format))
+        << "invalid node format: " << node_format
+        << " " << writer->what();
   }
 
   if (!matrix.openText(matrix_file) &&
@@ -195,6 +200,12 @@ bool Dictionary::compile(const Param &param,
       rid = std::atoi(col[2]);
       cost = std::atoi(col[3]);
       feature = col[4];
+
+      // the cost of iJMA user noun could be followed by ':' and its decomposition index,
+      // which is saved in Token::compound, 0 for not decomposed
+      unsigned int compound = 0;
+      if (const char *p = std::strchr(col[3], ':'))
+        compound = std::atoi(p + 1);
       int pid = posid->id(feature.c_str());
 
       if (lid < 0  || rid < 0) {
@@ -252,7 +263,7 @@ bool Dictionary::compile(const Param &param,
         CHECK_DIE(writer.get());
         os->clear();
         CHECK_DIE(writer->writeNode(&*os,
-                                    node_format.c_str(),
+                                    compiled_format,
                                     w.c_str(),
                                     &node)) <<
             "conversion error: " << feature << " with " << node_format;
@@ -269,7 +280,7 @@ bool Dictionary::compile(const Param &param,
       token->posid  = pid;
       token->wcost = cost;
       token->feature = offset;
-      token->compound = 0;
+      token->compound = compound;
       dic.push_back(std::make_pair<std::string, Token*>(w, token));
 
       // append to output buffer
@@ -71,6 +71,8 @@ class Dictionary {
   }
   size_t token_size(const result_type &n) const { return 0xff & n.value; }
   const char  *feature(const Token &t) const { return feature_ + t.feature; }
+  // all the tokens in dictionary, the token count is size()
+  const Token *tokens() const { return token_; }
 
   static bool compile(const Param &param,
                       const std::vector<std::string> &dics,
@@ -24,6 +24,12 @@ template <class T> class FreeList {
  public:
   void free() { li_ = pi_ = 0; }
 
+  // allocate the chunks in advance, so that n items are allocated
+  // without memory allocation after free().
+  void reserve(size_t n) {
+    while (freeList.size() * size < n) freeList.push_back(new T[size]);
+  }
+
   T* alloc() {
     if (pi_ == size) {
       li_++;
@@ -200,6 +200,7 @@ extern "C" {
 
 /* C++ interface */
 #ifdef __cplusplus
+#include <vector>
 
 namespace MeCab {
 typedef struct mecab_dictionary_info_t DictionaryInfo;
@@ -216,6 +217,11 @@ class Tagger {
   virtual const char* parse(const char *str, size_t len, char *ostr, size_t olen) = 0;
   virtual const char* parse(const char *str, size_t len)                          = 0;
   virtual const Node* parseToNode(const char *str, size_t len)                    = 0;
+  /**
+   * Parse by greedy longest match instead of Viterbi search,
+   * the nodes are linked by next and prev as the best path, without lattice.
+   */
+  virtual const Node* parseToNodeLongest(const char *str, size_t len)             = 0;
   virtual const char* parseNBest(size_t N, const char *str, size_t len)           = 0;
   virtual bool  parseNBestInit(const char *str, size_t len)                       = 0;
 #endif
@@ -230,6 +236,38 @@ class Tagger {
    */
   virtual long nextScore()                                  = 0;
   virtual const char* next()                                = 0;
+  /**
+   * The maximum cost gap to the best path in n-best search, non-positive for no limit.
+   * It takes effect from next parseNBestInit().
+   */
+  virtual long nbest_cost_gap() const                       = 0;
+  virtual void set_nbest_cost_gap(long gap)                 = 0;
+  /**
+   * The maximum agenda size of n-best search since last parseNBestInit()
+   */
+  virtual size_t nbest_agenda_size() const                  = 0;
+  /**
+   * The term id of node, which is the token index in the system and user dictionaries,
+   * or -1 for unknown word.
+   */
+  virtual int term_id(const Node *node) const               = 0;
+  /**
+   * Append the term ids of all the tokens whose surface is exactly key.
+   */
+  virtual void term_ids(const char *key, std::vector<int> *ids) const = 0;
+  /**
+   * Decode the characters of str once, so that they are not decoded again
+   * in parsing str or its substrings, until clear_chars() is called.
+   * Return the byte length of the character starting at each byte of str,
+   * or 0 for the byte within character.
+   */
+  virtual const unsigned char* scan_chars(const char *str, size_t len) = 0;
+  virtual void clear_chars()                                = 0;
+  /**
+   * Preallocate the workspaces, so that parsing a string no longer than len
+   * allocates no memory in common cases.
+   */
+  virtual void reserve(size_t len)                          = 0;
   virtual const char* formatNode(const Node *node)          = 0;
 
   // configuration
@@ -5,6 +5,7 @@
 //  Copyright(C) 2001-2006 Taku Kudo <taku@chasen.org>
 //  Copyright(C) 2004-2006 Nippon Telegraph and Telephone Corporation
 #include <queue>
+#include <climits>
 #include "mecab.h"
 #include "nbest_generator.h"
 
@@ -19,6 +20,10 @@ bool NBestGenerator::set(Node *node) {
   eos->next = 0;
   eos->fx = eos->gx = 0;
   agenda_.push(eos);
+  agenda_peak_ = 1;
+  // the cost of EOS node is the cost of the best path
+  cost_bound_ = (cost_gap_ > 0 && node->cost < LONG_MAX - cost_gap_) ?
+      node->cost + cost_gap_ : LONG_MAX;
   return true;
 }
 
@@ -39,13 +44,16 @@ Node* NBestGenerator::next() {
     }
 
     for (Path *path = rnode->lpath; path; path = path->lnext) {
+      const long fx = path->lnode->cost + path->cost + top->gx;
+      if (fx > cost_bound_) continue;  // too far from the best path
       QueueElement *n = freelist_.alloc();
       n->node = path->lnode;
       n->gx = path->cost + top->gx;
-      n->fx = path->lnode->cost + path->cost + top->gx;
+      n->fx = fx;
       n->next = top;
       agenda_.push(n);
     }
+    if (agenda_.size() > agenda_peak_) agenda_peak_ = agenda_.size();
   }
   score = 0;
   return 0;
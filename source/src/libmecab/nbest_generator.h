@@ -33,8 +33,12 @@ class NBestGenerator {
                       QueueElementComp> agenda_;
   FreeList <QueueElement> freelist_;
   long score;
+  long cost_gap_;     // maximum cost gap to the best path, non-positive for no limit
+  long cost_bound_;   // paths with f(x) above this bound are not expanded
+  size_t agenda_peak_;
  public:
-  explicit NBestGenerator(): freelist_(512) {}
+  explicit NBestGenerator(): freelist_(512), score(0), cost_gap_(0),
+                             cost_bound_(0), agenda_peak_(0) {}
   virtual ~NBestGenerator() {}
   bool  set(Node *);
   Node* next();
@@ -43,6 +47,19 @@ class NBestGenerator {
    * Invoked after invoking next()
    */
   long nextScore();
+
+  /**
+   * Set the maximum cost gap to the best path, which takes effect from next set().
+   * The agenda entries whose cost exceeds the best cost by more than the gap are not expanded.
+   * A non-positive gap means no limit.
+   */
+  void set_cost_gap(long gap) { cost_gap_ = gap; }
+  long cost_gap() const { return cost_gap_; }
+
+  /**
+   * The maximum agenda size since last set().
+   */
+  size_t agenda_peak() const { return agenda_peak_; }
 };
 }
 
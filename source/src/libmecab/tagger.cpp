@@ -81,6 +81,7 @@ class TaggerImpl: public Tagger {
   const char*                begin_;
   whatlog                    what_;
   long                       score; //invoke after invoking nextNode
+  long                       nbest_cost_gap_;
 
  public:
   bool                  open(Param *);
@@ -92,6 +93,7 @@ class TaggerImpl: public Tagger {
   const char*           parse(const char*, size_t, char*, size_t);
   const Node*           parseToNode(const char*);
   const Node*           parseToNode(const char*, size_t = 0);
+  const Node*           parseToNodeLongest(const char*, size_t);
   const char*           parseNBest(size_t, const char*);
   const char*           parseNBest(size_t, const char*, size_t);
   const char*           parseNBest(size_t, const char*,
@@ -103,6 +105,14 @@ class TaggerImpl: public Tagger {
    * Invoke after invoking nextNode();
    */
   long                  nextScore();
+  long                  nbest_cost_gap() const;
+  void                  set_nbest_cost_gap(long gap);
+  size_t                nbest_agenda_size() const;
+  int                   term_id(const Node *node) const;
+  void                  term_ids(const char *key, std::vector<int> *ids) const;
+  const unsigned char*  scan_chars(const char *str, size_t len);
+  void                  clear_chars();
+  void                  reserve(size_t len);
   const char*           next();
   const char*           next(char*, size_t);
   const char           *formatNode(const Node *);
@@ -118,7 +128,7 @@ class TaggerImpl: public Tagger {
   bool                  all_morphs() const;
   const char*           what();
 
-  TaggerImpl() {}
+  TaggerImpl(): begin_(0), score(0), nbest_cost_gap_(0) {}
   virtual ~TaggerImpl() { this->close(); }
 };
 
@@ -262,6 +272,13 @@ const Node *TaggerImpl::parseToNode(const char *str, size_t len) {
   return bosNode;
 }
 
+const Node *TaggerImpl::parseToNodeLongest(const char *str, size_t len) {
+  CHECK_RETURN(str, static_cast<Node *>(0)) << "NULL pointer is given";
+  const Node *bosNode = viterbi_.analyzeLongest(str, len);
+  CHECK_RETURN(bosNode, static_cast<const Node *>(0)) << viterbi_.what();
+  return bosNode;
+}
+
 bool TaggerImpl::parseNBestInit(const char *str) {
   return parseNBestInit(str, std::strlen(str));
 }
@@ -274,6 +291,7 @@ bool TaggerImpl::parseNBestInit(const char *str, size_t len) {
   begin_ = str;
   if (!n) return false;
   if (!nbest_.get()) nbest_.reset(new NBestGenerator);
+  nbest_->set_cost_gap(nbest_cost_gap_);
   nbest_->set(const_cast<Node *>(n));
   return true;
 }
@@ -290,6 +308,38 @@ long TaggerImpl::nextScore(){
 	return score;
 }
 
+long TaggerImpl::nbest_cost_gap() const {
+  return nbest_cost_gap_;
+}
+
+void TaggerImpl::set_nbest_cost_gap(long gap) {
+  nbest_cost_gap_ = gap;
+}
+
+size_t TaggerImpl::nbest_agenda_size() const {
+  return nbest_.get() ? nbest_->agenda_peak() : 0;
+}
+
+int TaggerImpl::term_id(const Node *node) const {
+  return node->token ? tokenizer_.term_id(node->token) : -1;
+}
+
+void TaggerImpl::term_ids(const char *key, std::vector<int> *ids) const {
+  tokenizer_.term_ids(key, ids);
+}
+
+const unsigned char* TaggerImpl::scan_chars(const char *str, size_t len) {
+  return tokenizer_.scan_chars(str, str + len);
+}
+
+void TaggerImpl::clear_chars() {
+  tokenizer_.clear_chars();
+}
+
+void TaggerImpl::reserve(size_t len) {
+  viterbi_.reserve(len);
+}
+
 const char* TaggerImpl::next() {
   const Node *n = nextNode();
 
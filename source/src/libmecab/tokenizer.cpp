@@ -72,7 +72,8 @@ TokenizerImpl<N, P>::TokenizerImpl():
     node_freelist_(NODE_FREELIST_SIZE),
     dictionary_info_freelist_(4),
     daresults_(new Dictionary::result_type[DRESULT_SIZE]),
-    dictionary_info_(0), max_grouping_size_(0), id_(0) {}
+    dictionary_info_(0), max_grouping_size_(0), id_(0),
+    scan_begin_(0), scan_end_(0) {}
 
 template <typename N, typename P>
 void TokenizerImpl<N, P>::clear() {
@@ -210,8 +211,8 @@ N *TokenizerImpl<N, P>::lookup(const char *begin, const char *end) {
   size_t clen = 0;
 
   end = static_cast<size_t>(end - begin) >= 65535 ? begin + 65535 : end;
-  const char *begin2 = property_.seekToOtherType(begin, end, space_,
-                                                 &cinfo, &mblen, &clen);
+  const char *begin2 = seekToOtherType(begin, end, space_,
+                                       &cinfo, &mblen, &clen);
 
   for (std::vector<Dictionary *>::const_iterator it = dic_.begin();
        it != dic_.end(); ++it) {
@@ -250,8 +251,8 @@ N *TokenizerImpl<N, P>::lookup(const char *begin, const char *end) {
   if (cinfo.group) {
     const char *tmp = begin3;
     CharInfo fail;
-    begin3 = property_.seekToOtherType(begin3, end, cinfo,
-                                       &fail, &mblen, &clen);
+    begin3 = seekToOtherType(begin3, end, cinfo,
+                             &fail, &mblen, &clen);
     if (clen <= max_grouping_size_) ADDUNKNWON;
     group_begin3 = begin3;
     begin3 = tmp;
@@ -262,7 +263,7 @@ N *TokenizerImpl<N, P>::lookup(const char *begin, const char *end) {
     if (begin3 == group_begin3) continue;
     clen = i;
     ADDUNKNWON;
-    if (!cinfo.isKindOf(property_.getCharInfo(begin3, end, &mblen))) break;
+    if (!cinfo.isKindOf(getCharInfo(begin3, end, &mblen))) break;
     begin3 += mblen;
   }
 
@@ -36,6 +36,39 @@ class TokenizerImpl {
   unsigned int                           id_;
   whatlog                                what_;
 
+  // the characters decoded by scan_chars(), which are reused when
+  // their substrings are looked up, until clear_chars() is called.
+  const char                            *scan_begin_;
+  const char                            *scan_end_;
+  std::vector<CharInfo>                  scan_infos_;
+  std::vector<unsigned char>             scan_lengths_;
+
+  inline CharInfo getCharInfo(const char *begin, const char *end,
+                              size_t *mblen) const {
+    if (begin >= scan_begin_ && begin < scan_end_) {
+      const size_t i = static_cast<size_t>(begin - scan_begin_);
+      const size_t len = scan_lengths_[i];
+      if (len && len <= static_cast<size_t>(end - begin)) {
+        *mblen = len;
+        return scan_infos_[i];
+      }
+    }
+    return property_.getCharInfo(begin, end, mblen);
+  }
+
+  inline const char *seekToOtherType(const char *begin, const char *end,
+                                     CharInfo c, CharInfo *fail,
+                                     size_t *mblen, size_t *clen) const {
+    const char *p = begin;
+    *clen = 0;
+    while (p != end && c.isKindOf(*fail = getCharInfo(p, end, mblen))) {
+      p += *mblen;
+      ++(*clen);
+      c = *fail;
+    }
+    return p;
+  }
+
  public:
 
   inline N *getNewNode() {
@@ -56,6 +89,59 @@ class TokenizerImpl {
 
   const DictionaryInfo *dictionary_info() const;
 
+  // term id is the token index in the system and user dictionaries,
+  // or -1 for the token not in those dictionaries, such as unknown word.
+  int term_id(const Token *token) const {
+    size_t offset = 0;
+    for (std::vector<Dictionary *>::const_iterator it = dic_.begin();
+         it != dic_.end(); ++it) {
+      const Token *begin = (*it)->tokens();
+      if (token >= begin && token < begin + (*it)->size())
+        return static_cast<int>(offset + (token - begin));
+      offset += (*it)->size();
+    }
+    return -1;
+  }
+
+  // append the term ids of all the tokens whose surface is exactly key.
+  void term_ids(const char *key, std::vector<int> *ids) const {
+    size_t offset = 0;
+    for (std::vector<Dictionary *>::const_iterator it = dic_.begin();
+         it != dic_.end(); ++it) {
+      const Dictionary::result_type n = (*it)->exactMatchSearch(key);
+      if (n.value != -1) {
+        const Token *token = (*it)->token(n);
+        const size_t size = (*it)->token_size(n);
+        for (size_t i = 0; i < size; ++i)
+          ids->push_back(static_cast<int>(offset + (token + i - (*it)->tokens())));
+      }
+      offset += (*it)->size();
+    }
+  }
+
+  // decode each character in [begin, end) once, and return the byte length
+  // of the character starting at each byte, or 0 for the byte within character.
+  const unsigned char *scan_chars(const char *begin, const char *end) {
+    const size_t size = static_cast<size_t>(end - begin);
+    scan_infos_.resize(size);
+    scan_lengths_.assign(size, 0);
+    size_t mblen = 0;
+    for (const char *p = begin; p < end; p += mblen) {
+      const size_t i = static_cast<size_t>(p - begin);
+      scan_infos_[i] = property_.getCharInfo(p, end, &mblen);
+      if (mblen == 0 || mblen > static_cast<size_t>(end - p))
+        mblen = static_cast<size_t>(end - p);
+      scan_lengths_[i] = static_cast<unsigned char>(mblen);
+    }
+    scan_begin_ = begin;
+    scan_end_ = end;
+    return size ? &scan_lengths_[0] : 0;
+  }
+
+  void clear_chars() { scan_begin_ = scan_end_ = 0; }
+
+  void reserve(size_t nodes) { node_freelist_.reserve(nodes); }
+
   const char *what() { return what_.str(); }
 
   explicit TokenizerImpl();
@@ -130,6 +130,57 @@ Node *Viterbi::analyze(const char *str, size_t len) {
   return(this->*buildLattice_)();
 }
 
+Node *Viterbi::analyzeLongest(const char *str, size_t len) {
+  if (copy_sentence_) {
+    sentence_.resize(len + 1);
+    std::strncpy(&sentence_[0], str, len);
+    str = &sentence_[0];
+  }
+
+  clear();
+
+  begin_ = str;
+  end_   = begin_ + len;
+  bosNode_ = tokenizer_->getBOSNode();
+  bosNode_->surface = begin_;
+  bosNode_->sentence_length = len;
+
+  Node *prev = bosNode_;
+  for (const char *p = begin_; p < end_;) {
+    // the longest token, or the one with the lowest word cost in a tie,
+    // the unknown word beyond the trailing spaces is ignored as in viterbi()
+    const size_t rest = static_cast<size_t>(end_ - p);
+    Node *best = 0;
+    for (Node *node = tokenizer_->lookup(p, end_); node; node = node->bnext) {
+      if (node->rlength == 0 || node->rlength > rest) continue;
+      if (!best || node->rlength > best->rlength ||
+          (node->rlength == best->rlength && node->wcost < best->wcost))
+        best = node;
+    }
+    if (!best) break;
+
+    best->isbest = 1;
+    best->prev = prev;
+    prev->next = best;
+    prev = best;
+    p += best->rlength;
+  }
+
+  eosNode_ = tokenizer_->getEOSNode();
+  eosNode_->surface = end_;
+  eosNode_->prev = prev;
+  prev->next = eosNode_;
+
+  return bosNode_;
+}
+
+void Viterbi::reserve(size_t len) {
+  begin_node_list_.reserve(len + 4);
+  end_node_list_.reserve(len + 4);
+  sentence_.reserve(len + 1);
+  tokenizer_->reserve(len * RESERVE_NODE_PER_BYTE);
+}
+
 void Viterbi::clear() {
   tokenizer_->clear();
   Z_ = 0.0;
@@ -70,6 +70,13 @@ class Viterbi {
 
   Node *analyze(const char *str, size_t len);
 
+  // link the longest token at each position from the begin of str,
+  // without lattice and connection costs.
+  Node *analyzeLongest(const char *str, size_t len);
+
+  // preallocate the workspaces for the string no longer than len.
+  void reserve(size_t len);
+
   const char *what() { return what_.str(); }
 
   bool partial() const { return partial_; }
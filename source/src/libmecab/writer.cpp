@@ -4,6 +4,7 @@
 //
 //  Copyright(C) 2001-2006 Taku Kudo <taku@chasen.org>
 //  Copyright(C) 2004-2006 Nippon Telegraph and Telephone Corporation
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <fstream>
@@ -86,11 +87,11 @@ bool Writer::open(const Param &param) {
       else
         unk_format = node_format;
       if (eon_format != eon_format2) eon_format = eon_format2;
-      node_format_.reset_string(node_format.c_str());
-      bos_format_.reset_string(bos_format.c_str());
-      eos_format_.reset_string(eos_format.c_str());
-      unk_format_.reset_string(unk_format.c_str());
-      eon_format_.reset_string(eon_format.c_str());
+      CHECK_FALSE(compile(node_format.c_str(), &node_format_));
+      CHECK_FALSE(compile(bos_format.c_str(), &bos_format_));
+      CHECK_FALSE(compile(eos_format.c_str(), &eos_format_));
+      CHECK_FALSE(compile(unk_format.c_str(), &unk_format_));
+      CHECK_FALSE(compile(eon_format.c_str(), &eon_format_));
     }
   }
 
@@ -128,15 +129,14 @@ bool Writer::writeNone(StringBuffer *, const char*, const Node *) {
 
 bool Writer::writeUser(StringBuffer *os, const char* str,
                        const Node *bosNode) {
-  if (!writeNode(os, bos_format_.get(), str, bosNode)) return false;
+  if (!writeNode(os, bos_format_, str, bosNode)) return false;
   const Node *node = 0;
-  const char *fmt = 0;
   for (node = bosNode->next; node->next; node = node->next) {
-    fmt = (node->stat == MECAB_UNK_NODE ? unk_format_.get() :
-           node_format_.get());
-    if (!writeNode(os, fmt, str, node)) return false;
+    const Format &format = (node->stat == MECAB_UNK_NODE ? unk_format_ :
+                            node_format_);
+    if (!writeNode(os, format, str, node)) return false;
   }
-  if (!writeNode(os, eos_format_.get(), str, node)) return false;
+  if (!writeNode(os, eos_format_, str, node)) return false;
   return true;
 }
 
@@ -202,165 +202,258 @@ bool Writer::writeNode(StringBuffer *os, const char *sentence,
                        const Node *node) {
   switch (node->stat) {
     case MECAB_BOS_NODE:
-      return writeNode(os, bos_format_.get(),  sentence, node);
+      return writeNode(os, bos_format_,  sentence, node);
     case MECAB_EOS_NODE:
-      return writeNode(os, eos_format_.get(),  sentence, node);
+      return writeNode(os, eos_format_,  sentence, node);
     case MECAB_UNK_NODE:
-      return writeNode(os, unk_format_.get(),  sentence, node);
+      return writeNode(os, unk_format_,  sentence, node);
     case MECAB_NOR_NODE:
-      return writeNode(os, node_format_.get(), sentence, node);
+      return writeNode(os, node_format_, sentence, node);
     case MECAB_EON_NODE:
-      return writeNode(os, eon_format_.get(), sentence, node);
+      return writeNode(os, eon_format_, sentence, node);
   }
   return true;
 }
 
-bool Writer::writeNode(StringBuffer *os, const char *p,
+bool Writer::writeNode(StringBuffer *os, const char *fmt,
                        const char *sentence, const Node *node) {
-  char buf[BUF_SIZE];
-  char *ptr[64];
-  size_t psize = 0;
+  Format format;
+  if (!compile(fmt, &format)) return false;
+  return writeNode(os, format, sentence, node);
+}
+
+namespace {
+// append a literal char, merged into the previous literal span if any.
+void addLiteral(Writer::Format *format, char c) {
+  if (format->ops.empty() || format->ops.back().type != 0) {
+    Writer::FormatOp op = { 0, 0, 0, 0, format->text.size(), 0 };
+    format->ops.push_back(op);
+  }
+  format->text += c;
+  ++format->ops.back().size;
+}
+
+// split the first max columns of feature in the same way as tokenizeCSV(),
+// while the columns refer into feature without copying.
+// return the number of columns, or 0 if a quoted column is found.
+size_t splitFeature(const char *feature, const char **columns,
+                    size_t *lengths, size_t max) {
+  const char *eos = feature + std::strlen(feature);
+  size_t n = 0;
+  for (const char *str = feature; str < eos && n < max; ++str) {
+    while (*str == ' ' || *str == '\t') ++str;
+    if (*str == '"') return 0;
+    const char *end = std::find(str, eos, ',');
+    columns[n] = str;
+    lengths[n] = end - str;
+    ++n;
+    str = end;
+  }
+  return n;
+}
+}
+
+bool Writer::compile(const char *p, Format *format) {
+  format->text.clear();
+  format->ops.clear();
+  format->fields.clear();
+  format->max_field = 0;
 
   for (; *p; p++) {
     switch (*p) {
-      default: *os << *p; break;
+      default: addLiteral(format, *p); break;
 
-      case '\\': *os << getEscapedChar(*++p); break;
+      case '\\': addLiteral(format, getEscapedChar(*++p)); break;
 
       case '%': {  // macros
-        switch (*++p) {
+        FormatOp op = { *++p, 0, 0, 0, 0, 0 };
+        switch (op.type) {
           default: CHECK_FALSE(false) << "unkonwn meta char " << *p;
-            // input sentence
-          case 'S': os->write(sentence, std::strlen(sentence)); break;
-            // sentence length
-          case 'L': *os << std::strlen(sentence); break;
-            // morph
-          case 'm': os->write(node->surface, node->length); break;
-          case 'M': os->write(reinterpret_cast<const char *>
-                              (node->surface - node->rlength + node->length),
-                              node->rlength);
+          case '%': addLiteral(format, '%'); continue;
+          case 'S': case 'L': case 'm': case 'M': case 'h': case 'c':
+          case 'H': case 't': case 's': case 'P':
             break;
-          case 'h': *os << node->posid; break;  // Part-Of-Speech ID
-          case '%': *os << '%'; break;         // %
-          case 'c': *os << static_cast<int>(node->wcost); break;  // word cost
-          case 'H': *os << node->feature; break;
-          case 't': *os << static_cast<unsigned int>(node->char_type); break;
-          case 's': *os << static_cast<unsigned int>(node->stat); break;
-          case 'P': *os << node->prob; break;
           case 'p': {
-            switch (*++p) {
+            op.sub = *++p;
+            switch (op.sub) {
               default: CHECK_FALSE(false)
                   << "[iseSCwcnblLh] is required after %p";
-              case 'i': *os << node->id; break;  // node id
-              case 'S': os->write(reinterpret_cast<const char*>
-                                  (node->surface -
-                                   node->rlength + node->length),
-                                  node->rlength - node->length);
-                break;  // space
-                // start position
-              case 's': *os << static_cast<int>(node->surface - sentence);
-                break;
-                // end position
-              case 'e': *os << static_cast<int>
-                    (node->surface - sentence + node->length);
-                break;
-                // connection cost
-              case 'C': *os << node->cost -
-                    node->prev->cost - node->wcost;
+              case 'i': case 'S': case 's': case 'e': case 'C': case 'w':
+              case 'c': case 'n': case 'b': case 'P': case 'A': case 'B':
+              case 'l': case 'L':
                 break;
-              case 'w': *os << node->wcost; break;  // word cost
-              case 'c': *os << node->cost; break;  // best cost
-              case 'n': *os << (node->cost - node->prev->cost); break;
-                // node cost
-                // * if best path, otherwise ' '
-              case 'b': *os << (node->isbest ? '*' : ' '); break;
-              case 'P': *os << node->prob; break;
-              case 'A': *os << node->alpha; break;
-              case 'B': *os << node->beta; break;
-              case 'l': *os << node->length; break;  // length of morph
-                // length of morph including the spaces
-              case 'L': *os << node->rlength;    break;
-              case 'h': {  // Hidden Layer ID
-                switch (*++p) {
-                  default: CHECK_FALSE(false) << "lr is required after %ph";
-                  case 'l': *os << node->lcAttr; break;   // current
-                  case 'r': *os << node->rcAttr; break;   // prev
-                }
+              case 'h': {
+                op.arg = *++p;
+                CHECK_FALSE(op.arg == 'l' || op.arg == 'r')
+                    << "lr is required after %ph";
               } break;
-
               case 'p': {
-                char mode = *++p;
-                char sep = *++p;
-                if (sep == '\\') sep = getEscapedChar(*++p);
-                CHECK_FALSE(node->lpath)
-                    << "no path information, use -l option";
-                for (Path *path = node->lpath; path; path = path->lnext) {
-                  if (path != node->lpath) *os << sep;
-                  switch (mode) {
-                    case 'i': *os << path->lnode->id; break;
-                    case 'c': *os << path->cost; break;
-                    case 'P': *os << path->prob; break;
-                    default: CHECK_FALSE(false)
-                        << "[icP] is required after %pp";
-                  }
-                }
+                op.arg = *++p;
+                op.sep = *++p;
+                if (op.sep == '\\') op.sep = getEscapedChar(*++p);
+                CHECK_FALSE(op.arg == 'i' || op.arg == 'c' || op.arg == 'P')
+                    << "[icP] is required after %pp";
               } break;
-
             }
           } break;
 
           case 'F':
           case 'f': {
-            CHECK_FALSE(node->feature[0] != '\0')
-                << "no feature information available";
-
-            if (!psize) {
-              std::strncpy(buf, node->feature, sizeof(buf));
-              psize = tokenizeCSV(buf, ptr, sizeof(ptr));
-            }
-
             // separator
-            char separator = '\t';  // default separator
+            op.sep = '\t';  // default separator
             if (*p == 'F') {  // change separator
               if (*++p == '\\')
-                separator = getEscapedChar(*++p);
+                op.sep = getEscapedChar(*++p);
               else
-                separator = *p;
+                op.sep = *p;
             }
+            op.type = 'f';
 
             CHECK_FALSE(*++p =='[') << "cannot find '['";
+            op.begin = format->fields.size();
             size_t n = 0;
-            bool sep = false;
-            bool isfil = false;
-            p++;
-
-            for (;; ++p) {
-              switch (*p) {
-                case '0': case '1': case '2': case '3': case '4':
-                case '5': case '6': case '7': case '8': case '9':
-                  n = 10 * n +(*p - '0');
-                  break;
-                case ',': case ']':
-                  CHECK_FALSE(n < psize) << "given index is out of range";
-                  isfil = (ptr[n][0] != '*');
-                  if (isfil) {
-                    if (sep) *os << separator;
-                    *os << ptr[n];
-                  }
-                  if (*p == ']') goto last;
-                  sep = isfil;
-                  n = 0;
-                  break;
-                default:
-                  CHECK_FALSE(false) << "cannot find ']'";
+            for (++p; ; ++p) {
+              if (*p >= '0' && *p <= '9') {
+                n = 10 * n +(*p - '0');
+              } else if (*p == ',' || *p == ']') {
+                format->fields.push_back(n);
+                format->max_field = _max(format->max_field, n);
+                n = 0;
+                if (*p == ']') break;
+              } else {
+                CHECK_FALSE(false) << "cannot find ']'";
               }
             }
-          } last: break;
+            op.size = format->fields.size() - op.begin;
+          } break;
         }  // end switch
+        format->ops.push_back(op);
       } break;  // end case '%'
     }  // end switch
   }
 
   return true;
 }
+
+bool Writer::writeNode(StringBuffer *os, const Format &format,
+                       const char *sentence, const Node *node) {
+  const size_t max_size = 64;
+  char buf[BUF_SIZE];
+  const char *columns[max_size];
+  size_t lengths[max_size];
+  size_t psize = 0;
+
+  for (std::vector<FormatOp>::const_iterator it = format.ops.begin();
+       it != format.ops.end(); ++it) {
+    switch (it->type) {
+      case 0: os->write(format.text.data() + it->begin, it->size); break;
+        // input sentence
+      case 'S': os->write(sentence, std::strlen(sentence)); break;
+        // sentence length
+      case 'L': *os << std::strlen(sentence); break;
+        // morph
+      case 'm': os->write(node->surface, node->length); break;
+      case 'M': os->write(reinterpret_cast<const char *>
+                          (node->surface - node->rlength + node->length),
+                          node->rlength);
+        break;
+      case 'h': *os << node->posid; break;  // Part-Of-Speech ID
+      case 'c': *os << static_cast<int>(node->wcost); break;  // word cost
+      case 'H': *os << node->feature; break;
+      case 't': *os << static_cast<unsigned int>(node->char_type); break;
+      case 's': *os << static_cast<unsigned int>(node->stat); break;
+      case 'P': *os << node->prob; break;
+      case 'p': {
+        switch (it->sub) {
+          case 'i': *os << node->id; break;  // node id
+          case 'S': os->write(reinterpret_cast<const char*>
+                              (node->surface -
+                               node->rlength + node->length),
+                              node->rlength - node->length);
+            break;  // space
+            // start position
+          case 's': *os << static_cast<int>(node->surface - sentence);
+            break;
+            // end position
+          case 'e': *os << static_cast<int>
+                (node->surface - sentence + node->length);
+            break;
+            // connection cost
+          case 'C': *os << node->cost -
+                node->prev->cost - node->wcost;
+            break;
+          case 'w': *os << node->wcost; break;  // word cost
+          case 'c': *os << node->cost; break;  // best cost
+          case 'n': *os << (node->cost - node->prev->cost); break;
+            // node cost
+            // * if best path, otherwise ' '
+          case 'b': *os << (node->isbest ? '*' : ' '); break;
+          case 'P': *os << node->prob; break;
+          case 'A': *os << node->alpha; break;
+          case 'B': *os << node->beta; break;
+          case 'l': *os << node->length; break;  // length of morph
+            // length of morph including the spaces
+          case 'L': *os << node->rlength;    break;
+          case 'h': {  // Hidden Layer ID
+            if (it->arg == 'l')
+              *os << node->lcAttr;   // current
+            else
+              *os << node->rcAttr;   // prev
+          } break;
+
+          case 'p': {
+            CHECK_FALSE(node->lpath)
+                << "no path information, use -l option";
+            for (Path *path = node->lpath; path; path = path->lnext) {
+              if (path != node->lpath) *os << it->sep;
+              switch (it->arg) {
+                case 'i': *os << path->lnode->id; break;
+                case 'c': *os << path->cost; break;
+                case 'P': *os << path->prob; break;
+              }
+            }
+          } break;
+        }
+      } break;
+
+      case 'f': {
+        CHECK_FALSE(node->feature[0] != '\0')
+            << "no feature information available";
+
+        // only the columns up to the maximum index are split, which refer
+        // into the feature, unless a quoted column is unescaped in buf
+        if (!psize) {
+          const size_t max = _min(max_size, format.max_field + 1);
+          psize = splitFeature(node->feature, columns, lengths, max);
+          if (!psize) {
+            char *ptr[max_size + 1];
+            const size_t len = _min(std::strlen(node->feature),
+                                    sizeof(buf) - 1);
+            std::memcpy(buf, node->feature, len);
+            buf[len] = '\0';
+            psize = _min(tokenizeCSV(buf, ptr, max + 1), max);
+            for (size_t i = 0; i < psize; ++i) {
+              columns[i] = ptr[i];
+              lengths[i] = std::strlen(ptr[i]);
+            }
+          }
+        }
+
+        bool sep = false;
+        for (size_t i = it->begin; i < it->begin + it->size; ++i) {
+          const size_t n = format.fields[i];
+          CHECK_FALSE(n < psize) << "given index is out of range";
+          const bool isfil = (lengths[n] == 0 || columns[n][0] != '*');
+          if (isfil) {
+            if (sep) *os << it->sep;
+            os->write(columns[n], lengths[n]);
+          }
+          sep = isfil;
+        }
+      } break;
+    }  // end switch
+  }
+
+  return true;
+}
 }
@@ -5,6 +5,7 @@
 //  Copyright(C) 2001-2006 Taku Kudo <taku@chasen.org>
 //  Copyright(C) 2004-2006 Nippon Telegraph and Telephone Corporation
 #include <string>
+#include <vector>
 #include "mecab.h"
 #include "utils.h"
 #include "scoped_ptr.h"
@@ -15,12 +16,35 @@ namespace MeCab {
 class Param;
 
 class Writer {
+ public:
+  // an instruction of compiled format, which is either a literal span
+  // or a macro after '%'.
+  struct FormatOp {
+    char   type;   // 0 for literal span, 'f' for feature fields, or macro
+    char   sub;    // the char after %p
+    char   arg;    // the char after %ph, or the mode after %pp
+    char   sep;    // the separator of %f, %F and %pp
+    size_t begin;  // the offset in text for literal, or in fields
+    size_t size;   // the byte length of literal, or the number of fields
+  };
+
+  // a format string compiled into instructions, in which the escapes are
+  // resolved and the column indices of %f[N] are parsed in advance.
+  struct Format {
+    std::string           text;
+    std::vector<FormatOp> ops;
+    std::vector<size_t>   fields;
+    size_t                max_field;
+  };
+
+  bool compile(const char *fmt, Format *format);
+
  private:
-  scoped_string  node_format_;
-  scoped_string  bos_format_;
-  scoped_string  eos_format_;
-  scoped_string  unk_format_;
-  scoped_string  eon_format_;
+  Format  node_format_;
+  Format  bos_format_;
+  Format  eos_format_;
+  Format  unk_format_;
+  Format  eon_format_;
   whatlog what_;
 
   bool writeLattice(StringBuffer *s, const char *sent, const Node *node);
@@ -39,6 +63,8 @@ class Writer {
   void close();
   bool writeNode(StringBuffer *os, const char *fmt,
                  const char *sent, const Node* node);
+  bool writeNode(StringBuffer *os, const Format &format,
+                 const char *sent, const Node* node);
   bool writeNode(StringBuffer *os,
                  const char *sent, const Node *node);
   bool write(StringBuffer *os, const char *sent, const Node *node);
@@ -0,0 +1,107 @@
+/** \file morpheme_columns.cpp
+ * Implementation of class MorphemeColumns.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma/morpheme_columns.h"
+
+#include <cassert>
+#include <cstring> // strlen
+
+using namespace std;
+
+namespace jma
+{
+
+void MorphemeColumns::StringColumn::append(const char* str, unsigned int length)
+{
+    Span span;
+    span.offset_ = arena_.size();
+    span.length_ = length;
+    spans_.push_back(span);
+    arena_.append(str, length);
+}
+
+void MorphemeColumns::StringColumn::get(unsigned int i, std::string& str) const
+{
+    assert(i < spans_.size());
+
+    const Span& span = spans_[i];
+    str.assign(arena_, span.offset_, span.length_);
+}
+
+void MorphemeColumns::StringColumn::clear()
+{
+    arena_.clear();
+    spans_.clear();
+}
+
+unsigned int MorphemeColumns::size() const
+{
+    return posCodes_.size();
+}
+
+void MorphemeColumns::clear()
+{
+    lexicons_.clear();
+    posCodes_.clear();
+    posStrs_.clear();
+    termIds_.clear();
+    baseForms_.clear();
+    readForms_.clear();
+    normForms_.clear();
+    byteSpans_.clear();
+    charSpans_.clear();
+}
+
+void MorphemeColumns::append(const MorphemeView& view)
+{
+    lexicons_.append(view.lexicon_, view.lexiconLength_);
+    posCodes_.push_back(view.posCode_);
+    posStrs_.append(view.posStr_, strlen(view.posStr_));
+    termIds_.push_back(view.termId_);
+    baseForms_.append(view.baseForm_, view.baseFormLength_);
+    readForms_.append(view.readForm_, view.readFormLength_);
+    normForms_.append(view.normForm_, view.normFormLength_);
+
+    Span span;
+    span.offset_ = view.byteOffset_;
+    span.length_ = view.byteLength_;
+    byteSpans_.push_back(span);
+    span.offset_ = view.charOffset_;
+    span.length_ = view.charLength_;
+    charSpans_.push_back(span);
+}
+
+void MorphemeColumns::toMorphemeList(MorphemeList& list) const
+{
+    const unsigned int count = size();
+    const unsigned int start = list.size();
+    list.resize(start + count);
+
+    for(unsigned int i=0; i<count; ++i)
+    {
+        Morpheme& morph = list[start + i];
+        lexicons_.get(i, morph.lexicon_);
+        morph.posCode_ = posCodes_[i];
+        posStrs_.get(i, morph.posStr_);
+        baseForms_.get(i, morph.baseForm_);
+        readForms_.get(i, morph.readForm_);
+        normForms_.get(i, morph.normForm_);
+        morph.byteOffset_ = byteSpans_[i].offset_;
+        morph.byteLength_ = byteSpans_[i].length_;
+        morph.charOffset_ = charSpans_[i].offset_;
+        morph.charLength_ = charSpans_[i].length_;
+    }
+}
+
+void MorphemeColumns::appendTo(Sentence& sentence) const
+{
+    MorphemeList list;
+    toMorphemeList(list);
+    sentence.addList(list, 1.0);
+}
+
+} // namespace jma
@@ -0,0 +1,22 @@
+/** \file morpheme_graph.cpp
+ * Implementation of class MorphemeGraph.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma/morpheme_graph.h"
+
+namespace jma
+{
+
+const int MorphemeGraph::BOS_INDEX;
+const int MorphemeGraph::EOS_INDEX;
+
+void MorphemeGraph::clear()
+{
+    nodes_.clear();
+    edges_.clear();
+}
+
+} // namespace jma
@@ -0,0 +1,20 @@
+/** \file morpheme_hierarchy.cpp
+ * Implementation of class MorphemeHierarchy.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma/morpheme_hierarchy.h"
+
+namespace jma
+{
+
+void MorphemeHierarchy::clear()
+{
+    coarse_.clear();
+    fine_.clear();
+    children_.clear();
+}
+
+} // namespace jma
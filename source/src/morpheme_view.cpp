@@ -0,0 +1,37 @@
+/** \file morpheme_view.cpp
+ * Implementation of class MorphemeView.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma/morpheme_view.h"
+
+namespace jma
+{
+
+MorphemeView::MorphemeView()
+    : lexicon_(""), lexiconLength_(0),
+    posCode_(-1), posStr_(""), termId_(-1),
+    baseForm_(""), baseFormLength_(0),
+    readForm_(""), readFormLength_(0),
+    normForm_(""), normFormLength_(0),
+    byteOffset_(0), byteLength_(0), charOffset_(0), charLength_(0)
+{
+}
+
+void MorphemeView::toMorpheme(Morpheme& morph) const
+{
+    morph.lexicon_.assign(lexicon_, lexiconLength_);
+    morph.posCode_ = posCode_;
+    morph.posStr_ = posStr_;
+    morph.baseForm_.assign(baseForm_, baseFormLength_);
+    morph.readForm_.assign(readForm_, readFormLength_);
+    morph.normForm_.assign(normForm_, normFormLength_);
+    morph.byteOffset_ = byteOffset_;
+    morph.byteLength_ = byteLength_;
+    morph.charOffset_ = charOffset_;
+    morph.charLength_ = charLength_;
+}
+
+} // namespace jma
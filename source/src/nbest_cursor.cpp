@@ -0,0 +1,55 @@
+/** \file nbest_cursor.cpp
+ * Implementation of class NBestCursor.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "nbest_cursor.h"
+#include "jma_analyzer.h"
+
+#include <cassert>
+
+namespace jma
+{
+
+NBestCursor::NBestCursor()
+    : analyzer_(0), isOneBest_(false), isEnd_(true)
+{
+}
+
+bool NBestCursor::next()
+{
+    if(isEnd_)
+        return false;
+
+    assert(analyzer_);
+    if(! analyzer_->nextNBest(*this))
+    {
+        isEnd_ = true;
+        return false;
+    }
+
+    return true;
+}
+
+const MorphemeList& NBestCursor::getMorphemeList() const
+{
+    assert(! candidates_.empty() && "NBestCursor::next() should return true before getting the candidate");
+
+    return candidates_.back();
+}
+
+long NBestCursor::getCost() const
+{
+    assert(! costs_.empty() && "NBestCursor::next() should return true before getting the cost");
+
+    return costs_.back();
+}
+
+int NBestCursor::getIndex() const
+{
+    return static_cast<int>(candidates_.size()) - 1;
+}
+
+} // namespace jma
@@ -24,13 +24,12 @@ using namespace std;
 namespace jma
 {
 POSTable::POSTable()
-    : strTableVec_(POS_FORMAT_NUM), tableSize_(0), ruleRoot_(0)
+    : strTableVec_(POS_FORMAT_NUM), tableSize_(0)
 {
 }
 
 POSTable::~POSTable()
 {
-    delete ruleRoot_;
 }
 
 bool POSTable::loadConfig(const char* fileName, MeCab::Iconv& iconv)
@@ -165,9 +164,9 @@ bool POSTable::loadCombineRule(const char* fileName)
 {
     assert(fileName);
 
-    // remove the previous rule Trie if exists
-    delete ruleRoot_;
-    ruleRoot_ = new RuleNode(0, tableSize_);
+    // remove the previous rules if exist
+    ruleStates_.assign(1, RuleNode(0));
+    ruleTransitions_.assign(tableSize_, 0);
 
     // open file
     ifstream from(fileName);
@@ -218,7 +217,7 @@ bool POSTable::loadCombineRule(const char* fileName)
         cout << endl;
 #endif
 
-        RuleNode* node = ruleRoot_;
+        int state = 0;
         bool isValid = true;
         for(it=posVec.begin(); it!=posVec.end()-1; ++it)
         {
@@ -229,10 +228,15 @@ bool POSTable::loadCombineRule(const char* fileName)
                 break;
             }
 
-            if(! node->children_[posIndex])
-                node->children_[posIndex] = new RuleNode(node->level_+1, tableSize_);
+            const unsigned int transIndex = state * tableSize_ + posIndex;
+            if(! ruleTransitions_[transIndex])
+            {
+                ruleTransitions_[transIndex] = ruleStates_.size();
+                ruleStates_.push_back(RuleNode(ruleStates_[state].level_ + 1));
+                ruleTransitions_.resize(ruleTransitions_.size() + tableSize_, 0);
+            }
 
-            node = node->children_[posIndex];
+            state = ruleTransitions_[transIndex];
         }
 
         int targetPOS = getIndexFromAlphaPOS(*it);
@@ -244,8 +248,8 @@ bool POSTable::loadCombineRule(const char* fileName)
         }
 
         // save target only if not assigned before
-        if(node->target_ < 0)
-            node->target_ = targetPOS;
+        if(ruleStates_[state].target_ < 0)
+            ruleStates_[state].target_ = targetPOS;
     }
 
 #if JMA_DEBUG_PRINT
@@ -259,24 +263,26 @@ const RuleNode* POSTable::getCombineRule(int startPOS, const MeCab::Node* nextNo
 {
     assert(startPOS >=0 && nextNode);
 
-    const RuleNode* ruleNode = 0;
-    const RuleNode* result = 0;
-
     // check whether "compound.def" is loaded
-    if(ruleRoot_)
-        ruleNode = ruleRoot_->children_[startPOS];
+    if(ruleStates_.empty() || startPOS >= tableSize_)
+        return 0;
+
+    const RuleNode* result = 0;
+    const int* transitions = &ruleTransitions_[0];
+    int state = transitions[startPOS];
 
     const MeCab::Node* tokenNode = nextNode;
-    while(ruleNode)
+    while(state)
     {
-        if(ruleNode->target_ >= 0)
-            result = ruleNode;
+        const RuleNode& ruleNode = ruleStates_[state];
+        if(ruleNode.target_ >= 0)
+            result = &ruleNode;
 
         // in case of tokenNode is EOS node
-        if(! tokenNode->next)
+        if(! tokenNode->next || tokenNode->posid >= tableSize_)
             break;
 
-        ruleNode = ruleNode->children_[(int)tokenNode->posid];
+        state = transitions[state * tableSize_ + tokenNode->posid];
         tokenNode = tokenNode->next;
     }
 
@@ -0,0 +1,55 @@
+/** \file query_result.cpp
+ * Implementation of class QueryResult.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma/query_result.h"
+
+#include <cassert>
+
+namespace jma
+{
+
+const unsigned int QueryResult::INLINE_CAPACITY;
+
+QueryResult::QueryResult()
+    : size_(0)
+{
+}
+
+void QueryResult::clear()
+{
+    moreViews_.clear();
+    size_ = 0;
+}
+
+void QueryResult::push_back(const MorphemeView& view)
+{
+    if(size_ < INLINE_CAPACITY)
+        inlineViews_[size_] = view;
+    else
+        moreViews_.push_back(view);
+
+    ++size_;
+}
+
+unsigned int QueryResult::size() const
+{
+    return size_;
+}
+
+bool QueryResult::empty() const
+{
+    return size_ == 0;
+}
+
+const MorphemeView& QueryResult::operator[](unsigned int i) const
+{
+    assert(i < size_);
+
+    return i < INLINE_CAPACITY ? inlineViews_[i] : moreViews_[i - INLINE_CAPACITY];
+}
+
+} // namespace jma
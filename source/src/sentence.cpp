@@ -15,12 +15,14 @@ namespace jma
 {
 
 Morpheme::Morpheme()
-    : posCode_(-1)
+    : posCode_(-1),
+    byteOffset_(0), byteLength_(0), charOffset_(0), charLength_(0)
 {
 }
 
 Morpheme::Morpheme(const std::string& lexicon, int posCode, const std::string& posStr, const std::string& baseForm, const std::string& readForm, const std::string& normForm)
-    : lexicon_(lexicon), posCode_(posCode), posStr_(posStr), baseForm_(baseForm), readForm_(readForm), normForm_(normForm)
+    : lexicon_(lexicon), posCode_(posCode), posStr_(posStr), baseForm_(baseForm), readForm_(readForm), normForm_(normForm),
+    byteOffset_(0), byteLength_(0), charOffset_(0), charLength_(0)
 {
 
 }
@@ -0,0 +1,227 @@
+/** \file sentence_splitter.cpp
+ * Implementation of class SentenceSplitter.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "sentence_splitter.h"
+#include "jma_ctype.h"
+
+#include <cassert>
+#include <cstring> // memcpy
+
+using namespace std;
+
+namespace
+{
+/** the count of byte values */
+const unsigned int BYTE_NUM = 256;
+
+/** the maximum count of anchor bytes to scan a word at a time, otherwise each byte is checked */
+const unsigned int MAX_SCAN_ANCHORS = 4;
+
+/** the bits with the lowest bit of each byte set in a word */
+const unsigned long LOW_BITS = ~0UL / 0xFF;
+
+/** the bits with the highest bit of each byte set in a word */
+const unsigned long HIGH_BITS = LOW_BITS * 0x80;
+
+/**
+ * Check whether a word contains a zero byte.
+ * \param word the word value
+ * \return true for containing, false for not
+ */
+inline bool hasZeroByte(unsigned long word)
+{
+    return ((word - LOW_BITS) & ~word & HIGH_BITS) != 0;
+}
+
+/**
+ * Append a span.
+ * \param begin the paragraph start
+ * \param start the span start
+ * \param end the span end
+ * \param spans the list to append
+ */
+inline void appendSpan(const unsigned char* begin, const unsigned char* start, const unsigned char* end, jma::SentenceSpanList& spans)
+{
+    jma::SentenceSpan span;
+    span.offset_ = start - begin;
+    span.length_ = end - start;
+    spans.push_back(span);
+}
+}
+
+namespace jma
+{
+
+SentenceSplitter::SentenceSplitter()
+    : ctype_(0), isSelfSync_(false), transitions_(BYTE_NUM, 0), accepts_(1, false)
+{
+    memset(anchorMasks_, 0, sizeof(anchorMasks_));
+}
+
+void SentenceSplitter::build(const std::set<std::string>& separators, const JMA_CType* ctype, bool isSelfSync)
+{
+    assert(ctype);
+    ctype_ = ctype;
+    isSelfSync_ = isSelfSync;
+
+    // the root state is 0
+    transitions_.assign(BYTE_NUM, 0);
+    accepts_.assign(1, false);
+    memset(anchorMasks_, 0, sizeof(anchorMasks_));
+    anchorWords_.clear();
+
+    for(set<string>::const_iterator it=separators.begin(); it!=separators.end(); ++it)
+    {
+        // only a single character could be matched as separator
+        const string& sep = *it;
+        if(sep.empty() || ctype->getByteCount(sep.c_str()) != sep.size())
+            continue;
+
+        int state = 0;
+        for(unsigned int i=0; i<sep.size(); ++i)
+        {
+            const unsigned char c = static_cast<unsigned char>(sep[i]);
+            const unsigned int index = state * BYTE_NUM + c;
+            if(! transitions_[index])
+            {
+                transitions_[index] = accepts_.size();
+                accepts_.push_back(false);
+                transitions_.resize(transitions_.size() + BYTE_NUM, 0);
+            }
+            state = transitions_[index];
+        }
+        accepts_[state] = true;
+
+        // the lead byte of multi-byte character is shared by many characters,
+        // such as hiragana and ideographic full stop in UTF-8,
+        // so that the byte following it is used as anchor to find fewer candidates
+        const unsigned int anchor = (isSelfSync_ && sep.size() > 1) ? 1 : 0;
+        anchorMasks_[static_cast<unsigned char>(sep[anchor])] |= (1 << anchor);
+    }
+
+    vector<unsigned long> anchorWords;
+    for(unsigned int c=0; c<BYTE_NUM; ++c)
+    {
+        if(anchorMasks_[c])
+            anchorWords.push_back(LOW_BITS * c);
+    }
+
+    if(anchorWords.size() <= MAX_SCAN_ANCHORS)
+        anchorWords_.swap(anchorWords);
+}
+
+unsigned int SentenceSplitter::match(const unsigned char* p, const unsigned char* end) const
+{
+    int state = 0;
+    for(const unsigned char* q = p; q < end; ++q)
+    {
+        state = transitions_[state * BYTE_NUM + *q];
+        if(! state)
+            return 0;
+
+        if(accepts_[state])
+            return q + 1 - p;
+    }
+
+    return 0;
+}
+
+const unsigned char* SentenceSplitter::findAnchor(const unsigned char* p, const unsigned char* end) const
+{
+    const unsigned int anchorNum = anchorWords_.size();
+    while(p < end)
+    {
+        // skip the words without any anchor byte
+        if(anchorNum)
+        {
+            while(static_cast<size_t>(end - p) >= sizeof(unsigned long))
+            {
+                unsigned long word;
+                memcpy(&word, p, sizeof(word));
+
+                bool hasAnchor = false;
+                for(unsigned int i=0; i<anchorNum && ! hasAnchor; ++i)
+                    hasAnchor = hasZeroByte(word ^ anchorWords_[i]);
+
+                if(hasAnchor)
+                    break;
+                p += sizeof(unsigned long);
+            }
+        }
+
+        // check each byte in the next word
+        const unsigned char* wordEnd = static_cast<size_t>(end - p) > sizeof(unsigned long) ? p + sizeof(unsigned long) : end;
+        for(; p < wordEnd; ++p)
+        {
+            if(anchorMasks_[*p])
+                return p;
+        }
+    }
+
+    return end;
+}
+
+void SentenceSplitter::split(const char* str, unsigned int length, SentenceSpanList& spans, const unsigned char* charLengths) const
+{
+    assert(str);
+
+    const unsigned char* begin = reinterpret_cast<const unsigned char*>(str);
+    const unsigned char* end = begin + length;
+    const unsigned char* start = begin;
+
+    if(accepts_.size() > 1)
+    {
+        if(isSelfSync_)
+        {
+            for(const unsigned char* q = findAnchor(begin, end); q < end; q = findAnchor(q + 1, end))
+            {
+                // match the separators whose anchor is at q, not starting before the last separator
+                for(unsigned int anchor=0, mask=anchorMasks_[*q]; mask; ++anchor, mask >>= 1)
+                {
+                    if(! (mask & 1) || static_cast<unsigned int>(q - start) < anchor)
+                        continue;
+
+                    const unsigned char* p = q - anchor;
+                    const unsigned int sepLength = match(p, end);
+                    if(sepLength)
+                    {
+                        p += sepLength;
+                        appendSpan(begin, start, p, spans);
+                        start = p;
+                        q = p - 1;
+                        break;
+                    }
+                }
+            }
+        }
+        else
+        {
+            // match the separators at each character start
+            for(const unsigned char* p = begin; p < end; )
+            {
+                unsigned int charLength = charLengths ? charLengths[p - begin]
+                    : ctype_->getByteCount(reinterpret_cast<const char*>(p));
+                if(charLength == 0 || charLength > static_cast<unsigned int>(end - p))
+                    charLength = end - p;
+
+                const bool isSep = transitions_[*p] && match(p, end) == charLength;
+                p += charLength;
+                if(isSep)
+                {
+                    appendSpan(begin, start, p, spans);
+                    start = p;
+                }
+            }
+        }
+    }
+
+    // in case the last character is not sentence separator
+    if(start < end)
+        appendSpan(begin, start, end, spans);
+}
+
+} // namespace jma
@@ -0,0 +1,234 @@
+/** \file stream_pipeline.cpp
+ * Implementation of class StreamPipeline.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "stream_pipeline.h"
+
+#ifdef JMA_USE_STREAM_PIPELINE
+
+#include "jma_analyzer.h"
+#include "thread.h" // MeCab::thread
+
+#include <cassert>
+#include <istream>
+#include <ostream>
+
+using namespace std;
+
+namespace
+{
+/** the number of lines in a batch */
+const unsigned int STREAM_BATCH_LINES = 64;
+
+/** the number of batches for each worker, so that the reader and writer could run ahead of workers */
+const unsigned int STREAM_BATCH_PER_WORKER = 2;
+
+/**
+ * WorkerThread analyzes the batches from input queue, and pushes them into output queue.
+ */
+class WorkerThread : public MeCab::thread
+{
+public:
+    WorkerThread(const jma::StreamPipeline& pipeline, jma::JMA_Analyzer& analyzer,
+            jma::StreamBatchQueue& inQueue, jma::StreamBatchQueue& outQueue)
+        : pipeline_(pipeline), analyzer_(analyzer), inQueue_(inQueue), outQueue_(outQueue)
+    {}
+
+    void run()
+    {
+        while(jma::StreamBatch* batch = inQueue_.pop())
+        {
+            pipeline_.analyzeBatch(analyzer_, *batch);
+            outQueue_.push(batch);
+        }
+
+        // tell the writer this worker is finished
+        outQueue_.push(0);
+    }
+
+private:
+    const jma::StreamPipeline& pipeline_;
+    jma::JMA_Analyzer& analyzer_;
+    jma::StreamBatchQueue& inQueue_;
+    jma::StreamBatchQueue& outQueue_;
+};
+
+/**
+ * WriterThread writes the batches from output queue in input order, and returns them into free queue.
+ */
+class WriterThread : public MeCab::thread
+{
+public:
+    WriterThread(ostream& out, unsigned int batchNum, unsigned int workerNum,
+            jma::StreamBatchQueue& outQueue, jma::StreamBatchQueue& freeQueue)
+        : out_(out), pending_(batchNum, static_cast<jma::StreamBatch*>(0)), workerNum_(workerNum),
+        outQueue_(outQueue), freeQueue_(freeQueue)
+    {}
+
+    void run()
+    {
+        // as the batches in process have consecutive ids no more than the batch number,
+        // each one has its own slot in pending_
+        const unsigned int batchNum = pending_.size();
+        unsigned long nextId = 0;
+        for(unsigned int finished = 0; finished < workerNum_; )
+        {
+            jma::StreamBatch* batch = outQueue_.pop();
+            if(! batch)
+            {
+                ++finished;
+                continue;
+            }
+
+            pending_[batch->id_ % batchNum] = batch;
+            while(jma::StreamBatch* next = pending_[nextId % batchNum])
+            {
+                out_.write(next->output_.data(), next->output_.size());
+                pending_[nextId % batchNum] = 0;
+                ++nextId;
+                freeQueue_.push(next);
+            }
+        }
+    }
+
+private:
+    ostream& out_;
+    vector<jma::StreamBatch*> pending_;
+    unsigned int workerNum_;
+    jma::StreamBatchQueue& outQueue_;
+    jma::StreamBatchQueue& freeQueue_;
+};
+}
+
+namespace jma
+{
+
+StreamBatchQueue::StreamBatchQueue(unsigned int capacity)
+    : ring_(capacity, static_cast<StreamBatch*>(0)), head_(0), size_(0)
+{
+    assert(capacity > 0);
+
+    pthread_mutex_init(&mutex_, 0);
+    pthread_cond_init(&notEmpty_, 0);
+    pthread_cond_init(&notFull_, 0);
+}
+
+StreamBatchQueue::~StreamBatchQueue()
+{
+    pthread_cond_destroy(&notFull_);
+    pthread_cond_destroy(&notEmpty_);
+    pthread_mutex_destroy(&mutex_);
+}
+
+void StreamBatchQueue::push(StreamBatch* batch)
+{
+    pthread_mutex_lock(&mutex_);
+    while(size_ == ring_.size())
+        pthread_cond_wait(&notFull_, &mutex_);
+
+    ring_[(head_ + size_) % ring_.size()] = batch;
+    ++size_;
+
+    pthread_cond_signal(&notEmpty_);
+    pthread_mutex_unlock(&mutex_);
+}
+
+StreamBatch* StreamBatchQueue::pop()
+{
+    pthread_mutex_lock(&mutex_);
+    while(size_ == 0)
+        pthread_cond_wait(&notEmpty_, &mutex_);
+
+    StreamBatch* batch = ring_[head_];
+    head_ = (head_ + 1) % ring_.size();
+    --size_;
+
+    pthread_cond_signal(&notFull_);
+    pthread_mutex_unlock(&mutex_);
+
+    return batch;
+}
+
+StreamPipeline::StreamPipeline(const std::vector<JMA_Analyzer*>& workers, bool isTokenStream)
+    : workers_(workers), isTokenStream_(isTokenStream)
+{
+    assert(! workers_.empty());
+}
+
+void StreamPipeline::analyzeBatch(JMA_Analyzer& analyzer, StreamBatch& batch) const
+{
+    batch.output_.clear();
+    for(unsigned int i=0; i<batch.count_; ++i)
+    {
+        const char* result = analyzer.runWithString(batch.lines_[i].c_str());
+        if(isTokenStream_)
+        {
+            // each line is a document
+            batch.output_.append(result, analyzer.getOutputLength());
+        }
+        else
+        {
+            batch.output_ += result;
+            batch.output_ += '\n';
+        }
+    }
+}
+
+void StreamPipeline::run(std::istream& in, std::ostream& out)
+{
+    const unsigned int workerNum = workers_.size();
+    const unsigned int batchNum = workerNum * STREAM_BATCH_PER_WORKER;
+
+    vector<StreamBatch> batches(batchNum);
+    // the end marks from workers are also pushed into output queue
+    StreamBatchQueue freeQueue(batchNum);
+    StreamBatchQueue inQueue(batchNum + workerNum);
+    StreamBatchQueue outQueue(batchNum + workerNum);
+    for(unsigned int i=0; i<batchNum; ++i)
+    {
+        batches[i].lines_.resize(STREAM_BATCH_LINES);
+        freeQueue.push(&batches[i]);
+    }
+
+    vector<WorkerThread*> threads;
+    for(unsigned int i=0; i<workerNum; ++i)
+    {
+        threads.push_back(new WorkerThread(*this, *workers_[i], inQueue, outQueue));
+        threads.back()->start();
+    }
+
+    WriterThread writer(out, batchNum, workerNum, outQueue, freeQueue);
+    writer.start();
+
+    // read the lines in the calling thread
+    for(unsigned long id=0; in; ++id)
+    {
+        StreamBatch* batch = freeQueue.pop();
+        batch->id_ = id;
+        batch->count_ = 0;
+        while(batch->count_ < STREAM_BATCH_LINES && getline(in, batch->lines_[batch->count_]))
+            ++batch->count_;
+
+        if(batch->count_ == 0)
+            break;
+
+        inQueue.push(batch);
+    }
+
+    for(unsigned int i=0; i<workerNum; ++i)
+        inQueue.push(0);
+
+    for(unsigned int i=0; i<workerNum; ++i)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+    writer.join();
+}
+
+} // namespace jma
+
+#endif // JMA_USE_STREAM_PIPELINE
@@ -0,0 +1,168 @@
+/** \file term_frequency.cpp
+ * Implementation of class TermFrequency.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma/term_frequency.h"
+
+#include <cassert>
+#include <cstring> // memcmp
+
+using namespace std;
+
+namespace
+{
+/** the initial number of slots */
+const unsigned int INITIAL_SLOT_SIZE = 256;
+}
+
+namespace jma
+{
+
+TermFrequency::TermFrequency(KeyType keyType)
+    : keyType_(keyType), slots_(INITIAL_SLOT_SIZE, 0), total_(0)
+{
+}
+
+void TermFrequency::setKeyType(KeyType keyType)
+{
+    keyType_ = keyType;
+    clear();
+}
+
+TermFrequency::KeyType TermFrequency::getKeyType() const
+{
+    return keyType_;
+}
+
+void TermFrequency::clear()
+{
+    // a small document after a large one only resets its own slots
+    if(entries_.size() * 8 < slots_.size())
+    {
+        const unsigned int mask = slots_.size() - 1;
+        for(unsigned int i=0; i<entries_.size(); ++i)
+        {
+            unsigned int pos = entries_[i].hash_ & mask;
+            while(slots_[pos] != i + 1)
+                pos = (pos + 1) & mask;
+            slots_[pos] = 0;
+        }
+    }
+    else
+        slots_.assign(slots_.size(), 0);
+
+    entries_.clear();
+    arena_.clear();
+    total_ = 0;
+}
+
+unsigned int TermFrequency::hashKey(int termId, const char* str, unsigned int length)
+{
+    if(termId >= 0)
+        return static_cast<unsigned int>(termId) * 2654435761U;
+
+    // FNV-1a
+    unsigned int hash = 2166136261U;
+    for(unsigned int i=0; i<length; ++i)
+    {
+        hash ^= static_cast<unsigned char>(str[i]);
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+unsigned int TermFrequency::findSlot(int termId, const char* str, unsigned int length, unsigned int hash) const
+{
+    const unsigned int mask = slots_.size() - 1;
+    unsigned int pos = hash & mask;
+    for(; slots_[pos]; pos = (pos + 1) & mask)
+    {
+        const Entry& entry = entries_[slots_[pos] - 1];
+        if(entry.hash_ != hash || entry.termId_ != termId)
+            continue;
+
+        if(termId >= 0
+                || (entry.length_ == length && ! memcmp(arena_.data() + entry.offset_, str, length)))
+            break;
+    }
+
+    return pos;
+}
+
+void TermFrequency::grow()
+{
+    slots_.assign(slots_.size() * 2, 0);
+    const unsigned int mask = slots_.size() - 1;
+    for(unsigned int i=0; i<entries_.size(); ++i)
+    {
+        unsigned int pos = entries_[i].hash_ & mask;
+        while(slots_[pos])
+            pos = (pos + 1) & mask;
+        slots_[pos] = i + 1;
+    }
+}
+
+void TermFrequency::add(int termId, const char* str, unsigned int length)
+{
+    assert(str);
+
+    if(keyType_ == KEY_BASE_FORM || termId < 0)
+        termId = -1;
+
+    const unsigned int hash = hashKey(termId, str, length);
+    const unsigned int pos = findSlot(termId, str, length, hash);
+    ++total_;
+
+    if(slots_[pos])
+    {
+        ++entries_[slots_[pos] - 1].count_;
+        return;
+    }
+
+    Entry entry = {termId, static_cast<unsigned int>(arena_.size()), length, 1, hash};
+    arena_.append(str, length);
+    entries_.push_back(entry);
+    slots_[pos] = entries_.size();
+
+    // keep the load factor no more than 0.5
+    if(entries_.size() * 2 > slots_.size())
+        grow();
+}
+
+unsigned int TermFrequency::size() const
+{
+    return entries_.size();
+}
+
+unsigned int TermFrequency::getTotal() const
+{
+    return total_;
+}
+
+const TermFrequency::Entry& TermFrequency::getEntry(unsigned int i) const
+{
+    assert(i < entries_.size());
+
+    return entries_[i];
+}
+
+const char* TermFrequency::getString(const Entry& entry) const
+{
+    return arena_.data() + entry.offset_;
+}
+
+unsigned int TermFrequency::getCount(int termId, const char* str, unsigned int length) const
+{
+    assert(str);
+
+    if(keyType_ == KEY_BASE_FORM || termId < 0)
+        termId = -1;
+
+    const unsigned int pos = findSlot(termId, str, length, hashKey(termId, str, length));
+    return slots_[pos] ? entries_[slots_[pos] - 1].count_ : 0;
+}
+
+} // namespace jma
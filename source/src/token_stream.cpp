@@ -0,0 +1,286 @@
+/** \file token_stream.cpp
+ * Implementation of class TokenStreamWriter and TokenStreamReader.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma/token_stream.h"
+
+#include <cassert>
+#include <cstring> // strlen
+
+using namespace std;
+
+namespace
+{
+/**
+ * Append an unsigned integer as varint.
+ * \param value the value
+ * \param output the output to append
+ */
+inline void writeVarint(unsigned int value, string& output)
+{
+    while(value >= 0x80)
+    {
+        output += static_cast<char>((value & 0x7F) | 0x80);
+        value >>= 7;
+    }
+    output += static_cast<char>(value);
+}
+
+/**
+ * Append a signed integer as zigzag encoded varint.
+ * \param value the value
+ * \param output the output to append
+ */
+inline void writeSignedVarint(int value, string& output)
+{
+    writeVarint((static_cast<unsigned int>(value) << 1) ^ static_cast<unsigned int>(value >> 31), output);
+}
+
+/**
+ * Decode a zigzag encoded integer.
+ * \param value the encoded value
+ * \return the signed integer
+ */
+inline int decodeZigzag(unsigned int value)
+{
+    return static_cast<int>(value >> 1) ^ -static_cast<int>(value & 1);
+}
+
+/**
+ * Append a string with its length.
+ * \param str the string start
+ * \param length the byte length
+ * \param output the output to append
+ */
+inline void writeString(const char* str, unsigned int length, string& output)
+{
+    writeVarint(length, output);
+    output.append(str, length);
+}
+
+/** the maximum bytes of varint for unsigned int */
+const int MAX_VARINT_BYTES = 5;
+}
+
+namespace jma
+{
+
+TokenStreamWriter::TokenStreamWriter(int fields)
+    : fields_(fields), docFields_(fields),
+    tokenCount_(0), prevByteOffset_(0), prevCharOffset_(0)
+{
+}
+
+void TokenStreamWriter::setFields(int fields)
+{
+    fields_ = fields;
+}
+
+int TokenStreamWriter::getFields() const
+{
+    return fields_;
+}
+
+void TokenStreamWriter::beginDocument()
+{
+    docFields_ = fields_;
+    tokenCount_ = 0;
+    prevByteOffset_ = prevCharOffset_ = 0;
+    tokens_.clear();
+}
+
+void TokenStreamWriter::addToken(const MorphemeView& view)
+{
+    writeVarint(view.termId_ + 1, tokens_);
+    writeVarint(view.posCode_ + 1, tokens_);
+    writeSignedVarint(static_cast<int>(view.byteOffset_ - prevByteOffset_), tokens_);
+    writeVarint(view.byteLength_, tokens_);
+    writeSignedVarint(static_cast<int>(view.charOffset_ - prevCharOffset_), tokens_);
+    writeVarint(view.charLength_, tokens_);
+
+    if(docFields_ & TOKEN_STREAM_LEXICON)
+        writeString(view.lexicon_, view.lexiconLength_, tokens_);
+
+    if(docFields_ & TOKEN_STREAM_POS_STR)
+        writeString(view.posStr_, strlen(view.posStr_), tokens_);
+
+    prevByteOffset_ = view.byteOffset_;
+    prevCharOffset_ = view.charOffset_;
+    ++tokenCount_;
+}
+
+void TokenStreamWriter::endDocument(std::string& output, unsigned int textLength)
+{
+    string header;
+    writeVarint(docFields_, header);
+    writeVarint(tokenCount_, header);
+    writeVarint(textLength, header);
+
+    writeVarint(header.size() + tokens_.size(), output);
+    output += header;
+    output += tokens_;
+
+    beginDocument();
+}
+
+TokenStreamReader::TokenStreamReader(const char* data, unsigned int length)
+    : pos_(data), end_(data + length), docEnd_(data),
+    fields_(0), tokenCount_(0), readCount_(0), textLength_(0),
+    prevByteOffset_(0), prevCharOffset_(0),
+    isError_(false)
+{
+    assert(data || length == 0);
+}
+
+bool TokenStreamReader::readVarint(const char*& p, const char* end, unsigned int& value)
+{
+    value = 0;
+    for(int i=0; i<MAX_VARINT_BYTES && p<end; ++i)
+    {
+        const unsigned char c = static_cast<unsigned char>(*p++);
+
+        // the last byte has only 4 bits left for unsigned int
+        if(i == MAX_VARINT_BYTES - 1 && (c & 0x70))
+            break;
+
+        value |= static_cast<unsigned int>(c & 0x7F) << (7 * i);
+        if(! (c & 0x80))
+            return true;
+    }
+
+    isError_ = true;
+    return false;
+}
+
+bool TokenStreamReader::readRange(const char*& p, unsigned int prevOffset, unsigned int& offset, unsigned int& length)
+{
+    unsigned int delta;
+    if(! readVarint(p, docEnd_, delta) || ! readVarint(p, docEnd_, length))
+        return false;
+
+    // neither before the text start nor after the text end, written in this way to avoid overflow
+    const int offsetDelta = decodeZigzag(delta);
+    if(offsetDelta < 0 ? static_cast<unsigned int>(-(offsetDelta + 1)) >= prevOffset
+            : static_cast<unsigned int>(offsetDelta) > textLength_ - prevOffset)
+    {
+        isError_ = true;
+        return false;
+    }
+
+    offset = prevOffset + offsetDelta;
+    if(length > textLength_ - offset)
+    {
+        isError_ = true;
+        return false;
+    }
+
+    return true;
+}
+
+bool TokenStreamReader::readString(const char*& p, const char* end, const char*& str, unsigned int& length)
+{
+    if(! readVarint(p, end, length))
+        return false;
+
+    if(length > static_cast<unsigned int>(end - p))
+    {
+        isError_ = true;
+        return false;
+    }
+
+    str = p;
+    p += length;
+    return true;
+}
+
+bool TokenStreamReader::nextDocument()
+{
+    if(isError_)
+        return false;
+
+    // skip the rest tokens
+    pos_ = docEnd_;
+    tokenCount_ = readCount_ = textLength_ = 0;
+    prevByteOffset_ = prevCharOffset_ = 0;
+
+    if(pos_ == end_)
+        return false;
+
+    unsigned int length = 0;
+    if(! readVarint(pos_, end_, length))
+        return false;
+
+    if(length > static_cast<unsigned int>(end_ - pos_))
+    {
+        isError_ = true;
+        return false;
+    }
+    docEnd_ = pos_ + length;
+
+    unsigned int fields = 0;
+    if(! readVarint(pos_, docEnd_, fields)
+            || ! readVarint(pos_, docEnd_, tokenCount_)
+            || ! readVarint(pos_, docEnd_, textLength_))
+        return false;
+    fields_ = fields;
+
+    return true;
+}
+
+bool TokenStreamReader::nextToken(TokenRecord& token)
+{
+    if(isError_ || readCount_ >= tokenCount_)
+        return false;
+
+    // as a character has at least one byte, the character range is also within the text byte length
+    unsigned int termId, posCode;
+    if(! readVarint(pos_, docEnd_, termId)
+            || ! readVarint(pos_, docEnd_, posCode)
+            || ! readRange(pos_, prevByteOffset_, token.byteOffset_, token.byteLength_)
+            || ! readRange(pos_, prevCharOffset_, token.charOffset_, token.charLength_))
+        return false;
+
+    token.termId_ = static_cast<int>(termId) - 1;
+    token.posCode_ = static_cast<int>(posCode) - 1;
+
+    token.lexicon_ = token.posStr_ = "";
+    token.lexiconLength_ = token.posStrLength_ = 0;
+
+    if((fields_ & TOKEN_STREAM_LEXICON)
+            && ! readString(pos_, docEnd_, token.lexicon_, token.lexiconLength_))
+        return false;
+
+    if((fields_ & TOKEN_STREAM_POS_STR)
+            && ! readString(pos_, docEnd_, token.posStr_, token.posStrLength_))
+        return false;
+
+    prevByteOffset_ = token.byteOffset_;
+    prevCharOffset_ = token.charOffset_;
+    ++readCount_;
+    return true;
+}
+
+int TokenStreamReader::getFields() const
+{
+    return fields_;
+}
+
+unsigned int TokenStreamReader::getTokenCount() const
+{
+    return tokenCount_;
+}
+
+unsigned int TokenStreamReader::getTextLength() const
+{
+    return textLength_;
+}
+
+bool TokenStreamReader::isError() const
+{
+    return isError_;
+}
+
+} // namespace jma
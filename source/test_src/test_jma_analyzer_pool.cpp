@@ -0,0 +1,259 @@
+/** \file test_jma_analyzer_pool.cpp
+ * Compare the ways to analyze requests from multiple threads: locking a global analyzer,
+ * creating an analyzer for each request, and checking out an analyzer from AnalyzerPool.
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To analyze each line in "INPUT" as a request by "THREAD_NUM" threads (the default value is 4),
+ * and print the elapsed time and throughput of each way, and the pool statistics.
+ * $ ./jma_analyzer_pool INPUT [--dict DICT_PATH] [--num THREAD_NUM]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+#include "thread.h" // MeCab::thread
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sys/time.h> // gettimeofday
+#include <pthread.h>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+
+    /** optional command option for thread number */
+    const char* OPTION_THREAD_NUM = "--num";
+
+    /** the ratio of requests analyzed when an analyzer is created for each request, as it is too slow */
+    const unsigned int CREATE_REQUEST_RATIO = 50;
+
+    /**
+     * The ways to get an analyzer for each request.
+     */
+    enum Mode
+    {
+        MODE_GLOBAL_LOCK, ///< lock a global analyzer
+        MODE_CREATE, ///< create an analyzer
+        MODE_POOL ///< check out from pool
+    };
+
+    /** the global analyzer and its lock */
+    Analyzer* gAnalyzer = 0;
+    pthread_mutex_t gMutex = PTHREAD_MUTEX_INITIALIZER;
+}
+
+/**
+ * RequestThread analyzes the requests in lines [begin, end) with step.
+ */
+class RequestThread : public MeCab::thread
+{
+public:
+    Mode mode_;
+    const vector<string>* lines_;
+    unsigned int begin_;
+    unsigned int step_;
+    Knowledge* knowledge_;
+    AnalyzerPool* pool_;
+    unsigned long bytes_;
+
+    RequestThread() : mode_(MODE_POOL), lines_(0), begin_(0), step_(1), knowledge_(0), pool_(0), bytes_(0) {}
+
+    void run()
+    {
+        for(unsigned int i=begin_; i<lines_->size(); i+=step_)
+        {
+            const char* request = (*lines_)[i].c_str();
+            switch(mode_)
+            {
+            case MODE_GLOBAL_LOCK:
+                pthread_mutex_lock(&gMutex);
+                bytes_ += strlen(gAnalyzer->runWithString(request));
+                pthread_mutex_unlock(&gMutex);
+                break;
+
+            case MODE_CREATE:
+            {
+                Analyzer* analyzer = JMA_Factory::instance()->createAnalyzer();
+                if(analyzer->setKnowledge(knowledge_))
+                    bytes_ += strlen(analyzer->runWithString(request));
+                delete analyzer;
+                break;
+            }
+
+            case MODE_POOL:
+            {
+                AnalyzerPool::Handle handle(*pool_);
+                if(handle.get())
+                    bytes_ += strlen(handle->runWithString(request));
+                break;
+            }
+            }
+        }
+    }
+};
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_analyzer_pool INPUT [--dict DICT_PATH] [--num THREAD_NUM]" << endl;
+}
+
+/**
+ * Get the current wall time in seconds.
+ */
+double getWallTime()
+{
+    timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/**
+ * Analyze the requests by threads, and print the time.
+ */
+void runThreads(const char* name, Mode mode, const vector<string>& lines, int threadNum, Knowledge* knowledge, AnalyzerPool* pool)
+{
+    vector<RequestThread*> threads;
+    for(int i=0; i<threadNum; ++i)
+    {
+        RequestThread* thread = new RequestThread;
+        thread->mode_ = mode;
+        thread->lines_ = &lines;
+        thread->begin_ = i;
+        thread->step_ = threadNum;
+        thread->knowledge_ = knowledge;
+        thread->pool_ = pool;
+        threads.push_back(thread);
+    }
+
+    double stime = getWallTime();
+    for(int i=0; i<threadNum; ++i)
+        threads[i]->start();
+
+    unsigned long bytes = 0;
+    for(int i=0; i<threadNum; ++i)
+    {
+        threads[i]->join();
+        bytes += threads[i]->bytes_;
+        delete threads[i];
+    }
+    const double time = getWallTime() - stime;
+
+    cout << name << ": " << lines.size() << " requests, " << time << " seconds";
+    if(time > 0)
+        cout << ", " << lines.size() / time << " requests/s";
+    cout << ", output bytes " << bytes << endl;
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    int threadNum = 4;
+    for(int optIndex = 2; optIndex + 1 < argc; optIndex += 2)
+    {
+        if(! strcmp(argv[optIndex], OPTION_DICT))
+            sysdict = argv[optIndex + 1];
+        else if(! strcmp(argv[optIndex], OPTION_THREAD_NUM))
+            threadNum = atoi(argv[optIndex + 1]);
+        else
+        {
+            printUsage();
+            exit(1);
+        }
+    }
+
+    if(threadNum <= 0)
+    {
+        cerr << "the thread number should be positive" << endl;
+        exit(1);
+    }
+
+    ifstream in(argv[1]);
+    if(! in)
+    {
+        cerr << "fail to open file " << argv[1] << endl;
+        exit(1);
+    }
+
+    vector<string> lines;
+    string line;
+    while(getline(in, line))
+        lines.push_back(line);
+
+    // create instances
+    JMA_Factory* factory = JMA_Factory::instance();
+    Knowledge* knowledge = factory->createKnowledge();
+
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    gAnalyzer = factory->createAnalyzer();
+    if(gAnalyzer->setKnowledge(knowledge) == 0)
+    {
+        cerr << "fail to set knowledge" << endl;
+        exit(1);
+    }
+
+    AnalyzerPool* pool = factory->createAnalyzerPool(knowledge, threadNum);
+    if(! pool)
+    {
+        cerr << "fail to create analyzer pool" << endl;
+        exit(1);
+    }
+
+    cout << "threads: " << threadNum << endl;
+
+    runThreads("global lock", MODE_GLOBAL_LOCK, lines, threadNum, knowledge, pool);
+
+    vector<string> createLines;
+    for(unsigned int i=0; i<lines.size(); i+=CREATE_REQUEST_RATIO)
+        createLines.push_back(lines[i]);
+    runThreads("create per request", MODE_CREATE, createLines, threadNum, knowledge, pool);
+
+    runThreads("analyzer pool", MODE_POOL, lines, threadNum, knowledge, pool);
+
+    AnalyzerPool::Statistics stat;
+    pool->getStatistics(stat);
+    cout << "pool size: " << stat.size_ << " / " << stat.maxSize_
+        << ", checkouts: " << stat.checkoutCount_
+        << ", affinity: " << stat.affinityCount_
+        << ", waits: " << stat.waitCount_
+        << ", wait time: " << stat.waitTime_ << " seconds"
+        << ", max wait time: " << stat.maxWaitTime_ << " seconds"
+        << ", created: " << stat.createCount_ << endl;
+
+    delete pool;
+    delete gAnalyzer;
+    delete knowledge;
+
+    return 0;
+}
@@ -0,0 +1,209 @@
+/** \file test_jma_batch.cpp
+ * Compare the analysis of sentences by Analyzer::runBatch() using multiple threads with Analyzer::runWithSentence().
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To split the raw input file "INPUT" into sentences, and analyze them by 1, 2, 4, ... threads up to "MAX_THREAD" (the default value is 8),
+ * in the input order and also in skewed order with the long sentences together,
+ * and print the elapsed time and speedup of each thread number, and whether the results are the same as runWithSentence().
+ * $ ./jma_batch INPUT [--dict DICT_PATH] [--max MAX_THREAD]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm> // stable_sort
+
+#include <sys/time.h> // gettimeofday
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+
+    /** optional command option for the maximum thread number */
+    const char* OPTION_MAX_THREAD = "--max";
+
+    /**
+     * Compare the sentences by string length in descending order.
+     */
+    bool longerThan(const Sentence& a, const Sentence& b)
+    {
+        return strlen(a.getString()) > strlen(b.getString());
+    }
+}
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_batch INPUT [--dict DICT_PATH] [--max MAX_THREAD]" << endl;
+}
+
+/**
+ * Get the current wall time in seconds, as the CPU time is summed over threads.
+ */
+double getWallTime()
+{
+    timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/**
+ * Check whether the one-best results are the same.
+ */
+bool isSameResult(const vector<Sentence>& expect, const vector<Sentence>& actual)
+{
+    if(expect.size() != actual.size())
+        return false;
+
+    for(unsigned int i=0; i<expect.size(); ++i)
+    {
+        if(expect[i].getListSize() != actual[i].getListSize())
+            return false;
+
+        if(expect[i].getListSize() == 0)
+            continue;
+
+        if(expect[i].getCount(0) != actual[i].getCount(0))
+            return false;
+
+        for(int j=0; j<expect[i].getCount(0); ++j)
+        {
+            if(strcmp(expect[i].getLexicon(0, j), actual[i].getLexicon(0, j))
+                    || expect[i].getPOS(0, j) != actual[i].getPOS(0, j))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Analyze the sentences by each thread number, and compare the results with runWithSentence().
+ */
+bool runThreads(Analyzer* analyzer, const vector<Sentence>& sentences, int maxThread, long bytes)
+{
+    vector<Sentence> expect(sentences);
+    double stime = getWallTime();
+    for(unsigned int i=0; i<expect.size(); ++i)
+        analyzer->runWithSentence(expect[i]);
+    const double serialTime = getWallTime() - stime;
+    cout << "runWithSentence(): " << serialTime << " seconds";
+    if(serialTime > 0)
+        cout << ", " << bytes / serialTime / (1024 * 1024) << " MB/s";
+    cout << endl;
+
+    bool isSame = true;
+    for(int threadNum = 1; threadNum <= maxThread; threadNum *= 2)
+    {
+        vector<Sentence> actual(sentences);
+        stime = getWallTime();
+        if(analyzer->runBatch(actual, threadNum) == 0)
+        {
+            cerr << "fail to analyze by " << threadNum << " threads" << endl;
+            return false;
+        }
+        const double time = getWallTime() - stime;
+
+        const bool isSameOutput = isSameResult(expect, actual);
+        isSame = isSame && isSameOutput;
+
+        cout << "runBatch() threads " << threadNum << ": " << time << " seconds";
+        if(time > 0)
+            cout << ", " << bytes / time / (1024 * 1024) << " MB/s, speedup " << serialTime / time;
+        cout << ", result " << (isSameOutput ? "same" : "DIFFERENT") << endl;
+    }
+
+    return isSame;
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    int maxThread = 8;
+    for(int optIndex = 2; optIndex + 1 < argc; optIndex += 2)
+    {
+        if(! strcmp(argv[optIndex], OPTION_DICT))
+            sysdict = argv[optIndex + 1];
+        else if(! strcmp(argv[optIndex], OPTION_MAX_THREAD))
+            maxThread = atoi(argv[optIndex + 1]);
+        else
+        {
+            printUsage();
+            exit(1);
+        }
+    }
+
+    ifstream in(argv[1]);
+    if(! in)
+    {
+        cerr << "fail to open file " << argv[1] << endl;
+        exit(1);
+    }
+
+    // create instances
+    JMA_Factory* factory = JMA_Factory::instance();
+    Analyzer* analyzer = factory->createAnalyzer();
+    Knowledge* knowledge = factory->createKnowledge();
+
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    if(analyzer->setKnowledge(knowledge) == 0)
+    {
+        cerr << "fail to set knowledge" << endl;
+        exit(1);
+    }
+
+    vector<Sentence> sentences;
+    string line;
+    while(getline(in, line))
+        analyzer->splitSentence(line.c_str(), sentences);
+
+    long bytes = 0;
+    for(unsigned int i=0; i<sentences.size(); ++i)
+        bytes += strlen(sentences[i].getString());
+
+    cout << "sentences: " << sentences.size() << ", bytes: " << bytes << endl;
+
+    cout << "input order" << endl;
+    bool isSame = runThreads(analyzer, sentences, maxThread, bytes);
+
+    cout << "skewed order" << endl;
+    stable_sort(sentences.begin(), sentences.end(), longerThan);
+    isSame = runThreads(analyzer, sentences, maxThread, bytes) && isSame;
+
+    delete knowledge;
+    delete analyzer;
+
+    return isSame ? 0 : 1;
+}
@@ -0,0 +1,198 @@
+/** \file test_jma_convert.cpp
+ * Benchmark the character conversion (Analyzer::convertCharacters()) against applying each conversion table in order.
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To convert each line in the raw input file "INPUT" into Hiragana, half width and lower case,
+ * and print the time of each way.
+ * $ ./jma_convert INPUT [--dict DICT_PATH]
+ *
+ * To convert with other conversions, such as into Katakana, full width and upper case.
+ * $ ./jma_convert INPUT --to kata,full,upper [--dict DICT_PATH]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "jma_knowledge.h" // JMA_Knowledge::getKanaTable()
+#include "tokenizer.h" // CTypeTokenizer
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+
+    /** optional command option for the conversions */
+    const char* OPTION_TO = "--to";
+
+    /** the number of conversion types */
+    const int CONVERT_TYPE_NUM = 6;
+
+    /** the conversion type names */
+    const char* CONVERT_NAMES[CONVERT_TYPE_NUM] = {"hira", "kata", "half", "full", "lower", "upper"};
+
+    /** the conversion options in the order of \e CONVERT_NAMES */
+    const Analyzer::OptionType CONVERT_OPTIONS[CONVERT_TYPE_NUM] = {
+        Analyzer::OPTION_TYPE_CONVERT_TO_HIRAGANA,
+        Analyzer::OPTION_TYPE_CONVERT_TO_KATAKANA,
+        Analyzer::OPTION_TYPE_CONVERT_TO_HALF_WIDTH,
+        Analyzer::OPTION_TYPE_CONVERT_TO_FULL_WIDTH,
+        Analyzer::OPTION_TYPE_CONVERT_TO_LOWER_CASE,
+        Analyzer::OPTION_TYPE_CONVERT_TO_UPPER_CASE
+    };
+}
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_convert INPUT [--to hira,kata,half,full,lower,upper] [--dict DICT_PATH]" << endl;
+}
+
+/**
+ * Convert the characters by looking up each enabled table in order.
+ */
+string convertByTables(JMA_Knowledge& knowledge, const bool* isConvert, const char* str)
+{
+    const CharTable* tables[CONVERT_TYPE_NUM] = {
+        &knowledge.getKanaTable(), &knowledge.getKanaTable(),
+        &knowledge.getWidthTable(), &knowledge.getWidthTable(),
+        &knowledge.getCaseTable(), &knowledge.getCaseTable()
+    };
+
+    string result;
+    CTypeTokenizer tokenizer(knowledge.getCType(), str);
+    for(const char* p=tokenizer.next(); p; p=tokenizer.next())
+    {
+        for(int i=0; i<CONVERT_TYPE_NUM; ++i)
+        {
+            if(! isConvert[i])
+                continue;
+
+            const char* q = (i % 2) ? tables[i]->toRight(p) : tables[i]->toLeft(p);
+            if(q)
+                p = q;
+        }
+        result += p;
+    }
+
+    return result;
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    string convertTypes = "hira,half,lower";
+    for(int i=2; i+1<argc; i+=2)
+    {
+        if(! strcmp(argv[i], OPTION_DICT))
+            sysdict = argv[i+1];
+        else if(! strcmp(argv[i], OPTION_TO))
+            convertTypes = argv[i+1];
+        else
+        {
+            printUsage();
+            exit(1);
+        }
+    }
+
+    bool isConvert[CONVERT_TYPE_NUM];
+    for(int i=0; i<CONVERT_TYPE_NUM; ++i)
+    {
+        const string name = string(",") + CONVERT_NAMES[i] + ",";
+        isConvert[i] = (("," + convertTypes + ",").find(name) != string::npos);
+    }
+
+    ifstream in(argv[1]);
+    if(! in)
+    {
+        cerr << "fail to open file " << argv[1] << endl;
+        exit(1);
+    }
+
+    vector<string> sentences;
+    string line;
+    while(getline(in, line))
+    {
+        if(! line.empty())
+            sentences.push_back(line);
+    }
+
+    // create instances
+    JMA_Factory* factory = JMA_Factory::instance();
+    Analyzer* analyzer = factory->createAnalyzer();
+    Knowledge* knowledge = factory->createKnowledge();
+
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    if(analyzer->setKnowledge(knowledge) == 0)
+    {
+        cerr << "fail to set knowledge" << endl;
+        exit(1);
+    }
+
+    for(int i=0; i<CONVERT_TYPE_NUM; ++i)
+        analyzer->setOption(CONVERT_OPTIONS[i], isConvert[i] ? 1 : 0);
+
+    cout << "sentences: " << sentences.size() << ", conversions: " << convertTypes << endl;
+
+    JMA_Knowledge& jmaKnowledge = *static_cast<JMA_Knowledge*>(knowledge);
+    long byteCount = 0;
+    clock_t stime = clock();
+    for(unsigned int i=0; i<sentences.size(); ++i)
+        byteCount += convertByTables(jmaKnowledge, isConvert, sentences[i].c_str()).size();
+    double tableTime = (double)(clock() - stime) / CLOCKS_PER_SEC;
+    cout << "each table in order: " << tableTime << " seconds, output bytes: " << byteCount << endl;
+
+    byteCount = 0;
+    stime = clock();
+    for(unsigned int i=0; i<sentences.size(); ++i)
+        byteCount += analyzer->convertCharacters(sentences[i].c_str()).size();
+    double convertTime = (double)(clock() - stime) / CLOCKS_PER_SEC;
+    cout << "convertCharacters(): " << convertTime << " seconds, output bytes: " << byteCount << endl;
+
+    // check the results
+    int diffCount = 0;
+    for(unsigned int i=0; i<sentences.size(); ++i)
+    {
+        if(convertByTables(jmaKnowledge, isConvert, sentences[i].c_str()) != analyzer->convertCharacters(sentences[i].c_str()))
+            ++diffCount;
+    }
+    cout << "different lines: " << diffCount << endl;
+
+    // destroy instances
+    delete knowledge;
+    delete analyzer;
+
+    return diffCount ? 1 : 0;
+}
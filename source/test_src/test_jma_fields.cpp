@@ -0,0 +1,156 @@
+/** \file test_jma_fields.cpp
+ * Benchmark the one-best analysis with all the morpheme fields and with only the fields given (Analyzer::OPTION_TYPE_MORPHEME_FIELDS).
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To analyze each line in the raw input file "INPUT",
+ * first with all the morpheme fields, then with only the lexicon and POS index code,
+ * and print the time of each run.
+ * $ ./jma_fields INPUT [--dict DICT_PATH]
+ *
+ * To compare with the fields given as the value of Analyzer::OPTION_TYPE_MORPHEME_FIELDS, such as POS string and base form (1 | 2).
+ * $ ./jma_fields INPUT --fields 3 [--dict DICT_PATH]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+
+    /** optional command option for morpheme fields */
+    const char* OPTION_FIELDS = "--fields";
+}
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_fields INPUT [--fields FIELDS] [--dict DICT_PATH]" << endl;
+}
+
+/**
+ * Analyze each sentence with the morpheme fields, and print the statistics.
+ */
+void runBenchmark(Analyzer& analyzer, const vector<string>& sentences, int fields)
+{
+    analyzer.setOption(Analyzer::OPTION_TYPE_MORPHEME_FIELDS, fields);
+
+    long morphCount = 0;
+    long charCount = 0; // to check the fields are used
+
+    clock_t stime = clock();
+    for(unsigned int i=0; i<sentences.size(); ++i)
+    {
+        Sentence s(sentences[i].c_str());
+        if(analyzer.runWithSentence(s) != 1)
+        {
+            cerr << "fail in Analyzer::runWithSentence()" << endl;
+            exit(1);
+        }
+
+        if(s.getListSize() == 0)
+            continue;
+
+        for(int j=0; j<s.getCount(0); ++j)
+        {
+            charCount += strlen(s.getLexicon(0, j)) + strlen(s.getStrPOS(0, j))
+                + strlen(s.getBaseForm(0, j)) + strlen(s.getReadForm(0, j)) + strlen(s.getNormForm(0, j));
+        }
+        morphCount += s.getCount(0);
+    }
+    double dif = (double)(clock() - stime) / CLOCKS_PER_SEC;
+
+    cout << "morpheme fields: " << fields << endl;
+    cout << "\tanalysis time: " << dif << endl;
+    cout << "\tmorphemes: " << morphCount << ", bytes in fields: " << charCount << endl;
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    int fields = 0;
+    for(int i=2; i+1<argc; i+=2)
+    {
+        if(! strcmp(argv[i], OPTION_DICT))
+            sysdict = argv[i+1];
+        else if(! strcmp(argv[i], OPTION_FIELDS))
+            fields = atoi(argv[i+1]);
+        else
+        {
+            printUsage();
+            exit(1);
+        }
+    }
+
+    ifstream in(argv[1]);
+    if(! in)
+    {
+        cerr << "fail to open file " << argv[1] << endl;
+        exit(1);
+    }
+
+    vector<string> sentences;
+    string line;
+    while(getline(in, line))
+    {
+        if(! line.empty())
+            sentences.push_back(line);
+    }
+
+    // create instances
+    JMA_Factory* factory = JMA_Factory::instance();
+    Analyzer* analyzer = factory->createAnalyzer();
+    Knowledge* knowledge = factory->createKnowledge();
+
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    if(analyzer->setKnowledge(knowledge) == 0)
+    {
+        cerr << "fail to set knowledge" << endl;
+        exit(1);
+    }
+
+    cout << "sentences: " << sentences.size() << endl;
+    runBenchmark(*analyzer, sentences, Analyzer::MORPHEME_FIELD_ALL);
+    runBenchmark(*analyzer, sentences, fields);
+
+    // destroy instances
+    delete knowledge;
+    delete analyzer;
+
+    return 0;
+}
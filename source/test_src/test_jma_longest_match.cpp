@@ -0,0 +1,222 @@
+/** \file test_jma_longest_match.cpp
+ * Compare the analysis by greedy longest match with Viterbi search, which is configured by Analyzer::OPTION_TYPE_LONGEST_MATCH.
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To analyze each line in the raw input file "INPUT" in both ways,
+ * and print the time and throughput of each way, and the agreement rate of word boundaries and POS tags.
+ * $ ./jma_longest_match INPUT [--dict DICT_PATH]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "jma_analyzer.h" // JMA_Analyzer::runWithView()
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+
+    /**
+     * Word is the boundary and POS of a morpheme.
+     */
+    struct Word
+    {
+        unsigned int offset_;
+        unsigned int length_;
+        int posCode_;
+    };
+
+    typedef vector<Word> WordList;
+}
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_longest_match INPUT [--dict DICT_PATH]" << endl;
+}
+
+/**
+ * Print the time and throughput.
+ */
+void printTime(const char* name, double time, long bytes)
+{
+    cout << name << ": " << time << " seconds";
+    if(time > 0)
+        cout << ", " << bytes / time / (1024 * 1024) << " MB/s";
+    cout << endl;
+}
+
+/**
+ * Print the ratio in percent.
+ */
+void printRate(const char* name, long count, long total)
+{
+    cout << name << ": " << count << " / " << total;
+    if(total > 0)
+        cout << " = " << 100.0 * count / total << "%";
+    cout << endl;
+}
+
+/**
+ * Analyze each line, and return the time in seconds.
+ */
+double analyzeLines(JMA_Analyzer* analyzer, const vector<string>& lines, vector<WordList>& results)
+{
+    results.resize(lines.size());
+
+    clock_t stime = clock();
+    for(unsigned int i=0; i<lines.size(); ++i)
+    {
+        const MorphemeViewList& views = analyzer->runWithView(lines[i].c_str());
+        WordList& words = results[i];
+        words.resize(views.size());
+        for(unsigned int j=0; j<views.size(); ++j)
+        {
+            words[j].offset_ = views[j].byteOffset_;
+            words[j].length_ = views[j].byteLength_;
+            words[j].posCode_ = views[j].posCode_;
+        }
+    }
+
+    return (double)(clock() - stime) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    if(argc == 4 && ! strcmp(argv[2], OPTION_DICT))
+    {
+        sysdict = argv[3];
+    }
+
+    ifstream in(argv[1]);
+    if(! in)
+    {
+        cerr << "fail to open file " << argv[1] << endl;
+        exit(1);
+    }
+
+    vector<string> lines;
+    long bytes = 0;
+    string line;
+    while(getline(in, line))
+    {
+        if(! line.empty())
+        {
+            lines.push_back(line);
+            bytes += line.size();
+        }
+    }
+
+    // create instances
+    JMA_Factory* factory = JMA_Factory::instance();
+    Analyzer* analyzer = factory->createAnalyzer();
+    Knowledge* knowledge = factory->createKnowledge();
+
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    if(analyzer->setKnowledge(knowledge) == 0)
+    {
+        cerr << "fail to set knowledge" << endl;
+        exit(1);
+    }
+
+    JMA_Analyzer* jmaAnalyzer = dynamic_cast<JMA_Analyzer*>(analyzer);
+    if(! jmaAnalyzer)
+    {
+        cerr << "fail to get JMA_Analyzer" << endl;
+        exit(1);
+    }
+
+    cout << "lines: " << lines.size() << ", bytes: " << bytes << endl;
+
+    // only the boundaries and POS codes are compared
+    analyzer->setOption(Analyzer::OPTION_TYPE_MORPHEME_FIELDS, 0);
+
+    vector<WordList> viterbiResults;
+    printTime("Viterbi search", analyzeLines(jmaAnalyzer, lines, viterbiResults), bytes);
+
+    analyzer->setOption(Analyzer::OPTION_TYPE_LONGEST_MATCH, 1);
+    vector<WordList> longestResults;
+    printTime("longest match", analyzeLines(jmaAnalyzer, lines, longestResults), bytes);
+
+    // the words in the same boundary, and also in the same POS
+    long viterbiCount = 0, longestCount = 0, boundaryCount = 0, posCount = 0, sameLineCount = 0;
+    for(unsigned int i=0; i<lines.size(); ++i)
+    {
+        const WordList& viterbiWords = viterbiResults[i];
+        const WordList& longestWords = longestResults[i];
+        viterbiCount += viterbiWords.size();
+        longestCount += longestWords.size();
+
+        long lineBoundary = 0, linePOS = 0;
+        unsigned int j = 0, k = 0;
+        while(j < viterbiWords.size() && k < longestWords.size())
+        {
+            const Word& v = viterbiWords[j];
+            const Word& l = longestWords[k];
+            if(v.offset_ == l.offset_ && v.length_ == l.length_)
+            {
+                ++lineBoundary;
+                if(v.posCode_ == l.posCode_)
+                    ++linePOS;
+                ++j;
+                ++k;
+            }
+            else if(v.offset_ + v.length_ <= l.offset_ + l.length_)
+                ++j;
+            else
+                ++k;
+        }
+
+        boundaryCount += lineBoundary;
+        posCount += linePOS;
+        if(linePOS == static_cast<long>(viterbiWords.size()) && linePOS == static_cast<long>(longestWords.size()))
+            ++sameLineCount;
+    }
+
+    cout << "words in Viterbi search: " << viterbiCount << ", in longest match: " << longestCount << endl;
+    printRate("boundary precision", boundaryCount, longestCount);
+    printRate("boundary recall", boundaryCount, viterbiCount);
+    printRate("boundary and POS recall", posCount, viterbiCount);
+    printRate("identical lines", sameLineCount, lines.size());
+
+    // destroy instances
+    delete knowledge;
+    delete analyzer;
+
+    return 0;
+}
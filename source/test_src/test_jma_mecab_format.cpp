@@ -0,0 +1,177 @@
+/** \file test_jma_mecab_format.cpp
+ * Benchmark the output of MeCab::Tagger::parse() in user defined formats.
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To analyze each line in the raw input file "INPUT" by MeCab tagger in the output formats below,
+ * save the output into "OUTPUT", and print the time and throughput, and the time of formatting nodes only.
+ * $ ./jma_mecab_format INPUT OUTPUT [--dict DICT_PATH]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "mecab.h" // MeCab::createTagger()
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+
+    /** the times to format each node */
+    const int FORMAT_REPEAT = 10;
+
+    /** the tagger options of output formats */
+    const char* FORMAT_OPTIONS[] = {
+        // no output, for the time of parsing only
+        "-Onone",
+        // default lattice format
+        "",
+        // surface and feature columns
+        "-F%m\\t%f[0]\\t%f[1]\\t%f[2]\\t%f[3]\\t%f[4]\\t%f[5]\\t%f[6]\\n -U%m\\t%H\\n -EEOS\\n",
+        // feature columns, positions and costs
+        "-F%m\\t%f[0],%f[1]\\t%F-[0,1,2,3]\\t%f[6]|%f[7]|%f[8]\\t%pS%ps-%pe\\t%h,%c,%pw,%pn,%pC,%pc,%pb,%pl,%pL,%phl,%phr,%t,%s\\n"
+            " -U%m\\t%F_[0,1]\\t%M|%pi\\t%%\\s\\n -B[%S]\\n -EEOS\\t%L\\n",
+        // paths in lattice
+        "-l1 -F%m\\t%ppc,%ppi;\\n -U%m\\t?\\n -EEOS\\n"
+    };
+}
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_mecab_format INPUT OUTPUT [--dict DICT_PATH]" << endl;
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 3)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    if(argc == 5 && ! strcmp(argv[3], OPTION_DICT))
+    {
+        sysdict = argv[4];
+    }
+
+    ifstream in(argv[1]);
+    if(! in)
+    {
+        cerr << "fail to open file " << argv[1] << endl;
+        exit(1);
+    }
+
+    ofstream out(argv[2]);
+    if(! out)
+    {
+        cerr << "fail to open file " << argv[2] << endl;
+        exit(1);
+    }
+
+    vector<string> lines;
+    long bytes = 0;
+    string line;
+    while(getline(in, line))
+    {
+        if(! line.empty())
+        {
+            lines.push_back(line);
+            bytes += line.size();
+        }
+    }
+
+    // the dictionary files are loaded by knowledge
+    JMA_Factory* factory = JMA_Factory::instance();
+    Knowledge* knowledge = factory->createKnowledge();
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    const unsigned int formatNum = sizeof(FORMAT_OPTIONS) / sizeof(FORMAT_OPTIONS[0]);
+    for(unsigned int i=0; i<formatNum; ++i)
+    {
+        string taggerParam("-d ");
+        taggerParam += sysdict;
+        taggerParam += " ";
+        taggerParam += FORMAT_OPTIONS[i];
+
+        MeCab::Tagger* tagger = MeCab::createTagger(taggerParam.c_str());
+        if(! tagger)
+        {
+            cerr << "fail to create tagger with " << taggerParam << ": " << MeCab::getTaggerError() << endl;
+            exit(1);
+        }
+
+        long outBytes = 0;
+        clock_t stime = clock();
+        for(unsigned int j=0; j<lines.size(); ++j)
+        {
+            const char* result = tagger->parse(lines[j].c_str());
+            if(! result)
+            {
+                cerr << "fail to parse line " << j << ": " << tagger->what() << endl;
+                exit(1);
+            }
+            out << result;
+            outBytes += strlen(result);
+        }
+        double time = (double)(clock() - stime) / CLOCKS_PER_SEC;
+
+        cout << "format " << i << ": " << time << " seconds";
+        if(time > 0)
+            cout << ", " << bytes / time / (1024 * 1024) << " MB/s";
+        cout << ", output " << outBytes << " bytes" << endl;
+
+        // the time of formatting each node, which excludes the time of parsing
+        stime = clock();
+        for(unsigned int j=0; j<lines.size(); ++j)
+            tagger->parseToNode(lines[j].c_str());
+        const clock_t parseTime = clock() - stime;
+
+        stime = clock();
+        for(unsigned int j=0; j<lines.size(); ++j)
+        {
+            const MeCab::Node* bosNode = tagger->parseToNode(lines[j].c_str());
+            for(int r=0; r<FORMAT_REPEAT; ++r)
+            {
+                // the nodes except begin and end of sentence
+                for(const MeCab::Node* node = bosNode->next; node->next; node = node->next)
+                    tagger->formatNode(node);
+            }
+        }
+        time = (double)(clock() - stime - parseTime) / CLOCKS_PER_SEC / FORMAT_REPEAT;
+        cout << "format " << i << ": " << time << " seconds in formatting nodes" << endl;
+
+        delete tagger;
+    }
+
+    delete knowledge;
+
+    return 0;
+}
@@ -0,0 +1,158 @@
+/** \file test_jma_nbest_gap.cpp
+ * Benchmark the n-best analysis with and without the limit on cost gap (Analyzer::OPTION_TYPE_NBEST_COST_GAP).
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To analyze each line in the raw input file "INPUT" for 10-best results,
+ * first without cost gap limit, then with the cost gap limit 3000,
+ * and print the time, the number of results and agenda size of each run.
+ * $ ./jma_nbest_gap INPUT 10 3000 [--dict DICT_PATH]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "jma_analyzer.h" // JMA_Analyzer::getNBestAgendaSize()
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+}
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_nbest_gap INPUT N-best COST_GAP [--dict DICT_PATH]" << endl;
+}
+
+/**
+ * Analyze each sentence in n-best with cost gap limit, and print the statistics.
+ */
+void runBenchmark(JMA_Analyzer& analyzer, const vector<string>& sentences, int nbest, double costGap)
+{
+    analyzer.setOption(Analyzer::OPTION_TYPE_NBEST, nbest);
+    analyzer.setOption(Analyzer::OPTION_TYPE_NBEST_COST_GAP, costGap);
+
+    long resultCount = 0;
+    size_t totalAgenda = 0;
+    size_t maxAgenda = 0;
+
+    clock_t stime = clock();
+    for(unsigned int i=0; i<sentences.size(); ++i)
+    {
+        Sentence s(sentences[i].c_str());
+        if(analyzer.runWithSentence(s) != 1)
+        {
+            cerr << "fail in Analyzer::runWithSentence()" << endl;
+            exit(1);
+        }
+
+        resultCount += s.getListSize();
+        size_t agenda = analyzer.getNBestAgendaSize();
+        totalAgenda += agenda;
+        if(agenda > maxAgenda)
+            maxAgenda = agenda;
+    }
+    double dif = (double)(clock() - stime) / CLOCKS_PER_SEC;
+
+    double count = sentences.empty() ? 1 : sentences.size();
+    cout << "cost gap: " << costGap << endl;
+    cout << "\tanalysis time: " << dif << endl;
+    cout << "\taverage results per sentence: " << resultCount / count << endl;
+    cout << "\taverage agenda size: " << totalAgenda / count << endl;
+    cout << "\tmaximum agenda size: " << maxAgenda << endl;
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 4)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    if(argc == 6 && ! strcmp(argv[4], OPTION_DICT))
+    {
+        sysdict = argv[5];
+    }
+
+    int nbest = atoi(argv[2]);
+    double costGap = atof(argv[3]);
+    if(nbest < 2)
+    {
+        cerr << "the n-best value should be at least 2" << endl;
+        exit(1);
+    }
+
+    ifstream in(argv[1]);
+    if(! in)
+    {
+        cerr << "fail to open file " << argv[1] << endl;
+        exit(1);
+    }
+
+    vector<string> sentences;
+    string line;
+    while(getline(in, line))
+    {
+        if(! line.empty())
+            sentences.push_back(line);
+    }
+
+    // create instances
+    JMA_Factory* factory = JMA_Factory::instance();
+    Analyzer* analyzer = factory->createAnalyzer();
+    Knowledge* knowledge = factory->createKnowledge();
+
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    if(analyzer->setKnowledge(knowledge) == 0)
+    {
+        cerr << "fail to set knowledge" << endl;
+        exit(1);
+    }
+
+    JMA_Analyzer* jmaAnalyzer = dynamic_cast<JMA_Analyzer*>(analyzer);
+    if(! jmaAnalyzer)
+    {
+        cerr << "fail to get JMA_Analyzer" << endl;
+        exit(1);
+    }
+
+    cout << "sentences: " << sentences.size() << ", n-best: " << nbest << endl;
+    runBenchmark(*jmaAnalyzer, sentences, nbest, 0);
+    runBenchmark(*jmaAnalyzer, sentences, nbest, costGap);
+
+    // destroy instances
+    delete knowledge;
+    delete analyzer;
+
+    return 0;
+}
@@ -0,0 +1,258 @@
+/** \file test_jma_query.cpp
+ * Benchmark the latency of short queries by JMA_Analyzer::runWithQuery() against Analyzer::runWithSentence().
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To analyze each query in each line of the query log "INPUT" in both ways for "ROUNDS" times (10 defaultly),
+ * and print the latency percentiles and the heap allocations of each way,
+ * the workspaces are preallocated for the queries no longer than "MAX_LENGTH" bytes (64 defaultly).
+ * $ ./jma_query INPUT [--dict DICT_PATH] [--rounds ROUNDS] [--length MAX_LENGTH]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "jma_analyzer.h" // JMA_Analyzer::runWithQuery()
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm> // sort
+#include <new> // bad_alloc
+
+#include <ctime> // clock_gettime
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+
+    /** optional command option for the number of rounds */
+    const char* OPTION_ROUNDS = "--rounds";
+
+    /** optional command option for the maximum byte length of query */
+    const char* OPTION_LENGTH = "--length";
+
+    /** the number of heap allocations */
+    long allocCount = 0;
+}
+
+/**
+ * Count each heap allocation.
+ */
+void* operator new(size_t size) throw(std::bad_alloc)
+{
+    ++allocCount;
+    void* p = malloc(size ? size : 1);
+    if(! p)
+        throw std::bad_alloc();
+    return p;
+}
+
+void operator delete(void* p) throw()
+{
+    free(p);
+}
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_query INPUT [--dict DICT_PATH] [--rounds ROUNDS] [--length MAX_LENGTH]" << endl;
+}
+
+/**
+ * Get the current time in nanoseconds.
+ */
+long long getNanoTime()
+{
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+/**
+ * Print the latency percentiles in microseconds, and the heap allocations.
+ */
+void printLatency(const char* name, vector<long long>& latencies, long allocs, long allocQueries)
+{
+    sort(latencies.begin(), latencies.end());
+    const unsigned int size = latencies.size();
+    long long total = 0;
+    for(unsigned int i=0; i<size; ++i)
+        total += latencies[i];
+
+    cout << name << ": ";
+    if(size)
+    {
+        cout << "mean " << total / size / 1000.0 << " us"
+            << ", p50 " << latencies[size / 2] / 1000.0 << " us"
+            << ", p99 " << latencies[size * 99 / 100] / 1000.0 << " us"
+            << ", p999 " << latencies[size * 999 / 1000] / 1000.0 << " us"
+            << ", max " << latencies[size - 1] / 1000.0 << " us";
+    }
+    cout << endl;
+    cout << name << ": " << allocs << " heap allocations, in " << allocQueries << " of " << size << " queries" << endl;
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    int rounds = 10;
+    unsigned int maxLength = 64;
+    for(int i=2; i+1<argc; i+=2)
+    {
+        if(! strcmp(argv[i], OPTION_DICT))
+            sysdict = argv[i+1];
+        else if(! strcmp(argv[i], OPTION_ROUNDS))
+            rounds = atoi(argv[i+1]);
+        else if(! strcmp(argv[i], OPTION_LENGTH))
+            maxLength = atoi(argv[i+1]);
+        else
+        {
+            printUsage();
+            exit(1);
+        }
+    }
+
+    ifstream in(argv[1]);
+    if(! in)
+    {
+        cerr << "fail to open file " << argv[1] << endl;
+        exit(1);
+    }
+
+    vector<string> queries;
+    string line;
+    while(getline(in, line))
+    {
+        if(! line.empty() && line.size() <= maxLength)
+            queries.push_back(line);
+    }
+
+    // create instances
+    JMA_Factory* factory = JMA_Factory::instance();
+    Analyzer* analyzer = factory->createAnalyzer();
+    Knowledge* knowledge = factory->createKnowledge();
+
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    if(analyzer->setKnowledge(knowledge) == 0)
+    {
+        cerr << "fail to set knowledge" << endl;
+        exit(1);
+    }
+
+    JMA_Analyzer* jmaAnalyzer = dynamic_cast<JMA_Analyzer*>(analyzer);
+    if(! jmaAnalyzer)
+    {
+        cerr << "fail to get JMA_Analyzer" << endl;
+        exit(1);
+    }
+
+    cout << "queries: " << queries.size() << " not longer than " << maxLength << " bytes, rounds: " << rounds << endl;
+
+    vector<long long> latencies;
+    latencies.reserve(queries.size() * rounds);
+    long allocs = 0, allocQueries = 0;
+
+    // sentence API, in which the first round is for warming up
+    for(int r=0; r<=rounds; ++r)
+    {
+        for(unsigned int i=0; i<queries.size(); ++i)
+        {
+            const long allocStart = allocCount;
+            const long long start = getNanoTime();
+            Sentence sentence(queries[i].c_str());
+            analyzer->runWithSentence(sentence);
+            const long long end = getNanoTime();
+
+            if(r)
+            {
+                latencies.push_back(end - start);
+                allocs += allocCount - allocStart;
+                if(allocCount != allocStart)
+                    ++allocQueries;
+            }
+        }
+    }
+    printLatency("runWithSentence()", latencies, allocs, allocQueries);
+
+    // query profile
+    jmaAnalyzer->setQueryProfile(maxLength);
+    QueryResult result;
+    latencies.clear();
+    allocs = allocQueries = 0;
+    for(int r=0; r<=rounds; ++r)
+    {
+        for(unsigned int i=0; i<queries.size(); ++i)
+        {
+            const long allocStart = allocCount;
+            const long long start = getNanoTime();
+            jmaAnalyzer->runWithQuery(queries[i].c_str(), result);
+            const long long end = getNanoTime();
+
+            if(r)
+            {
+                latencies.push_back(end - start);
+                allocs += allocCount - allocStart;
+                if(allocCount != allocStart)
+                    ++allocQueries;
+            }
+        }
+    }
+    printLatency("runWithQuery()", latencies, allocs, allocQueries);
+
+    // the same morphemes as runWithView()
+    unsigned int diffCount = 0;
+    for(unsigned int i=0; i<queries.size(); ++i)
+    {
+        jmaAnalyzer->runWithQuery(queries[i].c_str(), result);
+        vector<string> queryWords;
+        for(unsigned int j=0; j<result.size(); ++j)
+            queryWords.push_back(string(result[j].lexicon_, result[j].lexiconLength_) + "/" + result[j].posStr_);
+
+        const MorphemeViewList& views = jmaAnalyzer->runWithView(queries[i].c_str());
+        vector<string> viewWords;
+        for(unsigned int j=0; j<views.size(); ++j)
+            viewWords.push_back(string(views[j].lexicon_, views[j].lexiconLength_) + "/" + views[j].posStr_);
+
+        if(queryWords != viewWords)
+        {
+            if(! diffCount)
+                cerr << "different morphemes in query " << i << ": " << queries[i] << endl;
+            ++diffCount;
+        }
+    }
+    cout << "queries of different morphemes: " << diffCount << endl;
+
+    // destroy instances
+    delete knowledge;
+    delete analyzer;
+
+    return diffCount ? 1 : 0;
+}
@@ -0,0 +1,151 @@
+/** \file test_jma_segment.cpp
+ * Benchmark the segmentation only by JMA_Analyzer::runWithSegment() against the full analysis by Analyzer::runWithString().
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To analyze each line in the raw input file "INPUT" in both ways,
+ * and print the time and throughput of each way, and whether the words are the same.
+ * $ ./jma_segment INPUT [--dict DICT_PATH]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "jma_analyzer.h" // JMA_Analyzer::runWithSegment()
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+}
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_segment INPUT [--dict DICT_PATH]" << endl;
+}
+
+/**
+ * Print the time and throughput.
+ */
+void printTime(const char* name, double time, long bytes)
+{
+    cout << name << ": " << time << " seconds";
+    if(time > 0)
+        cout << ", " << bytes / time / (1024 * 1024) << " MB/s";
+    cout << endl;
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    if(argc == 4 && ! strcmp(argv[2], OPTION_DICT))
+    {
+        sysdict = argv[3];
+    }
+
+    ifstream in(argv[1]);
+    if(! in)
+    {
+        cerr << "fail to open file " << argv[1] << endl;
+        exit(1);
+    }
+
+    vector<string> lines;
+    long bytes = 0;
+    string line;
+    while(getline(in, line))
+    {
+        if(! line.empty())
+        {
+            lines.push_back(line);
+            bytes += line.size();
+        }
+    }
+
+    // create instances
+    JMA_Factory* factory = JMA_Factory::instance();
+    Analyzer* analyzer = factory->createAnalyzer();
+    Knowledge* knowledge = factory->createKnowledge();
+
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    if(analyzer->setKnowledge(knowledge) == 0)
+    {
+        cerr << "fail to set knowledge" << endl;
+        exit(1);
+    }
+
+    JMA_Analyzer* jmaAnalyzer = dynamic_cast<JMA_Analyzer*>(analyzer);
+    if(! jmaAnalyzer)
+    {
+        cerr << "fail to get JMA_Analyzer" << endl;
+        exit(1);
+    }
+
+    cout << "lines: " << lines.size() << ", bytes: " << bytes << endl;
+
+    // full analysis with POS tags
+    clock_t stime = clock();
+    for(unsigned int i=0; i<lines.size(); ++i)
+        analyzer->runWithString(lines[i].c_str());
+    printTime("runWithString()", (double)(clock() - stime) / CLOCKS_PER_SEC, bytes);
+
+    // word boundaries only
+    vector<string> surfaces(lines.size());
+    stime = clock();
+    for(unsigned int i=0; i<lines.size(); ++i)
+        jmaAnalyzer->runWithSegment(lines[i].c_str(), surfaces[i]);
+    printTime("runWithSegment()", (double)(clock() - stime) / CLOCKS_PER_SEC, bytes);
+
+    // the words of full analysis without POS tags
+    analyzer->setOption(Analyzer::OPTION_TYPE_POS_TAGGING, 0);
+    unsigned int diffCount = 0;
+    for(unsigned int i=0; i<lines.size(); ++i)
+    {
+        if(surfaces[i] != analyzer->runWithString(lines[i].c_str()))
+        {
+            if(! diffCount)
+                cerr << "different words in line " << i << endl;
+            ++diffCount;
+        }
+    }
+    cout << "lines of different words: " << diffCount << endl;
+
+    // destroy instances
+    delete knowledge;
+    delete analyzer;
+
+    return diffCount ? 1 : 0;
+}
@@ -0,0 +1,207 @@
+/** \file test_jma_split_span.cpp
+ * Benchmark the sentence split into spans (JMA_Analyzer::splitSentence() with SentenceSpanList)
+ * against checking each character in separator set, and against the split into Sentence list.
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To split each line in the raw input file "INPUT" 10 times in each way, and print the time of each way.
+ * $ ./jma_split_span INPUT [--repeat 10] [--dict DICT_PATH]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "jma_analyzer.h" // JMA_Analyzer::splitSentence()
+#include "jma_knowledge.h" // JMA_Knowledge::isSentenceSeparator()
+#include "tokenizer.h" // CTypeTokenizer
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+
+    /** optional command option for the repeat times */
+    const char* OPTION_REPEAT = "--repeat";
+}
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_split_span INPUT [--repeat N] [--dict DICT_PATH]" << endl;
+}
+
+/**
+ * Split the sentences by checking each character in separator set.
+ */
+void splitByCharacters(JMA_Knowledge& knowledge, const char* paragraph, vector<string>& sentences)
+{
+    string sentenceStr;
+    CTypeTokenizer tokenizer(knowledge.getCType(), paragraph);
+    for(const char* p=tokenizer.next(); p; p=tokenizer.next())
+    {
+        sentenceStr += p;
+        if(knowledge.isSentenceSeparator(p))
+        {
+            sentences.push_back(sentenceStr);
+            sentenceStr.clear();
+        }
+    }
+
+    if(! sentenceStr.empty())
+        sentences.push_back(sentenceStr);
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    int repeat = 10;
+    for(int i=2; i+1<argc; i+=2)
+    {
+        if(! strcmp(argv[i], OPTION_DICT))
+            sysdict = argv[i+1];
+        else if(! strcmp(argv[i], OPTION_REPEAT))
+            repeat = atoi(argv[i+1]);
+        else
+        {
+            printUsage();
+            exit(1);
+        }
+    }
+
+    ifstream in(argv[1]);
+    if(! in)
+    {
+        cerr << "fail to open file " << argv[1] << endl;
+        exit(1);
+    }
+
+    vector<string> paragraphs;
+    long byteCount = 0;
+    string line;
+    while(getline(in, line))
+    {
+        if(! line.empty())
+        {
+            paragraphs.push_back(line);
+            byteCount += line.size();
+        }
+    }
+
+    // create instances
+    JMA_Factory* factory = JMA_Factory::instance();
+    Analyzer* analyzer = factory->createAnalyzer();
+    Knowledge* knowledge = factory->createKnowledge();
+
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    if(analyzer->setKnowledge(knowledge) == 0)
+    {
+        cerr << "fail to set knowledge" << endl;
+        exit(1);
+    }
+
+    JMA_Knowledge& jmaKnowledge = *static_cast<JMA_Knowledge*>(knowledge);
+    JMA_Analyzer& jmaAnalyzer = *static_cast<JMA_Analyzer*>(analyzer);
+    cout << "paragraphs: " << paragraphs.size() << ", bytes: " << byteCount << ", repeat: " << repeat << endl;
+
+    long sentCount = 0;
+    vector<string> strVec;
+    clock_t stime = clock();
+    for(int r=0; r<repeat; ++r)
+    {
+        for(unsigned int i=0; i<paragraphs.size(); ++i)
+        {
+            strVec.clear();
+            splitByCharacters(jmaKnowledge, paragraphs[i].c_str(), strVec);
+            sentCount += strVec.size();
+        }
+    }
+    double charTime = (double)(clock() - stime) / CLOCKS_PER_SEC;
+    cout << "each character in separator set: " << charTime << " seconds, sentences: " << sentCount << endl;
+
+    sentCount = 0;
+    vector<Sentence> sentVec;
+    stime = clock();
+    for(int r=0; r<repeat; ++r)
+    {
+        for(unsigned int i=0; i<paragraphs.size(); ++i)
+        {
+            sentVec.clear();
+            analyzer->splitSentence(paragraphs[i].c_str(), sentVec);
+            sentCount += sentVec.size();
+        }
+    }
+    double sentTime = (double)(clock() - stime) / CLOCKS_PER_SEC;
+    cout << "splitSentence() into Sentence: " << sentTime << " seconds, sentences: " << sentCount << endl;
+
+    sentCount = 0;
+    SentenceSpanList spans;
+    stime = clock();
+    for(int r=0; r<repeat; ++r)
+    {
+        for(unsigned int i=0; i<paragraphs.size(); ++i)
+        {
+            spans.clear();
+            jmaAnalyzer.splitSentence(paragraphs[i].c_str(), spans);
+            sentCount += spans.size();
+        }
+    }
+    double spanTime = (double)(clock() - stime) / CLOCKS_PER_SEC;
+    cout << "splitSentence() into spans: " << spanTime << " seconds, sentences: " << sentCount << endl;
+
+    // check the results
+    int diffCount = 0;
+    for(unsigned int i=0; i<paragraphs.size(); ++i)
+    {
+        const char* paragraph = paragraphs[i].c_str();
+        strVec.clear();
+        splitByCharacters(jmaKnowledge, paragraph, strVec);
+        spans.clear();
+        jmaAnalyzer.splitSentence(paragraph, spans);
+
+        bool isSame = (strVec.size() == spans.size());
+        for(unsigned int j=0; isSame && j<spans.size(); ++j)
+            isSame = (strVec[j].compare(0, string::npos, paragraph + spans[j].offset_, spans[j].length_) == 0);
+
+        if(! isSame)
+            ++diffCount;
+    }
+    cout << "different paragraphs: " << diffCount << endl;
+
+    // destroy instances
+    delete knowledge;
+    delete analyzer;
+
+    return diffCount ? 1 : 0;
+}
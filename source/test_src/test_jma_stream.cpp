@@ -0,0 +1,177 @@
+/** \file test_jma_stream.cpp
+ * Compare the analysis of a file by multiple worker threads with one thread, which is configured by Analyzer::OPTION_TYPE_STREAM_WORKER_NUM.
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To analyze the raw input file "INPUT" by runWithStream() in text and token stream format,
+ * using 1, 2, 4, ... worker threads up to "MAX_WORKER" (the default value is 8),
+ * and print the elapsed time and speedup of each worker number, and whether its output is the same as one thread.
+ * The output files are "OUTPUT.text.*" and "OUTPUT.token.*".
+ * $ ./jma_stream INPUT OUTPUT [--dict DICT_PATH] [--max MAX_WORKER]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <iterator>
+
+#include <sys/time.h> // gettimeofday
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+
+    /** optional command option for the maximum worker number */
+    const char* OPTION_MAX_WORKER = "--max";
+}
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_stream INPUT OUTPUT [--dict DICT_PATH] [--max MAX_WORKER]" << endl;
+}
+
+/**
+ * Get the current wall time in seconds, as the CPU time is summed over threads.
+ */
+double getWallTime()
+{
+    timeval tv;
+    gettimeofday(&tv, 0);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
+
+/**
+ * Read the whole file into string.
+ */
+string readFile(const string& fileName)
+{
+    ifstream in(fileName.c_str(), ios::in | ios::binary);
+    return string(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+}
+
+/**
+ * Analyze the file by each worker number, and compare the output with one thread.
+ */
+bool runWorkers(Analyzer* analyzer, const char* input, const string& output, int maxWorker, long bytes)
+{
+    bool isSame = true;
+    double serialTime = 0;
+    string serialOutput;
+    for(int workerNum = 1; workerNum <= maxWorker; workerNum *= 2)
+    {
+        ostringstream ss;
+        ss << output << "." << workerNum;
+        const string fileName = ss.str();
+
+        analyzer->setOption(Analyzer::OPTION_TYPE_STREAM_WORKER_NUM, workerNum);
+        double stime = getWallTime();
+        if(analyzer->runWithStream(input, fileName.c_str()) == 0)
+        {
+            cerr << "fail to analyze by " << workerNum << " workers" << endl;
+            return false;
+        }
+        const double time = getWallTime() - stime;
+
+        cout << "workers " << workerNum << ": " << time << " seconds";
+        if(time > 0)
+            cout << ", " << bytes / time / (1024 * 1024) << " MB/s";
+
+        const string result = readFile(fileName);
+        if(workerNum == 1)
+        {
+            serialTime = time;
+            serialOutput = result;
+            cout << endl;
+        }
+        else
+        {
+            if(time > 0)
+                cout << ", speedup " << serialTime / time;
+
+            const bool isSameOutput = (result == serialOutput);
+            cout << ", output " << (isSameOutput ? "same" : "DIFFERENT") << endl;
+            isSame = isSame && isSameOutput;
+        }
+    }
+
+    return isSame;
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 3)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    int maxWorker = 8;
+    for(int optIndex = 3; optIndex + 1 < argc; optIndex += 2)
+    {
+        if(! strcmp(argv[optIndex], OPTION_DICT))
+            sysdict = argv[optIndex + 1];
+        else if(! strcmp(argv[optIndex], OPTION_MAX_WORKER))
+            maxWorker = atoi(argv[optIndex + 1]);
+        else
+        {
+            printUsage();
+            exit(1);
+        }
+    }
+
+    const long bytes = readFile(argv[1]).size();
+    const string output = argv[2];
+
+    // create instances
+    JMA_Factory* factory = JMA_Factory::instance();
+    Analyzer* analyzer = factory->createAnalyzer();
+    Knowledge* knowledge = factory->createKnowledge();
+
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    if(analyzer->setKnowledge(knowledge) == 0)
+    {
+        cerr << "fail to set knowledge" << endl;
+        exit(1);
+    }
+
+    cout << "input bytes: " << bytes << endl;
+
+    cout << "text format" << endl;
+    bool isSame = runWorkers(analyzer, argv[1], output + ".text", maxWorker, bytes);
+
+    cout << "token stream format" << endl;
+    analyzer->setOption(Analyzer::OPTION_TYPE_OUTPUT_TOKEN_STREAM, 1);
+    isSame = runWorkers(analyzer, argv[1], output + ".token", maxWorker, bytes) && isSame;
+
+    delete knowledge;
+    delete analyzer;
+
+    return isSame ? 0 : 1;
+}
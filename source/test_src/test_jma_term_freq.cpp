@@ -0,0 +1,193 @@
+/** \file test_jma_term_freq.cpp
+ * Benchmark the term frequency of each document by JMA_Analyzer::runWithTermFrequency() against counting the terms in the output of Analyzer::runWithString().
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To count the terms of each line in the raw input file "INPUT" in both ways,
+ * and print the time of each way, and whether the counts of each lexicon are the same.
+ * $ ./jma_term_freq INPUT [--dict DICT_PATH]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "jma_analyzer.h" // JMA_Analyzer::runWithTermFrequency()
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+
+    /** the count of each lexicon in a document */
+    typedef map<string, unsigned int> LexiconCount;
+}
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_term_freq INPUT [--dict DICT_PATH]" << endl;
+}
+
+/**
+ * Analyze each document by runWithString(), and count the lexicons in its text output as a consumer does.
+ * \return the time of analysis and counting
+ */
+double countText(Analyzer& analyzer, const vector<string>& docs, vector<LexiconCount>& counts)
+{
+    const char* posDelim = analyzer.getPOSDelimiter();
+    const char* wordDelim = analyzer.getWordDelimiter();
+    const unsigned int wordDelimLen = strlen(wordDelim);
+    counts.assign(docs.size(), LexiconCount());
+
+    clock_t stime = clock();
+    for(unsigned int i=0; i<docs.size(); ++i)
+    {
+        const string output = analyzer.runWithString(docs[i].c_str());
+        string::size_type start = 0;
+        string::size_type end;
+        while((end = output.find(wordDelim, start)) != string::npos)
+        {
+            // the POS string is after the last POS delimiter, as lexicon might contain it
+            string::size_type posStart = output.rfind(posDelim, end);
+            if(posStart == string::npos || posStart < start)
+                posStart = end;
+
+            ++counts[i][output.substr(start, posStart - start)];
+            start = end + wordDelimLen;
+        }
+    }
+    return (double)(clock() - stime) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Count the terms of each document by runWithTermFrequency().
+ * \return the time of analysis and counting
+ */
+double countTable(JMA_Analyzer& analyzer, const vector<string>& docs, vector<TermFrequency>& tables)
+{
+    tables.assign(docs.size(), TermFrequency(TermFrequency::KEY_TERM_ID));
+
+    clock_t stime = clock();
+    for(unsigned int i=0; i<docs.size(); ++i)
+        analyzer.runWithTermFrequency(docs[i].c_str(), tables[i]);
+    return (double)(clock() - stime) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Check whether the table has the same count of each lexicon,
+ * as the terms in dictionary are identified by term id, whose lexicon might be the same.
+ */
+bool isSameCount(const TermFrequency& table, const LexiconCount& expect)
+{
+    LexiconCount actual;
+    for(unsigned int i=0; i<table.size(); ++i)
+    {
+        const TermFrequency::Entry& entry = table.getEntry(i);
+        actual[string(table.getString(entry), entry.length_)] += entry.count_;
+    }
+    return actual == expect;
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    if(argc == 4 && ! strcmp(argv[2], OPTION_DICT))
+    {
+        sysdict = argv[3];
+    }
+
+    ifstream in(argv[1]);
+    if(! in)
+    {
+        cerr << "fail to open file " << argv[1] << endl;
+        exit(1);
+    }
+
+    vector<string> docs;
+    string line;
+    while(getline(in, line))
+    {
+        if(! line.empty())
+            docs.push_back(line);
+    }
+
+    // create instances
+    JMA_Factory* factory = JMA_Factory::instance();
+    Analyzer* analyzer = factory->createAnalyzer();
+    Knowledge* knowledge = factory->createKnowledge();
+
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    if(analyzer->setKnowledge(knowledge) == 0)
+    {
+        cerr << "fail to set knowledge" << endl;
+        exit(1);
+    }
+
+    JMA_Analyzer* jmaAnalyzer = dynamic_cast<JMA_Analyzer*>(analyzer);
+    if(! jmaAnalyzer)
+    {
+        cerr << "fail to get JMA_Analyzer" << endl;
+        exit(1);
+    }
+
+    cout << "documents: " << docs.size() << endl;
+
+    vector<LexiconCount> counts;
+    double time = countText(*analyzer, docs, counts);
+    cout << "runWithString() and count: " << time << endl;
+
+    vector<TermFrequency> tables;
+    time = countTable(*jmaAnalyzer, docs, tables);
+    cout << "runWithTermFrequency(): " << time << endl;
+
+    unsigned int diffCount = 0;
+    for(unsigned int i=0; i<docs.size(); ++i)
+    {
+        if(! isSameCount(tables[i], counts[i]))
+        {
+            if(! diffCount)
+                cerr << "different count in line " << i << endl;
+            ++diffCount;
+        }
+    }
+    cout << "documents of different count: " << diffCount << endl;
+
+    // destroy instances
+    delete knowledge;
+    delete analyzer;
+
+    return diffCount ? 1 : 0;
+}
@@ -0,0 +1,223 @@
+/** \file test_jma_token_stream.cpp
+ * Benchmark the output in binary format of token stream (Analyzer::OPTION_TYPE_OUTPUT_TOKEN_STREAM) against the output in text format.
+ * Below is the usage examples:
+ * The "DICT_PATH" in below examples is the dictionary path, which is "../db/ipadic/bin_utf8" defautly.
+ * \code
+ * To analyze each line in the raw input file "INPUT" in both formats,
+ * and print the time of analysis with serialization, the time of parsing the output, and the output size of each format.
+ * $ ./jma_token_stream INPUT [--dict DICT_PATH]
+ * \endcode
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include "ijma.h"
+#include "jma_analyzer.h" // JMA_Analyzer::getOutputLength()
+#include "test_jma_common.h" // TEST_JMA_DEFAULT_SYSTEM_DICT
+
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <ctime>
+#include <cstring>
+#include <cstdlib>
+
+using namespace std;
+using namespace jma;
+
+namespace
+{
+    /** optional command option for dictionary path */
+    const char* OPTION_DICT = "--dict";
+}
+
+/**
+ * Print the test usage.
+ */
+void printUsage()
+{
+    cerr << "Usage: ./jma_token_stream INPUT [--dict DICT_PATH]" << endl;
+}
+
+/**
+ * Analyze each sentence, and append the output of each sentence.
+ * \return the analysis time
+ */
+double runAnalysis(JMA_Analyzer& analyzer, const vector<string>& sentences, bool isTokenStream, vector<string>& outputs)
+{
+    analyzer.setOption(Analyzer::OPTION_TYPE_OUTPUT_TOKEN_STREAM, isTokenStream);
+    outputs.clear();
+    outputs.reserve(sentences.size());
+
+    clock_t stime = clock();
+    for(unsigned int i=0; i<sentences.size(); ++i)
+    {
+        const char* result = analyzer.runWithString(sentences[i].c_str());
+        outputs.push_back(string(result, analyzer.getOutputLength()));
+    }
+    return (double)(clock() - stime) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Parse the text output into lexicon and POS strings as a consumer does.
+ * \return the parse time
+ */
+double parseText(const vector<string>& outputs, const char* posDelim, const char* wordDelim, long& tokenCount)
+{
+    const unsigned int posDelimLen = strlen(posDelim);
+    const unsigned int wordDelimLen = strlen(wordDelim);
+    string lexicon, posStr;
+    tokenCount = 0;
+
+    clock_t stime = clock();
+    for(unsigned int i=0; i<outputs.size(); ++i)
+    {
+        const string& output = outputs[i];
+        string::size_type start = 0;
+        string::size_type end;
+        while((end = output.find(wordDelim, start)) != string::npos)
+        {
+            // the POS string is after the last POS delimiter, as lexicon might contain it
+            string::size_type posStart = output.rfind(posDelim, end);
+            if(posStart == string::npos || posStart < start)
+                posStart = end;
+
+            lexicon.assign(output, start, posStart - start);
+            if(posStart < end)
+                posStr.assign(output, posStart + posDelimLen, end - posStart - posDelimLen);
+            ++tokenCount;
+            start = end + wordDelimLen;
+        }
+    }
+    return (double)(clock() - stime) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Parse the token stream output into tokens.
+ * \return the parse time
+ */
+double parseTokenStream(const vector<string>& outputs, long& tokenCount)
+{
+    string lexicon, posStr;
+    TokenRecord token;
+    tokenCount = 0;
+
+    clock_t stime = clock();
+    for(unsigned int i=0; i<outputs.size(); ++i)
+    {
+        TokenStreamReader reader(outputs[i].data(), outputs[i].size());
+        while(reader.nextDocument())
+        {
+            while(reader.nextToken(token))
+            {
+                lexicon.assign(token.lexicon_, token.lexiconLength_);
+                posStr.assign(token.posStr_, token.posStrLength_);
+                ++tokenCount;
+            }
+        }
+
+        if(reader.isError())
+        {
+            cerr << "fail to parse token stream of line " << i << endl;
+            exit(1);
+        }
+    }
+    return (double)(clock() - stime) / CLOCKS_PER_SEC;
+}
+
+/**
+ * Get the total size of outputs.
+ */
+long getTotalSize(const vector<string>& outputs)
+{
+    long size = 0;
+    for(unsigned int i=0; i<outputs.size(); ++i)
+        size += outputs[i].size();
+    return size;
+}
+
+/**
+ * Main function.
+ */
+int main(int argc, char* argv[])
+{
+    if(argc < 2)
+    {
+        printUsage();
+        exit(1);
+    }
+
+    const char* sysdict = TEST_JMA_DEFAULT_SYSTEM_DICT;
+    if(argc == 4 && ! strcmp(argv[2], OPTION_DICT))
+    {
+        sysdict = argv[3];
+    }
+
+    ifstream in(argv[1]);
+    if(! in)
+    {
+        cerr << "fail to open file " << argv[1] << endl;
+        exit(1);
+    }
+
+    vector<string> sentences;
+    string line;
+    while(getline(in, line))
+    {
+        if(! line.empty())
+            sentences.push_back(line);
+    }
+
+    // create instances
+    JMA_Factory* factory = JMA_Factory::instance();
+    Analyzer* analyzer = factory->createAnalyzer();
+    Knowledge* knowledge = factory->createKnowledge();
+
+    knowledge->setSystemDict(sysdict);
+    if(knowledge->loadDict() == 0)
+    {
+        cerr << "fail to load dictionary files" << endl;
+        exit(1);
+    }
+
+    if(analyzer->setKnowledge(knowledge) == 0)
+    {
+        cerr << "fail to set knowledge" << endl;
+        exit(1);
+    }
+
+    JMA_Analyzer* jmaAnalyzer = dynamic_cast<JMA_Analyzer*>(analyzer);
+    if(! jmaAnalyzer)
+    {
+        cerr << "fail to get JMA_Analyzer" << endl;
+        exit(1);
+    }
+
+    cout << "sentences: " << sentences.size() << endl;
+
+    vector<string> outputs;
+    long tokenCount = 0;
+
+    double analysisTime = runAnalysis(*jmaAnalyzer, sentences, false, outputs);
+    double parseTime = parseText(outputs, analyzer->getPOSDelimiter(), analyzer->getWordDelimiter(), tokenCount);
+    cout << "text format:" << endl;
+    cout << "\tanalysis time: " << analysisTime << endl;
+    cout << "\tparse time: " << parseTime << endl;
+    cout << "\ttokens: " << tokenCount << ", output bytes: " << getTotalSize(outputs) << endl;
+
+    analysisTime = runAnalysis(*jmaAnalyzer, sentences, true, outputs);
+    parseTime = parseTokenStream(outputs, tokenCount);
+    cout << "token stream format:" << endl;
+    cout << "\tanalysis time: " << analysisTime << endl;
+    cout << "\tparse time: " << parseTime << endl;
+    cout << "\ttokens: " << tokenCount << ", output bytes: " << getTotalSize(outputs) << endl;
+
+    // destroy instances
+    delete knowledge;
+    delete analyzer;
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+/** \file unittest_analyzer_pool.cpp
+ * Unit test of class AnalyzerPool.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include <gtest/gtest.h>
+#include <ijma/jma_factory.h>
+#include <ijma/analyzer_pool.h>
+#include <ijma/knowledge.h>
+#include <thread.h> // MeCab::thread
+#include "../../test_src/test_jma_common.h"
+
+#include <string>
+
+#include <unistd.h> // usleep
+
+using namespace jma;
+using namespace std;
+
+namespace
+{
+/**
+ * PoolThread analyzes a string many times, each time by an analyzer checked out from pool.
+ */
+class PoolThread : public MeCab::thread
+{
+public:
+    PoolThread() : pool_(0), failCount_(0) {}
+
+    void run() {
+        for(int i=0; i<50; ++i)
+        {
+            AnalyzerPool::Handle handle(*pool_);
+            if(! handle.get() || handle->runWithString("来た") != string("来/V-I  た/AUV  "))
+                ++failCount_;
+        }
+    }
+
+    AnalyzerPool* pool_;
+    int failCount_;
+};
+}
+
+class AnalyzerPoolTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp() {
+        knowledge_ = JMA_Factory::instance()->createKnowledge();
+        ASSERT_TRUE(knowledge_);
+
+        knowledge_->setSystemDict(TEST_JMA_DEFAULT_SYSTEM_DICT);
+        ASSERT_EQ(1, knowledge_->loadDict());
+
+        pool_ = JMA_Factory::instance()->createAnalyzerPool(knowledge_, 2);
+        ASSERT_TRUE(pool_);
+        pool_->setOption(Analyzer::OPTION_TYPE_POS_FORMAT_ALPHABET, 1);
+    }
+
+    virtual void TearDown() {
+        delete pool_;
+        delete knowledge_;
+    }
+
+    Knowledge* knowledge_;
+    AnalyzerPool* pool_;
+};
+
+TEST_F(AnalyzerPoolTest, checkout) {
+    AnalyzerPool::Statistics stat;
+    pool_->getStatistics(stat);
+    EXPECT_EQ(2u, stat.maxSize_);
+    EXPECT_EQ(0u, stat.size_);
+
+    Analyzer* last = 0;
+    {
+        AnalyzerPool::Handle handle(*pool_);
+        ASSERT_TRUE(handle.get());
+        EXPECT_STREQ("来/V-I  た/AUV  ", handle->runWithString("来た"));
+
+        // another one is created while the first is in use
+        AnalyzerPool::Handle other(*pool_);
+        ASSERT_TRUE(other.get());
+        EXPECT_NE(handle.get(), other.get());
+        last = other.get();
+
+        pool_->getStatistics(stat);
+        EXPECT_EQ(2u, stat.size_);
+        EXPECT_EQ(0u, stat.idleSize_);
+        EXPECT_EQ(2ul, stat.createCount_);
+    }
+
+    pool_->getStatistics(stat);
+    EXPECT_EQ(2u, stat.idleSize_);
+
+    // the analyzer used last time by this thread, with the options changed by user reset
+    {
+        AnalyzerPool::Handle handle(*pool_);
+        EXPECT_EQ(last, handle.get());
+        handle->setOption(Analyzer::OPTION_TYPE_POS_TAGGING, 0);
+        EXPECT_STREQ("来  た  ", handle->runWithString("来た"));
+    }
+    {
+        AnalyzerPool::Handle handle(*pool_);
+        EXPECT_EQ(last, handle.get());
+        EXPECT_STREQ("来/V-I  た/AUV  ", handle->runWithString("来た"));
+    }
+
+    // the options set in pool are applied in next checkout
+    pool_->setOption(Analyzer::OPTION_TYPE_POS_TAGGING, 0);
+    EXPECT_EQ(0, pool_->getOption(Analyzer::OPTION_TYPE_POS_TAGGING));
+    {
+        AnalyzerPool::Handle handle(*pool_);
+        EXPECT_STREQ("来  た  ", handle->runWithString("来た"));
+    }
+
+    pool_->getStatistics(stat);
+    EXPECT_EQ(5ul, stat.checkoutCount_);
+    EXPECT_EQ(3ul, stat.affinityCount_);
+    EXPECT_EQ(0ul, stat.waitCount_);
+    EXPECT_EQ(2ul, stat.createCount_);
+}
+
+TEST_F(AnalyzerPoolTest, shrink) {
+    {
+        AnalyzerPool::Handle handle(*pool_);
+        AnalyzerPool::Handle other(*pool_);
+    }
+
+    // not idle for long enough
+    EXPECT_EQ(0u, pool_->shrink());
+
+    pool_->setIdleTimeout(0);
+    usleep(2000);
+    EXPECT_EQ(2u, pool_->shrink());
+
+    AnalyzerPool::Statistics stat;
+    pool_->getStatistics(stat);
+    EXPECT_EQ(0u, stat.size_);
+    EXPECT_EQ(0u, stat.idleSize_);
+    EXPECT_EQ(2ul, stat.destroyCount_);
+
+    // it grows again on demand
+    pool_->setIdleTimeout(-1);
+    {
+        AnalyzerPool::Handle handle(*pool_);
+        ASSERT_TRUE(handle.get());
+        EXPECT_STREQ("来/V-I  た/AUV  ", handle->runWithString("来た"));
+    }
+    usleep(2000);
+    EXPECT_EQ(0u, pool_->shrink());
+
+    pool_->getStatistics(stat);
+    EXPECT_EQ(1u, stat.size_);
+    EXPECT_EQ(3ul, stat.createCount_);
+}
+
+TEST_F(AnalyzerPoolTest, multiThread) {
+    const int threadNum = 4;
+    PoolThread threads[threadNum];
+    for(int i=0; i<threadNum; ++i)
+    {
+        threads[i].pool_ = pool_;
+        threads[i].start();
+    }
+
+    for(int i=0; i<threadNum; ++i)
+    {
+        threads[i].join();
+        EXPECT_EQ(0, threads[i].failCount_);
+    }
+
+    AnalyzerPool::Statistics stat;
+    pool_->getStatistics(stat);
+    EXPECT_EQ(200ul, stat.checkoutCount_);
+    EXPECT_GE(2u, stat.size_);
+    EXPECT_EQ(stat.size_, stat.idleSize_);
+    EXPECT_LE(0, stat.waitTime_);
+    EXPECT_LE(stat.maxWaitTime_, stat.waitTime_);
+}
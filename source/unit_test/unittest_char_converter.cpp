@@ -0,0 +1,125 @@
+/** \file unittest_char_converter.cpp
+ * Unit test of class CharConverter.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include <gtest/gtest.h>
+#include <char_converter.h>
+#include <jma_ctype.h>
+
+#include <string>
+
+using namespace jma;
+using namespace std;
+
+namespace
+{
+/**
+ * Convert a string.
+ */
+string convert(const CharConverter& converter, const char* str)
+{
+    string result;
+    converter.convert(str, result);
+    return result;
+}
+}
+
+TEST(CharConverterTest, empty) {
+    CharConverter converter;
+    EXPECT_TRUE(converter.empty());
+    EXPECT_EQ("", convert(converter, ""));
+
+    converter.build(JMA_CType::instance(Knowledge::ENCODE_TYPE_UTF8));
+    EXPECT_TRUE(converter.empty());
+    EXPECT_EQ("abcあいう", convert(converter, "abcあいう"));
+}
+
+TEST(CharConverterTest, asciiByteMap) {
+    CharTable::CharMap lower;
+    lower["A"] = "a";
+    lower["B"] = "b";
+
+    CharConverter converter;
+    converter.addStep(lower);
+    converter.build(JMA_CType::instance(Knowledge::ENCODE_TYPE_UTF8));
+    EXPECT_FALSE(converter.empty());
+
+    // longer than a word to pass through the word scan
+    EXPECT_EQ("abCabcabCabcあab", convert(converter, "ABCAbcaBCabcあAB"));
+}
+
+TEST(CharConverterTest, chain) {
+    CharTable::CharMap toHalf, toLower, toFull;
+    toHalf["Ａ"] = "A";
+    toHalf["あ"] = "ｱ";
+    toLower["A"] = "a";
+    toFull["a"] = "ａ";
+
+    CharConverter converter;
+    converter.addStep(toHalf);
+    converter.addStep(toLower);
+    converter.build(JMA_CType::instance(Knowledge::ENCODE_TYPE_UTF8));
+
+    // each step is applied on the output of previous steps
+    EXPECT_EQ("aaｱい", convert(converter, "ＡAあい"));
+
+    converter.addStep(toFull);
+    converter.build(JMA_CType::instance(Knowledge::ENCODE_TYPE_UTF8));
+    EXPECT_EQ("ａａｱい", convert(converter, "ＡAあい"));
+
+    converter.clear();
+    EXPECT_TRUE(converter.empty());
+    EXPECT_EQ("ＡAあい", convert(converter, "ＡAあい"));
+}
+
+TEST(CharConverterTest, multiCharacter) {
+    CharTable::CharMap charMap;
+    charMap["ab"] = "x"; // not a single character
+    charMap["c"] = "ｃｃ";
+
+    CharConverter converter;
+    converter.addStep(charMap);
+    converter.build(JMA_CType::instance(Knowledge::ENCODE_TYPE_UTF8));
+    EXPECT_EQ("abｃｃ", convert(converter, "abc"));
+}
+
+TEST(CharConverterTest, offsetMap) {
+    CharTable::CharMap charMap;
+    charMap["Ａ"] = "a";
+    charMap["b"] = "ｂ";
+    charMap["c"] = "cc";
+
+    CharConverter converter;
+    converter.addStep(charMap);
+    converter.build(JMA_CType::instance(Knowledge::ENCODE_TYPE_UTF8));
+
+    // "xＡyb" => "xaｂy", "ccあ"
+    OffsetMap offsetMap;
+    string result;
+    converter.convert("xＡybcあ", result, &offsetMap);
+    EXPECT_EQ("xayｂccあ", result);
+
+    // bytes: "x" 0, "Ａ" 1-4, "y" 4, "b" 5, "c" 6, "あ" 7-10
+    // => "x" 0, "a" 1, "y" 2, "ｂ" 3-6, "cc" 6-8, "あ" 8-11
+    EXPECT_EQ(0U, offsetMap.toOriginalByte(0, false));
+    EXPECT_EQ(1U, offsetMap.toOriginalByte(1, false));
+    EXPECT_EQ(4U, offsetMap.toOriginalByte(2, false));
+    EXPECT_EQ(5U, offsetMap.toOriginalByte(3, false));
+    EXPECT_EQ(6U, offsetMap.toOriginalByte(6, false));
+    EXPECT_EQ(6U, offsetMap.toOriginalByte(7, false));
+    EXPECT_EQ(7U, offsetMap.toOriginalByte(7, true));
+    EXPECT_EQ(7U, offsetMap.toOriginalByte(8, false));
+    EXPECT_EQ(10U, offsetMap.toOriginalByte(11, true));
+
+    // characters: "x" 0, "Ａ" 1, "y" 2, "b" 3, "c" 4, "あ" 5
+    // => "x" 0, "a" 1, "y" 2, "ｂ" 3, "cc" 4-6, "あ" 6
+    EXPECT_EQ(3U, offsetMap.toOriginalChar(3, false));
+    EXPECT_EQ(4U, offsetMap.toOriginalChar(4, false));
+    EXPECT_EQ(4U, offsetMap.toOriginalChar(5, false));
+    EXPECT_EQ(5U, offsetMap.toOriginalChar(5, true));
+    EXPECT_EQ(5U, offsetMap.toOriginalChar(6, false));
+    EXPECT_EQ(6U, offsetMap.toOriginalChar(7, true));
+}
@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 #include <jma_analyzer.h>
 #include <jma_knowledge.h>
+#include <tokenizer.h> // CTypeTokenizer
 #include "../../test_src/test_jma_common.h"
 #include "../../include/file_utils.h"
 
@@ -16,10 +17,17 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <iterator> // istreambuf_iterator
 
 using namespace jma;
 using namespace std;
 
+/** the sample sentences analyzed with each combination of options */
+const char* const SAMPLE_SENTENCES[] = {"田中さんは三菱東京UFJ銀行に行った。", "高さ", "長野県の野球選手権大会", "どういう意味でしょうか？", "　 abc 　def"};
+
+/** the number of sample sentences */
+const unsigned int SAMPLE_SENTENCE_NUM = sizeof(SAMPLE_SENTENCES) / sizeof(SAMPLE_SENTENCES[0]);
+
 class JMA_AnalyzerTest : public ::testing::Test
 {
 protected:
@@ -105,6 +113,52 @@ protected:
         ASSERT_EQ(1, analyzer_->runWithStream(strInputFile, strOutputFile));
     }
 
+    /**
+     * MorphemeCheck checks the result of a sentence analyzed with the current options, which is called by \e sweepOptions().
+     */
+    class MorphemeCheck
+    {
+    public:
+        virtual ~MorphemeCheck() {}
+
+        /**
+         * Check the result of a sentence.
+         * \param analyzer the analyzer with the current options
+         * \param str the sentence
+         * \param expect the one-best result of \e runOneBest() with the current options
+         */
+        virtual void check(JMA_Analyzer* analyzer, const char* str, const Sentence& expect) = 0;
+    };
+
+    /**
+     * Check the sample sentences with each combination of compound morphology and user noun decomposition.
+     * \param checker the check on each sentence
+     * \param extraStrs the sentences to check besides \e SAMPLE_SENTENCES
+     */
+    virtual void sweepOptions(MorphemeCheck& checker, const vector<string>& extraStrs = vector<string>()) {
+        vector<string> strs(SAMPLE_SENTENCES, SAMPLE_SENTENCES + SAMPLE_SENTENCE_NUM);
+        strs.insert(strs.end(), extraStrs.begin(), extraStrs.end());
+
+        for(int option=0; option<4; ++option)
+        {
+            analyzer_->setOption(Analyzer::OPTION_TYPE_COMPOUND_MORPHOLOGY, option & 1);
+            analyzer_->setOption(Analyzer::OPTION_TYPE_DECOMPOSE_USER_NOUN, option & 2);
+
+            for(unsigned int i=0; i<strs.size(); ++i)
+            {
+                SCOPED_TRACE(strs[i]);
+
+                Sentence expect(strs[i].c_str());
+                analyzer_->runOneBest(expect);
+                ASSERT_EQ(1, expect.getListSize());
+
+                checker.check(analyzer_, strs[i].c_str(), expect);
+                if(HasFatalFailure())
+                    return;
+            }
+        }
+    }
+
     JMA_Analyzer* analyzer_;
     JMA_Knowledge* knowledge_;
 };
@@ -196,6 +250,20 @@ TEST_F(JMA_AnalyzerTest, splitSentence) {
     EXPECT_STREQ("ここ、そこ。", sentVec[2].getString());
     EXPECT_STREQ("こち、そち！", sentVec[3].getString());
     EXPECT_STREQ("これ、それ？", sentVec[4].getString());
+
+    // the spans are the same as sentences
+    SentenceSpanList spans;
+    analyzer_->splitSentence(paraStr, spans);
+    ASSERT_EQ(sentVec.size(), spans.size());
+    for(unsigned int i=0; i<spans.size(); ++i)
+        EXPECT_EQ(sentVec[i].getString(), string(paraStr + spans[i].offset_, spans[i].length_));
+
+    // the last sentence without separator
+    spans.clear();
+    analyzer_->splitSentence("ここ。そこ", spans);
+    ASSERT_EQ(2u, spans.size());
+    EXPECT_EQ(9u, spans[1].offset_);
+    EXPECT_EQ(6u, spans[1].length_);
 }
 
 TEST_F(JMA_AnalyzerTest, convertCharacters) {
@@ -213,6 +281,48 @@ TEST_F(JMA_AnalyzerTest, convertCharacters) {
     EXPECT_EQ("ＡＺＡＺ１０ＡＺＡＺ１０アンアンｲﾑ阿", analyzer_->convertCharacters(str));
 }
 
+TEST_F(JMA_AnalyzerTest, convertCharactersCombination) {
+    const char* str = "Tokyo東京ＴＯＫＹＯとうきょうトウキョウﾄｳｷｮｳ 2010年、ａｂｃＡＢＣｱｲｳ!?";
+    const Analyzer::OptionType options[] = {
+        Analyzer::OPTION_TYPE_CONVERT_TO_HIRAGANA,
+        Analyzer::OPTION_TYPE_CONVERT_TO_KATAKANA,
+        Analyzer::OPTION_TYPE_CONVERT_TO_HALF_WIDTH,
+        Analyzer::OPTION_TYPE_CONVERT_TO_FULL_WIDTH,
+        Analyzer::OPTION_TYPE_CONVERT_TO_LOWER_CASE,
+        Analyzer::OPTION_TYPE_CONVERT_TO_UPPER_CASE
+    };
+    const int optionNum = sizeof(options) / sizeof(options[0]);
+
+    // the result should be the same as applying each conversion in order
+    for(int mask=0; mask<(1 << optionNum); ++mask)
+    {
+        for(int i=0; i<optionNum; ++i)
+            analyzer_->setOption(options[i], (mask & (1 << i)) ? 1 : 0);
+
+        string expect;
+        CTypeTokenizer tokenizer(knowledge_->getCType(), str);
+        for(const char* p=tokenizer.next(); p; p=tokenizer.next())
+        {
+            const char* q;
+            if((mask & 1) && (q = knowledge_->getKanaTable().toLeft(p)))
+                p = q;
+            if((mask & 2) && (q = knowledge_->getKanaTable().toRight(p)))
+                p = q;
+            if((mask & 4) && (q = knowledge_->getWidthTable().toLeft(p)))
+                p = q;
+            if((mask & 8) && (q = knowledge_->getWidthTable().toRight(p)))
+                p = q;
+            if((mask & 16) && (q = knowledge_->getCaseTable().toLeft(p)))
+                p = q;
+            if((mask & 32) && (q = knowledge_->getCaseTable().toRight(p)))
+                p = q;
+            expect += p;
+        }
+
+        EXPECT_EQ(expect, analyzer_->convertCharacters(str)) << "option mask: " << mask;
+    }
+}
+
 TEST_F(JMA_AnalyzerTest, nbest) {
     analyzer_->setOption(Analyzer::OPTION_TYPE_NBEST, 5);
     EXPECT_EQ(5, analyzer_->getOption(Analyzer::OPTION_TYPE_NBEST));
@@ -227,6 +337,1048 @@ TEST_F(JMA_AnalyzerTest, nbest) {
     ASSERT_EQ(5, sent.getListSize());
 }
 
+TEST_F(JMA_AnalyzerTest, nbestCursor) {
+    NBestCursor emptyCursor = analyzer_->beginNBest("");
+    EXPECT_FALSE(emptyCursor.next());
+    EXPECT_EQ(-1, emptyCursor.getIndex());
+
+    const char* str = "田中さんは三菱東京UFJ銀行に行った。";
+    Sentence sent(str);
+    ASSERT_TRUE(analyzer_->runNBest(sent, 5));
+    ASSERT_EQ(5, sent.getListSize());
+
+    // the candidates should be the same as those from runNBest()
+    NBestCursor cursor = analyzer_->beginNBest(str);
+    long prevCost = 0;
+    for(int i=0; i<sent.getListSize(); ++i)
+    {
+        ASSERT_TRUE(cursor.next());
+        EXPECT_EQ(i, cursor.getIndex());
+
+        const MorphemeList& list = cursor.getMorphemeList();
+        ASSERT_EQ(sent.getCount(i), static_cast<int>(list.size()));
+        for(int j=0; j<sent.getCount(i); ++j)
+        {
+            EXPECT_EQ(sent.getLexicon(i, j), list[j].lexicon_);
+            EXPECT_EQ(sent.getPOS(i, j), list[j].posCode_);
+        }
+
+        if(i > 0)
+        {
+            EXPECT_LE(prevCost, cursor.getCost());
+        }
+        prevCost = cursor.getCost();
+    }
+}
+
+TEST_F(JMA_AnalyzerTest, nbestCostGap) {
+    EXPECT_EQ(0, analyzer_->getOption(Analyzer::OPTION_TYPE_NBEST_COST_GAP));
+
+    const char* str = "田中さんは三菱東京UFJ銀行に行った。";
+    Sentence sent(str);
+    ASSERT_TRUE(analyzer_->runNBest(sent, 20));
+    EXPECT_EQ(20, sent.getListSize());
+    size_t fullAgenda = analyzer_->getNBestAgendaSize();
+
+    const long costGap = 500;
+    analyzer_->setOption(Analyzer::OPTION_TYPE_NBEST_COST_GAP, costGap);
+    Sentence gapSent(str);
+    ASSERT_TRUE(analyzer_->runNBest(gapSent, 20));
+    EXPECT_GE(gapSent.getListSize(), 1);
+    EXPECT_LT(gapSent.getListSize(), 20);
+    EXPECT_LT(analyzer_->getNBestAgendaSize(), fullAgenda);
+
+    // all the candidates are within the cost gap
+    NBestCursor cursor = analyzer_->beginNBest(str);
+    ASSERT_TRUE(cursor.next());
+    long bestCost = cursor.getCost();
+    while(cursor.next())
+        EXPECT_LE(cursor.getCost() - bestCost, costGap);
+    EXPECT_EQ(gapSent.getListSize(), cursor.getIndex() + 1);
+}
+
+/**
+ * Check whether a candidate is a path in graph.
+ * \param graph the graph
+ * \param list the morphemes of the candidate
+ * \return true if each morpheme is a node, and each two adjacent nodes are connected by an edge
+ */
+bool isGraphPath(const MorphemeGraph& graph, const MorphemeList& list)
+{
+    int prev = MorphemeGraph::BOS_INDEX;
+    for(unsigned int i=0; i<=list.size(); ++i)
+    {
+        int next = MorphemeGraph::EOS_INDEX;
+        if(i < list.size())
+        {
+            for(next=0; next<static_cast<int>(graph.nodes_.size()); ++next)
+            {
+                const MorphemeGraph::Node& node = graph.nodes_[next];
+                if(node.offset_ == list[i].byteOffset_ && node.morpheme_.lexicon_ == list[i].lexicon_
+                        && node.morpheme_.posCode_ == list[i].posCode_)
+                    break;
+            }
+            if(next == static_cast<int>(graph.nodes_.size()))
+                return false;
+        }
+
+        unsigned int j = 0;
+        for(; j<graph.edges_.size(); ++j)
+        {
+            if(graph.edges_[j].from_ == prev && graph.edges_[j].to_ == next)
+                break;
+        }
+        if(j == graph.edges_.size())
+            return false;
+
+        prev = next;
+    }
+
+    return true;
+}
+
+TEST_F(JMA_AnalyzerTest, graph) {
+    analyzer_->setOption(Analyzer::OPTION_TYPE_COMPOUND_MORPHOLOGY, 0);
+
+    MorphemeGraph graph;
+    ASSERT_TRUE(analyzer_->runGraph("", graph, 1000));
+    EXPECT_TRUE(graph.nodes_.empty());
+
+    const char* str = "田中さんは三菱東京UFJ銀行に行った。";
+    Sentence sent(str);
+    analyzer_->runOneBest(sent);
+    ASSERT_EQ(1, sent.getListSize());
+
+    // the best path only
+    ASSERT_TRUE(analyzer_->runGraph(str, graph, 0));
+    ASSERT_EQ(sent.getCount(0), static_cast<int>(graph.nodes_.size()));
+    string combineStr;
+    for(int i=0; i<sent.getCount(0); ++i)
+    {
+        const MorphemeGraph::Node& node = graph.nodes_[i];
+        EXPECT_TRUE(node.isBest_);
+        EXPECT_STREQ(sent.getLexicon(0, i), node.morpheme_.lexicon_.c_str());
+        EXPECT_EQ(sent.getPOS(0, i), node.morpheme_.posCode_);
+        EXPECT_EQ(node.morpheme_.lexicon_, string(str + node.offset_, node.length_));
+    }
+    EXPECT_EQ(graph.nodes_.size() + 1, graph.edges_.size());
+
+    // more candidates within cost margin
+    ASSERT_TRUE(analyzer_->runGraph(str, graph, 10000));
+    const int nodeCount = graph.nodes_.size();
+    EXPECT_GT(nodeCount, sent.getCount(0));
+
+    vector<int> inCount(nodeCount), outCount(nodeCount);
+    int bestCount = 0;
+    for(unsigned int i=0; i<graph.edges_.size(); ++i)
+    {
+        const MorphemeGraph::Edge& edge = graph.edges_[i];
+        ASSERT_TRUE(edge.from_ == MorphemeGraph::BOS_INDEX || (edge.from_ >= 0 && edge.from_ < nodeCount));
+        ASSERT_TRUE(edge.to_ == MorphemeGraph::EOS_INDEX || (edge.to_ >= 0 && edge.to_ < nodeCount));
+        if(edge.from_ != MorphemeGraph::BOS_INDEX)
+            ++outCount[edge.from_];
+        if(edge.to_ != MorphemeGraph::EOS_INDEX)
+            ++inCount[edge.to_];
+        if(edge.isBest_)
+            ++bestCount;
+    }
+    EXPECT_EQ(sent.getCount(0) + 1, bestCount);
+    for(int i=0; i<nodeCount; ++i)
+    {
+        EXPECT_GT(inCount[i], 0);
+        EXPECT_GT(outCount[i], 0);
+    }
+
+    // each n-best candidate within cost margin is a path in graph
+    NBestCursor cursor = analyzer_->beginNBest(str);
+    ASSERT_TRUE(cursor.next());
+    const long bestCost = cursor.getCost();
+    do
+    {
+        if(cursor.getCost() - bestCost > 10000)
+            break;
+
+        EXPECT_TRUE(isGraphPath(graph, cursor.getMorphemeList()));
+    } while(cursor.next());
+}
+
+TEST_F(JMA_AnalyzerTest, graphCostMargin) {
+    analyzer_->setOption(Analyzer::OPTION_TYPE_COMPOUND_MORPHOLOGY, 0);
+    const char* str = "田中さんは三菱東京UFJ銀行に行った。";
+
+    // a candidate behind the best one
+    NBestCursor cursor = analyzer_->beginNBest(str);
+    ASSERT_TRUE(cursor.next());
+    const long bestCost = cursor.getCost();
+    while(cursor.getIndex() < 5 && cursor.next())
+        ;
+    const long costGap = cursor.getCost() - bestCost;
+    ASSERT_GT(costGap, 0);
+    const MorphemeList candidate = cursor.getMorphemeList();
+
+    // the candidate whose total cost is just on the margin is a path in graph
+    MorphemeGraph graph;
+    ASSERT_TRUE(analyzer_->runGraph(str, graph, costGap));
+    EXPECT_TRUE(isGraphPath(graph, candidate));
+
+    // the candidates within the smaller margin are still paths in graph
+    ASSERT_TRUE(analyzer_->runGraph(str, graph, costGap - 1));
+    NBestCursor innerCursor = analyzer_->beginNBest(str);
+    while(innerCursor.next() && innerCursor.getCost() - bestCost <= costGap - 1)
+        EXPECT_TRUE(isGraphPath(graph, innerCursor.getMorphemeList()));
+}
+
+TEST_F(JMA_AnalyzerTest, morphemeView) {
+    EXPECT_TRUE(analyzer_->runWithView("").empty());
+
+    // the same morphemes as runOneBest()
+    class ViewCheck : public MorphemeCheck
+    {
+    public:
+        void check(JMA_Analyzer* analyzer, const char* str, const Sentence& expect)
+        {
+            const MorphemeViewList& views = analyzer->runWithView(str);
+            ASSERT_EQ(expect.getCount(0), static_cast<int>(views.size()));
+            Morpheme morph;
+            for(int j=0; j<expect.getCount(0); ++j)
+            {
+                views[j].toMorpheme(morph);
+                EXPECT_STREQ(expect.getLexicon(0, j), morph.lexicon_.c_str());
+                EXPECT_EQ(expect.getPOS(0, j), morph.posCode_);
+                EXPECT_STREQ(expect.getStrPOS(0, j), morph.posStr_.c_str());
+                EXPECT_STREQ(expect.getBaseForm(0, j), morph.baseForm_.c_str());
+                EXPECT_STREQ(expect.getReadForm(0, j), morph.readForm_.c_str());
+                EXPECT_STREQ(expect.getNormForm(0, j), morph.normForm_.c_str());
+            }
+        }
+    } checker;
+    sweepOptions(checker);
+}
+
+TEST_F(JMA_AnalyzerTest, query) {
+    QueryResult result;
+    analyzer_->runWithQuery("", result);
+    EXPECT_TRUE(result.empty());
+
+    // the same morphemes as runWithView(), with and without normalization
+    class QueryCheck : public MorphemeCheck
+    {
+    public:
+        void check(JMA_Analyzer* analyzer, const char* str, const Sentence& expect)
+        {
+            QueryResult result;
+            for(int normalize=0; normalize<2; ++normalize)
+            {
+                analyzer->setOption(Analyzer::OPTION_TYPE_NORMALIZE_INPUT, normalize);
+                analyzer->setOption(Analyzer::OPTION_TYPE_CONVERT_TO_FULL_WIDTH, normalize);
+
+                const MorphemeViewList views = analyzer->runWithView(str);
+                vector<Morpheme> expects(views.size());
+                for(unsigned int j=0; j<views.size(); ++j)
+                    views[j].toMorpheme(expects[j]);
+
+                analyzer->runWithQuery(str, result);
+                ASSERT_EQ(views.size(), result.size()) << str;
+                Morpheme morph;
+                for(unsigned int j=0; j<result.size(); ++j)
+                {
+                    result[j].toMorpheme(morph);
+                    EXPECT_EQ(expects[j].lexicon_, morph.lexicon_);
+                    EXPECT_EQ(expects[j].posCode_, morph.posCode_);
+                    EXPECT_EQ(expects[j].baseForm_, morph.baseForm_);
+                    EXPECT_EQ(views[j].byteOffset_, result[j].byteOffset_);
+                    EXPECT_EQ(views[j].charOffset_, result[j].charOffset_);
+                }
+            }
+
+            analyzer->setOption(Analyzer::OPTION_TYPE_NORMALIZE_INPUT, 0);
+            analyzer->setOption(Analyzer::OPTION_TYPE_CONVERT_TO_FULL_WIDTH, 0);
+        }
+    } checker;
+
+    vector<string> queries;
+    queries.push_back("京都");
+    queries.push_back("三菱東京UFJ銀行");
+    queries.push_back("安い 航空券 沖縄");
+    queries.push_back("ｱｲﾌｫﾝ ケース");
+
+    analyzer_->setQueryProfile(64);
+    sweepOptions(checker, queries);
+
+    // n-best is not affected after query
+    Sentence sent("田中さんは銀行に行った。");
+    analyzer_->setOption(Analyzer::OPTION_TYPE_NBEST, 3);
+    ASSERT_EQ(1, analyzer_->runWithSentence(sent));
+    EXPECT_LT(1, sent.getListSize());
+}
+
+TEST_F(JMA_AnalyzerTest, morphemeColumns) {
+    MorphemeColumns columns;
+    analyzer_->runWithColumns("", columns);
+    EXPECT_EQ(0U, columns.size());
+
+    // the same morphemes as runOneBest(), and converted back to the same sentence
+    class ColumnsCheck : public MorphemeCheck
+    {
+    public:
+        void check(JMA_Analyzer* analyzer, const char* str, const Sentence& expect)
+        {
+            MorphemeColumns columns;
+            analyzer->runWithColumns(str, columns);
+            ASSERT_EQ(expect.getCount(0), static_cast<int>(columns.size()));
+            ASSERT_EQ(columns.size(), columns.termIds_.size());
+            string lexicon;
+            for(int j=0; j<expect.getCount(0); ++j)
+            {
+                columns.lexicons_.get(j, lexicon);
+                EXPECT_EQ(expect.getLexicon(0, j), lexicon);
+                EXPECT_EQ(expect.getPOS(0, j), columns.posCodes_[j]);
+                columns.posStrs_.get(j, lexicon);
+                EXPECT_EQ(expect.getStrPOS(0, j), lexicon);
+                columns.baseForms_.get(j, lexicon);
+                EXPECT_EQ(expect.getBaseForm(0, j), lexicon);
+                columns.readForms_.get(j, lexicon);
+                EXPECT_EQ(expect.getReadForm(0, j), lexicon);
+                columns.normForms_.get(j, lexicon);
+                EXPECT_EQ(expect.getNormForm(0, j), lexicon);
+            }
+
+            Sentence converted(str);
+            columns.appendTo(converted);
+            ASSERT_EQ(1, converted.getListSize());
+            ASSERT_EQ(expect.getCount(0), converted.getCount(0));
+            for(int j=0; j<expect.getCount(0); ++j)
+            {
+                EXPECT_STREQ(expect.getLexicon(0, j), converted.getLexicon(0, j));
+                EXPECT_STREQ(expect.getStrPOS(0, j), converted.getStrPOS(0, j));
+            }
+        }
+    } checker;
+    sweepOptions(checker);
+
+    // the morphemes in dictionary have term ids
+    analyzer_->setOption(Analyzer::OPTION_TYPE_COMPOUND_MORPHOLOGY, 0);
+    analyzer_->runWithColumns("高さ", columns);
+    ASSERT_EQ(2U, columns.size());
+    EXPECT_GE(columns.termIds_[0], 0);
+    EXPECT_GE(columns.termIds_[1], 0);
+    EXPECT_NE(columns.termIds_[0], columns.termIds_[1]);
+
+    // the same dictionary entry has the same term id
+    const vector<int> termIds = columns.termIds_;
+    analyzer_->runWithColumns("高さ", columns);
+    EXPECT_TRUE(termIds == columns.termIds_);
+}
+
+TEST_F(JMA_AnalyzerTest, morphemeFields) {
+    EXPECT_EQ(Analyzer::MORPHEME_FIELD_ALL, analyzer_->getOption(Analyzer::OPTION_TYPE_MORPHEME_FIELDS));
+
+    const char* str = SAMPLE_SENTENCES[0];
+    const string fullStr = analyzer_->runWithString(str);
+
+    // the fields not selected are empty, compared with the result of all fields
+    class FieldsCheck : public MorphemeCheck
+    {
+    public:
+        void check(JMA_Analyzer* analyzer, const char* str, const Sentence& full)
+        {
+            for(int fields=0; fields<=Analyzer::MORPHEME_FIELD_ALL; ++fields)
+            {
+                analyzer->setOption(Analyzer::OPTION_TYPE_MORPHEME_FIELDS, fields);
+                Sentence sent(str);
+                analyzer->runOneBest(sent);
+                ASSERT_EQ(1, sent.getListSize());
+                ASSERT_EQ(full.getCount(0), sent.getCount(0));
+
+                for(int j=0; j<full.getCount(0); ++j)
+                {
+                    EXPECT_STREQ(full.getLexicon(0, j), sent.getLexicon(0, j));
+                    EXPECT_EQ(full.getPOS(0, j), sent.getPOS(0, j));
+                    EXPECT_STREQ((fields & Analyzer::MORPHEME_FIELD_POS_STR) ? full.getStrPOS(0, j) : "", sent.getStrPOS(0, j));
+                    EXPECT_STREQ((fields & Analyzer::MORPHEME_FIELD_BASE_FORM) ? full.getBaseForm(0, j) : "", sent.getBaseForm(0, j));
+                    EXPECT_STREQ((fields & Analyzer::MORPHEME_FIELD_READ_FORM) ? full.getReadForm(0, j) : "", sent.getReadForm(0, j));
+                    EXPECT_STREQ((fields & Analyzer::MORPHEME_FIELD_NORM_FORM) ? full.getNormForm(0, j) : "", sent.getNormForm(0, j));
+                }
+            }
+
+            analyzer->setOption(Analyzer::OPTION_TYPE_MORPHEME_FIELDS, Analyzer::MORPHEME_FIELD_ALL);
+        }
+    } checker;
+    sweepOptions(checker);
+
+    // the string output is not affected
+    analyzer_->setOption(Analyzer::OPTION_TYPE_COMPOUND_MORPHOLOGY, 1);
+    analyzer_->setOption(Analyzer::OPTION_TYPE_DECOMPOSE_USER_NOUN, 0);
+    analyzer_->setOption(Analyzer::OPTION_TYPE_MORPHEME_FIELDS, 0);
+    EXPECT_EQ(fullStr, analyzer_->runWithString(str));
+    EXPECT_EQ(0, analyzer_->getOption(Analyzer::OPTION_TYPE_MORPHEME_FIELDS));
+}
+
+/**
+ * Count the characters in UTF-8 string.
+ * \param str the string
+ * \param length the byte length
+ * \return the number of characters
+ */
+int countUTF8Chars(const char* str, int length)
+{
+    int count = 0;
+    for(int i=0; i<length; ++i)
+    {
+        // not count the continuation bytes
+        if((str[i] & 0xC0) != 0x80)
+            ++count;
+    }
+    return count;
+}
+
+/**
+ * Check the offsets of morphemes in sentence.
+ * \param str the sentence string
+ * \param list the morphemes
+ */
+void checkMorphemeOffsets(const string& str, const MorphemeList& list)
+{
+    int prevEnd = 0;
+    for(unsigned int i=0; i<list.size(); ++i)
+    {
+        const Morpheme& morph = list[i];
+        ASSERT_GE(morph.byteOffset_, prevEnd);
+        ASSERT_LE(morph.byteOffset_ + morph.byteLength_, static_cast<int>(str.size()));
+
+        // compound word might contain white-space characters
+        string range = str.substr(morph.byteOffset_, morph.byteLength_);
+        string::size_type pos;
+        while((pos = range.find(' ')) != string::npos)
+            range.erase(pos, 1);
+        EXPECT_EQ(morph.lexicon_, range);
+
+        EXPECT_EQ(countUTF8Chars(str.c_str(), morph.byteOffset_), morph.charOffset_);
+        EXPECT_EQ(countUTF8Chars(str.c_str() + morph.byteOffset_, morph.byteLength_), morph.charLength_);
+        prevEnd = morph.byteOffset_ + morph.byteLength_;
+    }
+}
+
+TEST_F(JMA_AnalyzerTest, morphemeOffsets) {
+    // the offsets in sentence, which are the same in n-best and views
+    class OffsetsCheck : public MorphemeCheck
+    {
+    public:
+        void check(JMA_Analyzer* analyzer, const char* str, const Sentence& expect)
+        {
+            const MorphemeList& list = *expect.getMorphemeList(0);
+            checkMorphemeOffsets(str, list);
+
+            const MorphemeViewList& views = analyzer->runWithView(str);
+            ASSERT_EQ(list.size(), views.size());
+            for(unsigned int j=0; j<list.size(); ++j)
+            {
+                EXPECT_EQ(list[j].byteOffset_, static_cast<int>(views[j].byteOffset_));
+                EXPECT_EQ(list[j].byteLength_, static_cast<int>(views[j].byteLength_));
+                EXPECT_EQ(list[j].charOffset_, static_cast<int>(views[j].charOffset_));
+                EXPECT_EQ(list[j].charLength_, static_cast<int>(views[j].charLength_));
+            }
+
+            Sentence nbestSent(str);
+            ASSERT_TRUE(analyzer->runNBest(nbestSent, 3));
+            for(int j=0; j<nbestSent.getListSize(); ++j)
+            {
+                checkMorphemeOffsets(str, *nbestSent.getMorphemeList(j));
+            }
+        }
+    } checker;
+
+    // long string to analyze in several parts
+    string longStr;
+    while(longStr.size() < 20000)
+        longStr += "田中さんは三菱東京UFJ銀行に行った。 長野県の野球選手権大会 abc def ";
+
+    const char* spaceStr = " 　 abc 　def 　";
+    vector<string> strs;
+    strs.push_back("高さ 高さ");
+    strs.push_back(spaceStr);
+    strs.push_back(longStr);
+    sweepOptions(checker, strs);
+
+    // the graph nodes are not combined or decomposed
+    MorphemeGraph graph;
+    ASSERT_TRUE(analyzer_->runGraph(spaceStr, graph, 5000));
+    for(unsigned int i=0; i<graph.nodes_.size(); ++i)
+    {
+        const Morpheme& morph = graph.nodes_[i].morpheme_;
+        EXPECT_EQ(graph.nodes_[i].offset_, morph.byteOffset_);
+        EXPECT_EQ(graph.nodes_[i].length_, morph.byteLength_);
+        EXPECT_EQ(morph.lexicon_, string(spaceStr + morph.byteOffset_, morph.byteLength_));
+        EXPECT_EQ(countUTF8Chars(spaceStr, morph.byteOffset_), morph.charOffset_);
+        EXPECT_EQ(countUTF8Chars(spaceStr + morph.byteOffset_, morph.byteLength_), morph.charLength_);
+    }
+}
+
+TEST_F(JMA_AnalyzerTest, tokenStream) {
+    const char* paraStr = "田中さんは三菱東京UFJ銀行に行った。どういう意味でしょうか？ 長野県の野球選手権大会";
+    const string textStr = analyzer_->runWithString(paraStr);
+
+    analyzer_->setOption(Analyzer::OPTION_TYPE_OUTPUT_TOKEN_STREAM, 1);
+    analyzer_->runWithString(paraStr);
+    const string binaryStr(analyzer_->runWithString(paraStr), analyzer_->getOutputLength());
+
+    // compare with the text output
+    string expectStr;
+    TokenStreamReader reader(binaryStr.data(), binaryStr.size());
+    ASSERT_TRUE(reader.nextDocument());
+    EXPECT_EQ(TOKEN_STREAM_LEXICON | TOKEN_STREAM_POS_STR, reader.getFields());
+    TokenRecord token;
+    while(reader.nextToken(token))
+    {
+        const string lexicon(token.lexicon_, token.lexiconLength_);
+        expectStr += lexicon + "/" + string(token.posStr_, token.posStrLength_) + "  ";
+
+        // offset in the whole input string
+        EXPECT_EQ(lexicon, string(paraStr + token.byteOffset_, token.byteLength_));
+        EXPECT_EQ(countUTF8Chars(paraStr, token.byteOffset_), static_cast<int>(token.charOffset_));
+    }
+    EXPECT_EQ(textStr, expectStr);
+    EXPECT_FALSE(reader.nextDocument());
+    EXPECT_FALSE(reader.isError());
+
+    // without POS string
+    analyzer_->setOption(Analyzer::OPTION_TYPE_POS_TAGGING, 0);
+    TokenStreamReader lexiconReader(analyzer_->runWithString(paraStr), analyzer_->getOutputLength());
+    ASSERT_TRUE(lexiconReader.nextDocument());
+    EXPECT_EQ(TOKEN_STREAM_LEXICON, lexiconReader.getFields());
+    ASSERT_TRUE(lexiconReader.nextToken(token));
+    EXPECT_EQ("田中", string(token.lexicon_, token.lexiconLength_));
+    EXPECT_EQ(0U, token.posStrLength_);
+
+    // each line as a document
+    analyzer_->setOption(Analyzer::OPTION_TYPE_POS_TAGGING, 1);
+    const char* strInputFile = "aaa.txt";
+    const char* strOutputFile = "bbb.txt";
+    runWithStreamTest(strInputFile, strOutputFile);
+
+    ifstream ifs(strOutputFile, ios::binary);
+    ASSERT_TRUE(ifs);
+    const string streamStr((istreambuf_iterator<char>(ifs)), istreambuf_iterator<char>());
+    TokenStreamReader streamReader(streamStr.data(), streamStr.size());
+    ASSERT_TRUE(streamReader.nextDocument());
+    ASSERT_TRUE(streamReader.nextToken(token));
+    EXPECT_EQ("田中", string(token.lexicon_, token.lexiconLength_));
+    ASSERT_TRUE(streamReader.nextDocument());
+    ASSERT_TRUE(streamReader.nextToken(token));
+    EXPECT_EQ("どういう", string(token.lexicon_, token.lexiconLength_));
+    EXPECT_EQ(0U, token.byteOffset_);
+    EXPECT_FALSE(streamReader.nextDocument());
+    EXPECT_FALSE(streamReader.isError());
+
+    EXPECT_TRUE(removeFile(strInputFile));
+    EXPECT_TRUE(removeFile(strOutputFile));
+}
+
+TEST_F(JMA_AnalyzerTest, normalizeInput) {
+    const char* strs[] = {"ＴＯＫＹＯタワーに行った。", "Ｔｏｋｙｏ　ＵＦＪ銀行の ＡＢＣ１２３です", "ﾄｳｷｮｳﾀﾜｰはＡＢＣ"};
+    const unsigned int strNum = sizeof(strs) / sizeof(strs[0]);
+
+    for(int option=0; option<2; ++option)
+    {
+        analyzer_->setOption(Analyzer::OPTION_TYPE_CONVERT_TO_HALF_WIDTH, option == 0);
+        analyzer_->setOption(Analyzer::OPTION_TYPE_CONVERT_TO_LOWER_CASE, option == 0);
+        analyzer_->setOption(Analyzer::OPTION_TYPE_CONVERT_TO_FULL_WIDTH, option == 1);
+        analyzer_->setOption(Analyzer::OPTION_TYPE_CONVERT_TO_HIRAGANA, option == 1);
+
+        for(unsigned int i=0; i<strNum; ++i)
+        {
+            // the result of analyzing the converted string
+            const string normStr = analyzer_->convertCharacters(strs[i]);
+            analyzer_->setOption(Analyzer::OPTION_TYPE_NORMALIZE_INPUT, 0);
+            const MorphemeViewList expectViews = analyzer_->runWithView(normStr.c_str());
+            vector<string> expectLexicons;
+            for(unsigned int j=0; j<expectViews.size(); ++j)
+                expectLexicons.push_back(string(expectViews[j].lexicon_, expectViews[j].lexiconLength_));
+
+            analyzer_->setOption(Analyzer::OPTION_TYPE_NORMALIZE_INPUT, 1);
+            const MorphemeViewList& views = analyzer_->runWithView(strs[i]);
+            ASSERT_EQ(expectLexicons.size(), views.size());
+
+            const string str = strs[i];
+            unsigned int prevEnd = 0;
+            for(unsigned int j=0; j<views.size(); ++j)
+            {
+                const MorphemeView& view = views[j];
+                EXPECT_EQ(expectLexicons[j], string(view.lexicon_, view.lexiconLength_));
+
+                // the offsets in original string
+                ASSERT_GE(view.byteOffset_, prevEnd);
+                ASSERT_LE(view.byteOffset_ + view.byteLength_, str.size());
+                const string origStr = str.substr(view.byteOffset_, view.byteLength_);
+                EXPECT_EQ(expectLexicons[j], analyzer_->convertCharacters(origStr.c_str()));
+                EXPECT_EQ(countUTF8Chars(strs[i], view.byteOffset_), static_cast<int>(view.charOffset_));
+                EXPECT_EQ(countUTF8Chars(origStr.c_str(), view.byteLength_), static_cast<int>(view.charLength_));
+                prevEnd = view.byteOffset_ + view.byteLength_;
+            }
+        }
+    }
+
+    // no conversion is enabled
+    analyzer_->setOption(Analyzer::OPTION_TYPE_CONVERT_TO_FULL_WIDTH, 0);
+    analyzer_->setOption(Analyzer::OPTION_TYPE_CONVERT_TO_HIRAGANA, 0);
+    const string textStr = analyzer_->runWithString(strs[1]);
+    analyzer_->setOption(Analyzer::OPTION_TYPE_NORMALIZE_INPUT, 0);
+    EXPECT_EQ(analyzer_->runWithString(strs[1]), textStr);
+}
+
+TEST_F(JMA_AnalyzerTest, morphemeHierarchy) {
+    MorphemeHierarchy hierarchy;
+    analyzer_->runWithHierarchy("", hierarchy);
+    EXPECT_TRUE(hierarchy.coarse_.empty());
+    EXPECT_TRUE(hierarchy.fine_.empty());
+
+    for(unsigned int i=0; i<SAMPLE_SENTENCE_NUM; ++i)
+    {
+        const char* str = SAMPLE_SENTENCES[i];
+
+        // each level is the same as analyzing with its options
+        analyzer_->setOption(Analyzer::OPTION_TYPE_COMPOUND_MORPHOLOGY, 1);
+        analyzer_->setOption(Analyzer::OPTION_TYPE_DECOMPOSE_USER_NOUN, 0);
+        const MorphemeViewList coarseViews = analyzer_->runWithView(str);
+        analyzer_->setOption(Analyzer::OPTION_TYPE_COMPOUND_MORPHOLOGY, 0);
+        analyzer_->setOption(Analyzer::OPTION_TYPE_DECOMPOSE_USER_NOUN, 1);
+        const MorphemeViewList fineViews = analyzer_->runWithView(str);
+
+        vector<string> coarseLexicons, fineLexicons;
+        for(unsigned int j=0; j<coarseViews.size(); ++j)
+            coarseLexicons.push_back(string(coarseViews[j].lexicon_, coarseViews[j].lexiconLength_));
+        for(unsigned int j=0; j<fineViews.size(); ++j)
+            fineLexicons.push_back(string(fineViews[j].lexicon_, fineViews[j].lexiconLength_));
+
+        analyzer_->runWithHierarchy(str, hierarchy);
+        ASSERT_EQ(coarseViews.size(), hierarchy.coarse_.size());
+        ASSERT_EQ(coarseViews.size(), hierarchy.children_.size());
+        ASSERT_EQ(fineViews.size(), hierarchy.fine_.size());
+
+        for(unsigned int j=0; j<fineViews.size(); ++j)
+        {
+            const MorphemeView& view = hierarchy.fine_[j];
+            EXPECT_EQ(fineLexicons[j], string(view.lexicon_, view.lexiconLength_));
+            EXPECT_EQ(fineViews[j].posCode_, view.posCode_);
+            EXPECT_EQ(fineViews[j].byteOffset_, view.byteOffset_);
+            EXPECT_EQ(fineViews[j].charOffset_, view.charOffset_);
+        }
+
+        unsigned int prevEnd = 0;
+        for(unsigned int j=0; j<coarseViews.size(); ++j)
+        {
+            const MorphemeView& view = hierarchy.coarse_[j];
+            EXPECT_EQ(coarseLexicons[j], string(view.lexicon_, view.lexiconLength_));
+            EXPECT_EQ(coarseViews[j].posCode_, view.posCode_);
+            EXPECT_EQ(coarseViews[j].byteOffset_, view.byteOffset_);
+            EXPECT_EQ(coarseViews[j].charOffset_, view.charOffset_);
+
+            // the children are within the range of coarse-grained morpheme
+            const MorphemeHierarchy::Range& range = hierarchy.children_[j];
+            ASSERT_LT(range.begin_, range.end_);
+            ASSERT_LE(prevEnd, range.begin_);
+            ASSERT_LE(range.end_, hierarchy.fine_.size());
+            for(unsigned int k=range.begin_; k<range.end_; ++k)
+            {
+                EXPECT_GE(hierarchy.fine_[k].byteOffset_, view.byteOffset_);
+                EXPECT_LE(hierarchy.fine_[k].byteOffset_ + hierarchy.fine_[k].byteLength_, view.byteOffset_ + view.byteLength_);
+            }
+            prevEnd = range.end_;
+        }
+    }
+
+    // the compound word and user noun link to their parts
+    analyzer_->runWithHierarchy("高さと野球選手権大会", hierarchy);
+    ASSERT_EQ(3u, hierarchy.coarse_.size());
+    EXPECT_EQ(2u, hierarchy.children_[0].end_ - hierarchy.children_[0].begin_);
+    EXPECT_EQ(1u, hierarchy.children_[1].end_ - hierarchy.children_[1].begin_);
+    EXPECT_EQ(3u, hierarchy.children_[2].end_ - hierarchy.children_[2].begin_);
+    EXPECT_EQ(6u, hierarchy.fine_.size());
+}
+
+TEST_F(JMA_AnalyzerTest, filterStopWordAndKeywordPOS) {
+    const char* str = "田中さんは三菱東京UFJ銀行に行った。長野県の野球選手権大会が開かれた。";
+
+    for(int option=0; option<4; ++option)
+    {
+        analyzer_->setOption(Analyzer::OPTION_TYPE_COMPOUND_MORPHOLOGY, option & 1);
+        analyzer_->setOption(Analyzer::OPTION_TYPE_DECOMPOSE_USER_NOUN, option & 2);
+
+        // the result before filter
+        ASSERT_EQ(1, knowledge_->loadStopWordDict(TEST_JMA_DEFAULT_STOPWORD_DICT));
+        knowledge_->setKeywordPOS(vector<string>());
+        vector<string> expectLexicons;
+        const MorphemeViewList& allViews = analyzer_->runWithView(str);
+        for(unsigned int i=0; i<allViews.size(); ++i)
+        {
+            const string lexicon(allViews[i].lexicon_, allViews[i].lexiconLength_);
+            // the stop words loaded after knowledge is set should also be filtered
+            EXPECT_FALSE(knowledge_->isStopWord(lexicon)) << lexicon;
+
+            const char* posStr = knowledge_->getPOSTable().getPOS(allViews[i].posCode_, POSTable::POS_FORMAT_ALPHABET);
+            if(! strcmp(posStr, "NP-S") || ! strcmp(posStr, "NC-G") || ! strcmp(posStr, "V-I"))
+                expectLexicons.push_back(lexicon);
+        }
+
+        vector<string> posVec;
+        posVec.push_back("NP-S");
+        posVec.push_back("NC-G");
+        posVec.push_back("V-I");
+        knowledge_->setKeywordPOS(posVec);
+
+        const MorphemeViewList& views = analyzer_->runWithView(str);
+        ASSERT_EQ(expectLexicons.size(), views.size());
+        for(unsigned int i=0; i<views.size(); ++i)
+            EXPECT_EQ(expectLexicons[i], string(views[i].lexicon_, views[i].lexiconLength_));
+
+        // the same result in morpheme list
+        Sentence sent(str);
+        analyzer_->runOneBest(sent);
+        ASSERT_EQ(1, sent.getListSize());
+        ASSERT_EQ(static_cast<int>(expectLexicons.size()), sent.getCount(0));
+        for(int i=0; i<sent.getCount(0); ++i)
+            EXPECT_EQ(expectLexicons[i], sent.getLexicon(0, i));
+
+        knowledge_->setKeywordPOS(vector<string>());
+    }
+}
+
+/**
+ * The sink to record the sentences and the lexicons of each sentence.
+ */
+class RecordSink : public MorphemeSink
+{
+public:
+    virtual void beginSentence(const char* sentence) {
+        sentences_.push_back(sentence);
+        lexicons_.push_back(vector<string>());
+    }
+
+    virtual void processMorpheme(const MorphemeView& view) {
+        // when called by analyzeSentence(), no sentence is begun
+        if(lexicons_.empty())
+            lexicons_.push_back(vector<string>());
+
+        lexicons_.back().push_back(string(view.lexicon_, view.lexiconLength_));
+    }
+
+    virtual void endSentence() {
+        ++endCount_;
+    }
+
+    RecordSink() : endCount_(0) {}
+
+    vector<string> sentences_;
+    vector<vector<string> > lexicons_;
+    int endCount_;
+};
+
+TEST_F(JMA_AnalyzerTest, analyzeSink) {
+    RecordSink emptySink;
+    analyzer_->analyze("", emptySink);
+    EXPECT_TRUE(emptySink.sentences_.empty());
+    EXPECT_EQ(0, emptySink.endCount_);
+
+    const char* paraStr = "田中さんは三菱東京UFJ銀行に行った。どういう意味でしょうか？ 長野県の野球選手権大会";
+    vector<Sentence> sentVec;
+    analyzer_->splitSentence(paraStr, sentVec);
+    ASSERT_EQ(3u, sentVec.size());
+
+    RecordSink sink;
+    analyzer_->analyze(paraStr, sink);
+    ASSERT_EQ(sentVec.size(), sink.sentences_.size());
+    ASSERT_EQ(sentVec.size(), sink.lexicons_.size());
+    EXPECT_EQ(static_cast<int>(sentVec.size()), sink.endCount_);
+
+    for(unsigned int i=0; i<sentVec.size(); ++i)
+    {
+        EXPECT_EQ(sentVec[i].getString(), sink.sentences_[i]);
+
+        analyzer_->runOneBest(sentVec[i]);
+        ASSERT_EQ(1, sentVec[i].getListSize());
+        ASSERT_EQ(sentVec[i].getCount(0), static_cast<int>(sink.lexicons_[i].size()));
+        for(int j=0; j<sentVec[i].getCount(0); ++j)
+        {
+            EXPECT_EQ(sentVec[i].getLexicon(0, j), sink.lexicons_[i][j]);
+        }
+
+        RecordSink sentenceSink;
+        analyzer_->analyzeSentence(sentVec[i].getString(), sentenceSink);
+        EXPECT_TRUE(sentenceSink.sentences_.empty());
+        EXPECT_EQ(0, sentenceSink.endCount_);
+        ASSERT_EQ(1u, sentenceSink.lexicons_.size());
+        EXPECT_TRUE(sink.lexicons_[i] == sentenceSink.lexicons_[0]);
+    }
+}
+
+TEST_F(JMA_AnalyzerTest, termFrequency) {
+    TermFrequency table;
+    analyzer_->runWithTermFrequency("", table);
+    EXPECT_EQ(0u, table.size());
+    EXPECT_EQ(0u, table.getTotal());
+
+    const char* paraStr = "田中さんは銀行に行った。田中さんは銀行に行きます。 長野県の銀行";
+    vector<string> posVec;
+    posVec.push_back("NP-S");
+    posVec.push_back("NC-G");
+    posVec.push_back("V-I");
+
+    for(int option=0; option<2; ++option)
+    {
+        knowledge_->setKeywordPOS(option ? posVec : vector<string>());
+
+        // count the morphemes in each sentence
+        vector<Sentence> sentVec;
+        analyzer_->splitSentence(paraStr, sentVec);
+        vector<MorphemeView> views;
+        vector<string> lexicons, baseForms;
+        analyzer_->setOption(Analyzer::OPTION_TYPE_MORPHEME_FIELDS, Analyzer::MORPHEME_FIELD_ALL);
+        for(unsigned int i=0; i<sentVec.size(); ++i)
+        {
+            const MorphemeViewList& sentViews = analyzer_->runWithView(sentVec[i].getString());
+            for(unsigned int j=0; j<sentViews.size(); ++j)
+            {
+                views.push_back(sentViews[j]);
+                lexicons.push_back(string(sentViews[j].lexicon_, sentViews[j].lexiconLength_));
+                baseForms.push_back(string(sentViews[j].baseForm_, sentViews[j].baseFormLength_));
+            }
+        }
+
+        table.setKeyType(TermFrequency::KEY_TERM_ID);
+        analyzer_->runWithTermFrequency(paraStr, table);
+        EXPECT_EQ(views.size(), table.getTotal());
+        for(unsigned int i=0; i<views.size(); ++i)
+        {
+            unsigned int count = 0;
+            for(unsigned int j=0; j<views.size(); ++j)
+            {
+                if(views[i].termId_ >= 0 ? views[j].termId_ == views[i].termId_ : (views[j].termId_ < 0 && lexicons[j] == lexicons[i]))
+                    ++count;
+            }
+            EXPECT_EQ(count, table.getCount(views[i].termId_, lexicons[i].c_str(), lexicons[i].size())) << lexicons[i];
+        }
+
+        table.setKeyType(TermFrequency::KEY_BASE_FORM);
+        analyzer_->runWithTermFrequency(paraStr, table);
+        EXPECT_EQ(views.size(), table.getTotal());
+        for(unsigned int i=0; i<views.size(); ++i)
+        {
+            unsigned int count = 0;
+            for(unsigned int j=0; j<views.size(); ++j)
+            {
+                if(baseForms[j] == baseForms[i])
+                    ++count;
+            }
+            EXPECT_EQ(count, table.getCount(-1, baseForms[i].c_str(), baseForms[i].size())) << baseForms[i];
+        }
+
+        // the inflected forms of "行く" are the same term
+        if(! option)
+        {
+            EXPECT_EQ(2u, table.getCount(-1, "行く", strlen("行く")));
+        }
+    }
+
+    knowledge_->setKeywordPOS(vector<string>());
+}
+
+/**
+ * The sink to record the byte range of each morpheme in paragraph.
+ */
+class OffsetSink : public MorphemeSink
+{
+public:
+    virtual void processMorpheme(const MorphemeView& view) {
+        offsets_.push_back(sentOffset_ + view.byteOffset_);
+        offsets_.push_back(sentOffset_ + view.byteOffset_ + view.byteLength_);
+    }
+
+    virtual void endSentence() {
+        sentOffset_ = sentOffset_ + sentLength_;
+    }
+
+    virtual void beginSentence(const char* sentence) {
+        sentLength_ = strlen(sentence);
+    }
+
+    OffsetSink() : sentOffset_(0), sentLength_(0) {}
+
+    vector<unsigned int> offsets_;
+    unsigned int sentOffset_;
+    unsigned int sentLength_;
+};
+
+TEST_F(JMA_AnalyzerTest, segment) {
+    vector<unsigned int> offsets(1, 0);
+    analyzer_->runWithSegment("", offsets);
+    EXPECT_TRUE(offsets.empty());
+
+    const char* paraStr = "田中さんは三菱東京UFJ銀行に行った。どういう意味でしょうか？ 長野県の野球選手権大会　ｱｲｳ";
+
+    for(int option=0; option<8; ++option)
+    {
+        analyzer_->setOption(Analyzer::OPTION_TYPE_COMPOUND_MORPHOLOGY, option & 1);
+        analyzer_->setOption(Analyzer::OPTION_TYPE_DECOMPOSE_USER_NOUN, option & 2);
+        analyzer_->setOption(Analyzer::OPTION_TYPE_NORMALIZE_INPUT, option & 4);
+        analyzer_->setOption(Analyzer::OPTION_TYPE_CONVERT_TO_FULL_WIDTH, option & 4);
+
+        // the same words as full analysis
+        OffsetSink sink;
+        analyzer_->analyze(paraStr, sink);
+        ASSERT_FALSE(sink.offsets_.empty());
+        analyzer_->runWithSegment(paraStr, offsets);
+        EXPECT_TRUE(sink.offsets_ == offsets) << "option: " << option;
+
+        string expectSurfaces;
+        for(unsigned int i=0; i<sink.offsets_.size(); i+=2)
+        {
+            expectSurfaces.append(paraStr + sink.offsets_[i], sink.offsets_[i+1] - sink.offsets_[i]);
+            expectSurfaces += analyzer_->getWordDelimiter();
+        }
+        string surfaces;
+        analyzer_->runWithSegment(paraStr, surfaces);
+        EXPECT_EQ(expectSurfaces, surfaces);
+    }
+
+    // n-best is not affected after segmentation
+    Sentence sent("田中さんは銀行に行った。");
+    analyzer_->setOption(Analyzer::OPTION_TYPE_NBEST, 3);
+    ASSERT_EQ(1, analyzer_->runWithSentence(sent));
+    EXPECT_LT(1, sent.getListSize());
+}
+
+TEST_F(JMA_AnalyzerTest, longestMatch) {
+    const char* str = "すもももももももものうち";
+    analyzer_->setOption(Analyzer::OPTION_TYPE_COMPOUND_MORPHOLOGY, 0);
+    analyzer_->setOption(Analyzer::OPTION_TYPE_POS_FORMAT_ALPHABET, 1);
+    EXPECT_STREQ("すもも/NC-G  も/PL-A  もも/NC-G  も/PL-A  もも/NC-G  の/PL-N  うち/ND-D  ", analyzer_->runWithString(str));
+
+    // the longest word from the begin, regardless of connection costs
+    analyzer_->setOption(Analyzer::OPTION_TYPE_LONGEST_MATCH, 1);
+    EXPECT_STREQ("すもも/NC-G  もも/NC-G  もも/NC-G  もも/NC-G  のう/PL-E  ち/V-I  ", analyzer_->runWithString(str));
+    EXPECT_STREQ("今日/N-D  は/PL-A  良い/AJ-I  天気/NC-G  です/AUV  ね/PL-E  ", analyzer_->runWithString("今日は良い天気ですね"));
+
+    // the words cover the whole input, and the trailing spaces are ignored
+    const char* paraStr = "田中さんは三菱東京UFJ銀行に行った。 ｱｲｳ　";
+    vector<unsigned int> offsets;
+    analyzer_->runWithSegment(paraStr, offsets);
+    ASSERT_FALSE(offsets.empty());
+    OffsetSink sink;
+    analyzer_->analyze(paraStr, sink);
+    EXPECT_TRUE(sink.offsets_ == offsets);
+    string words;
+    for(unsigned int i=0; i<offsets.size(); i+=2)
+        words.append(paraStr + offsets[i], offsets[i+1] - offsets[i]);
+    EXPECT_EQ("田中さんは三菱東京UFJ銀行に行った。ｱｲｳ", words);
+
+    // n-best is still got by Viterbi search
+    Sentence sent(str);
+    analyzer_->setOption(Analyzer::OPTION_TYPE_NBEST, 3);
+    ASSERT_EQ(1, analyzer_->runWithSentence(sent));
+    ASSERT_LT(1, sent.getListSize());
+    ASSERT_LT(1, sent.getCount(0));
+    EXPECT_STREQ("も", sent.getLexicon(0, 1));
+}
+
+TEST_F(JMA_AnalyzerTest, streamWorkers) {
+    const char* strInputFile = "aaa.txt";
+    const char* strOutputFile = "bbb.txt";
+
+    // more lines than a batch, with empty lines and the last line not ended
+    const char* lines[] = {"田中さんは三菱東京UFJ銀行に行った。", "", "どういう意味でしょうか？", "abc 123", "本田総一郎"};
+    const int lineNum = sizeof(lines) / sizeof(lines[0]);
+    {
+        ofstream ofs(strInputFile);
+        ASSERT_TRUE(ofs);
+        for(int i=0; i<500; ++i)
+            ofs << lines[i % lineNum] << (i % 7) << endl;
+        ofs << lines[0];
+    }
+
+    analyzer_->setOption(Analyzer::OPTION_TYPE_POS_FORMAT_ALPHABET, 1);
+    for(int tokenStream=0; tokenStream<2; ++tokenStream)
+    {
+        analyzer_->setOption(Analyzer::OPTION_TYPE_OUTPUT_TOKEN_STREAM, tokenStream);
+
+        analyzer_->setOption(Analyzer::OPTION_TYPE_STREAM_WORKER_NUM, 0);
+        ASSERT_EQ(1, analyzer_->runWithStream(strInputFile, strOutputFile));
+        ifstream serialIfs(strOutputFile, ios::in | ios::binary);
+        const string serialStr((istreambuf_iterator<char>(serialIfs)), istreambuf_iterator<char>());
+        EXPECT_FALSE(serialStr.empty());
+
+        // the options of analyzer are applied in each worker
+        analyzer_->setOption(Analyzer::OPTION_TYPE_STREAM_WORKER_NUM, 3);
+        ASSERT_EQ(1, analyzer_->runWithStream(strInputFile, strOutputFile));
+        ifstream workerIfs(strOutputFile, ios::in | ios::binary);
+        const string workerStr((istreambuf_iterator<char>(workerIfs)), istreambuf_iterator<char>());
+        EXPECT_EQ(serialStr, workerStr);
+    }
+
+    EXPECT_EQ(0, analyzer_->runWithStream("aaa", "bbb"));
+
+    EXPECT_TRUE(removeFile(strInputFile));
+    EXPECT_TRUE(removeFile(strOutputFile));
+}
+
+TEST_F(JMA_AnalyzerTest, runBatch) {
+    // skewed sentence lengths, with an empty sentence
+    vector<Sentence> serial;
+    string longStr;
+    for(int i=0; i<200; ++i)
+    {
+        if(i % 40 == 0)
+            serial.push_back(Sentence(longStr.c_str()));
+        longStr += "田中さんは行った";
+        serial.push_back(Sentence("どういう意味でしょうか"));
+        serial.push_back(Sentence("来た"));
+    }
+    vector<Sentence> batch(serial);
+
+    analyzer_->setOption(Analyzer::OPTION_TYPE_NBEST, 2);
+    for(unsigned int i=0; i<serial.size(); ++i)
+        ASSERT_EQ(1, analyzer_->runWithSentence(serial[i]));
+    ASSERT_EQ(1, analyzer_->runBatch(batch, 4));
+
+    for(unsigned int i=0; i<serial.size(); ++i)
+    {
+        ASSERT_EQ(serial[i].getListSize(), batch[i].getListSize());
+        for(int j=0; j<serial[i].getListSize(); ++j)
+        {
+            ASSERT_EQ(serial[i].getCount(j), batch[i].getCount(j));
+            EXPECT_EQ(serial[i].getScore(j), batch[i].getScore(j));
+            for(int k=0; k<serial[i].getCount(j); ++k)
+            {
+                EXPECT_STREQ(serial[i].getLexicon(j, k), batch[i].getLexicon(j, k));
+                EXPECT_STREQ(serial[i].getStrPOS(j, k), batch[i].getStrPOS(j, k));
+            }
+        }
+    }
+
+    // the workers kept from last call follow the changed options
+    analyzer_->setOption(Analyzer::OPTION_TYPE_NBEST, 1);
+    for(int option=1; option>=0; --option)
+    {
+        analyzer_->setOption(Analyzer::OPTION_TYPE_COMPOUND_MORPHOLOGY, option);
+        vector<Sentence> compounds(8, Sentence("高さ"));
+        ASSERT_EQ(1, analyzer_->runBatch(compounds, 4));
+        for(unsigned int i=0; i<compounds.size(); ++i)
+        {
+            ASSERT_EQ(1, compounds[i].getListSize());
+            EXPECT_EQ(option ? 1 : 2, compounds[i].getCount(0));
+        }
+    }
+
+    // more threads than sentences, and in the calling thread only
+    vector<Sentence> few(2, Sentence("来た"));
+    EXPECT_EQ(1, analyzer_->runBatch(few, 8));
+    EXPECT_STREQ("来", few[1].getLexicon(0, 0));
+    vector<Sentence> one(1, Sentence("来た"));
+    EXPECT_EQ(1, analyzer_->runBatch(one, 1));
+    EXPECT_STREQ("た", one[0].getLexicon(0, 1));
+    vector<Sentence> none;
+    EXPECT_EQ(1, analyzer_->runBatch(none, 4));
+}
+
 TEST_F(JMA_AnalyzerTest, posFormatNone) {
     analyzer_->setOption(Analyzer::OPTION_TYPE_POS_TAGGING, 0);
     EXPECT_STREQ("123  ", analyzer_->runWithString("123"));
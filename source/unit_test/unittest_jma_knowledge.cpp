@@ -64,6 +64,11 @@ protected:
 
         const JMA_Knowledge::DecompMap& decompMap = knowledge_->getDecompMap();
         EXPECT_EQ(3u, decompMap.size());
+
+        const JMA_Knowledge::DecompTable& decompTable = knowledge_->getDecompTable();
+        ASSERT_EQ(4u, decompTable.offsets_.size());
+        EXPECT_EQ(0u, decompTable.offsets_[0]);
+        EXPECT_EQ(decompTable.morphemes_.size(), decompTable.offsets_.back());
     }
 
     virtual void printDict() {
@@ -101,6 +106,10 @@ TEST_F(JMA_Knowledge_Test, getValueDefault) {
 
     const JMA_Knowledge::DecompMap& decompMap = knowledge_->getDecompMap();
     EXPECT_EQ(0u, decompMap.size());
+
+    const JMA_Knowledge::DecompTable& decompTable = knowledge_->getDecompTable();
+    EXPECT_EQ(1u, decompTable.offsets_.size());
+    EXPECT_TRUE(decompTable.morphemes_.empty());
 }
 
 TEST_F(JMA_Knowledge_Test, loadFail) {
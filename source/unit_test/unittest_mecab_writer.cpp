@@ -0,0 +1,387 @@
+/** \file unittest_mecab_writer.cpp
+ * Unit test of the compiled output formats in class MeCab::Writer.
+ *
+ * \version 0.1
+ * \date Oct 18, 2026
+ */
+
+#include <gtest/gtest.h>
+#include "writer.h" // MeCab::Writer
+#include "common.h" // CHECK_FALSE
+#include "utils.h" // tokenizeCSV, getEscapedChar
+
+#include <string>
+#include <cstring> // memset, strlen, strncpy
+
+using namespace std;
+using namespace MeCab;
+
+namespace
+{
+/**
+ * InterpretedWriter formats a node by interpreting the format string on each call,
+ * which is the implementation of \e MeCab::Writer::writeNode() before the formats are compiled,
+ * and is kept here as the reference result.
+ */
+class InterpretedWriter
+{
+public:
+    bool writeNode(StringBuffer *os, const char *p,
+                   const char *sentence, const Node *node) {
+      char buf[BUF_SIZE];
+      char *ptr[64];
+      size_t psize = 0;
+
+      for (; *p; p++) {
+        switch (*p) {
+          default: *os << *p; break;
+
+          case '\\': *os << getEscapedChar(*++p); break;
+
+          case '%': {  // macros
+            switch (*++p) {
+              default: CHECK_FALSE(false) << "unkonwn meta char " << *p;
+              case 'S': os->write(sentence, std::strlen(sentence)); break;
+              case 'L': *os << std::strlen(sentence); break;
+              case 'm': os->write(node->surface, node->length); break;
+              case 'M': os->write(reinterpret_cast<const char *>
+                                  (node->surface - node->rlength + node->length),
+                                  node->rlength);
+                break;
+              case 'h': *os << node->posid; break;
+              case '%': *os << '%'; break;
+              case 'c': *os << static_cast<int>(node->wcost); break;
+              case 'H': *os << node->feature; break;
+              case 't': *os << static_cast<unsigned int>(node->char_type); break;
+              case 's': *os << static_cast<unsigned int>(node->stat); break;
+              case 'P': *os << node->prob; break;
+              case 'p': {
+                switch (*++p) {
+                  default: CHECK_FALSE(false)
+                      << "[iseSCwcnblLh] is required after %p";
+                  case 'i': *os << node->id; break;
+                  case 'S': os->write(reinterpret_cast<const char*>
+                                      (node->surface -
+                                       node->rlength + node->length),
+                                      node->rlength - node->length);
+                    break;
+                  case 's': *os << static_cast<int>(node->surface - sentence);
+                    break;
+                  case 'e': *os << static_cast<int>
+                        (node->surface - sentence + node->length);
+                    break;
+                  case 'C': *os << node->cost -
+                        node->prev->cost - node->wcost;
+                    break;
+                  case 'w': *os << node->wcost; break;
+                  case 'c': *os << node->cost; break;
+                  case 'n': *os << (node->cost - node->prev->cost); break;
+                  case 'b': *os << (node->isbest ? '*' : ' '); break;
+                  case 'P': *os << node->prob; break;
+                  case 'A': *os << node->alpha; break;
+                  case 'B': *os << node->beta; break;
+                  case 'l': *os << node->length; break;
+                  case 'L': *os << node->rlength;    break;
+                  case 'h': {
+                    switch (*++p) {
+                      default: CHECK_FALSE(false) << "lr is required after %ph";
+                      case 'l': *os << node->lcAttr; break;
+                      case 'r': *os << node->rcAttr; break;
+                    }
+                  } break;
+
+                  case 'p': {
+                    char mode = *++p;
+                    char sep = *++p;
+                    if (sep == '\\') sep = getEscapedChar(*++p);
+                    CHECK_FALSE(node->lpath)
+                        << "no path information, use -l option";
+                    for (Path *path = node->lpath; path; path = path->lnext) {
+                      if (path != node->lpath) *os << sep;
+                      switch (mode) {
+                        case 'i': *os << path->lnode->id; break;
+                        case 'c': *os << path->cost; break;
+                        case 'P': *os << path->prob; break;
+                        default: CHECK_FALSE(false)
+                            << "[icP] is required after %pp";
+                      }
+                    }
+                  } break;
+                }
+              } break;
+
+              case 'F':
+              case 'f': {
+                CHECK_FALSE(node->feature[0] != '\0')
+                    << "no feature information available";
+
+                if (!psize) {
+                  std::strncpy(buf, node->feature, sizeof(buf) - 1);
+                  buf[sizeof(buf) - 1] = '\0';
+                  psize = tokenizeCSV(buf, ptr, sizeof(ptr) / sizeof(ptr[0]));
+                }
+
+                char separator = '\t';
+                if (*p == 'F') {
+                  if (*++p == '\\')
+                    separator = getEscapedChar(*++p);
+                  else
+                    separator = *p;
+                }
+
+                CHECK_FALSE(*++p =='[') << "cannot find '['";
+                size_t n = 0;
+                bool sep = false;
+                bool isfil = false;
+                p++;
+
+                for (;; ++p) {
+                  switch (*p) {
+                    case '0': case '1': case '2': case '3': case '4':
+                    case '5': case '6': case '7': case '8': case '9':
+                      n = 10 * n +(*p - '0');
+                      break;
+                    case ',': case ']':
+                      CHECK_FALSE(n < psize) << "given index is out of range";
+                      isfil = (ptr[n][0] != '*');
+                      if (isfil) {
+                        if (sep) *os << separator;
+                        *os << ptr[n];
+                      }
+                      if (*p == ']') goto last;
+                      sep = isfil;
+                      n = 0;
+                      break;
+                    default:
+                      CHECK_FALSE(false) << "cannot find ']'";
+                  }
+                }
+              } last: break;
+            }
+          } break;
+        }
+      }
+
+      return true;
+    }
+
+private:
+    whatlog what_;
+};
+
+/** the sentence, in which the nodes refer to */
+const char* SENTENCE = "高さを 測る";
+
+/** the features, including those with quoted, empty, spaced and missing columns */
+const char* FEATURES[] = {
+    "名詞,一般,*,*,*,*,高さ,タカサ,タカサ",
+    "名詞,\"固有名詞,人名\",*,*,*,*,\"\"\"高さ\"\"\",タカサ,タカサ",
+    "記号,,*,*,,*,*",
+    " 動詞,\t自立,*, *,五段・ラ行,基本形,測る,ハカル,ハカル",
+    "名詞,一般,*,*,*,*,*",
+    "名詞"
+};
+
+/** the number of features */
+const int FEATURE_NUM = sizeof(FEATURES) / sizeof(FEATURES[0]);
+
+/** the formats, some of which fail on the features without enough columns */
+const char* FORMATS[] = {
+    "%m\\t%H\\n",
+    "EOS\\n",
+    "",
+    "%f[0]",
+    "%f[6]",
+    "%f[0,1,2,3]\\n",
+    "%F-[0,1,2,3]",
+    "%F\\s[6,7,8]",
+    "%F,[1,0]",
+    "%f[8]",
+    "%m\\t%f[7]\\t%f[0]\\t%F/[2,1]\\n",
+    "\\t\\n\\s\\\\%%a%%%%b",
+    "100%% %m",
+    "%S %L %m %M %h %c %H %t %s %P",
+    "%pi %pS %ps %pe %pC %pw %pc %pn %pb %pP %pA %pB %pl %pL %phl %phr",
+    "%ppi, %ppc\\t %ppP|"
+};
+
+/** the number of formats */
+const int FORMAT_NUM = sizeof(FORMATS) / sizeof(FORMATS[0]);
+
+/**
+ * Get the output of string buffer.
+ */
+string getOutput(StringBuffer& buffer)
+{
+    buffer << '\0';
+    return buffer.str();
+}
+}
+
+class MeCab_WriterTest : public ::testing::Test
+{
+protected:
+    virtual void SetUp()
+    {
+        memset(nodes_, 0, sizeof(nodes_));
+        memset(paths_, 0, sizeof(paths_));
+
+        // BOS, "高さ", "を", " 測る", EOS
+        const char* words[] = {"", "高さ", "を", " 測る", ""};
+        const char* p = SENTENCE;
+        for(int i=0; i<NODE_NUM; ++i)
+        {
+            Node& node = nodes_[i];
+            const char* surface = words[i];
+            while(*surface == ' ')
+            {
+                ++surface;
+                ++p;
+            }
+            node.surface = p;
+            node.length = strlen(surface);
+            node.rlength = strlen(words[i]);
+            p += node.length;
+
+            node.prev = (i > 0) ? &nodes_[i-1] : 0;
+            node.next = (i + 1 < NODE_NUM) ? &nodes_[i+1] : 0;
+            node.feature = "";
+            node.id = i;
+            node.rcAttr = 10 + i;
+            node.lcAttr = 20 + i;
+            node.posid = 30 + i;
+            node.char_type = i;
+            node.stat = MECAB_NOR_NODE;
+            node.isbest = i % 2;
+            node.alpha = -1.5f * i;
+            node.beta = 2.25f * i;
+            node.prob = 0.125f * i;
+            node.wcost = 100 * i - 150;
+            node.cost = 1000 * i;
+        }
+        nodes_[0].stat = MECAB_BOS_NODE;
+        nodes_[NODE_NUM-1].stat = MECAB_EOS_NODE;
+        nodes_[2].stat = MECAB_UNK_NODE;
+
+        // two paths to " 測る"
+        for(int i=0; i<PATH_NUM; ++i)
+        {
+            paths_[i].rnode = &nodes_[3];
+            paths_[i].lnode = &nodes_[i+1];
+            paths_[i].lnext = (i + 1 < PATH_NUM) ? &paths_[i+1] : 0;
+            paths_[i].cost = 7 * i - 3;
+            paths_[i].prob = 0.5f * i;
+        }
+        nodes_[3].lpath = &paths_[0];
+    }
+
+    /**
+     * Check that the output of compiled format is the same as interpreting it on each node.
+     * \param format the format string
+     * \param node the node to format
+     */
+    void checkFormat(const char* format, const Node& node)
+    {
+        SCOPED_TRACE(string("format: ") + format + ", feature: " + node.feature + ", surface: " + string(node.surface, node.length));
+
+        InterpretedWriter interpreter;
+        StringBuffer expect;
+        const bool expectResult = interpreter.writeNode(&expect, format, SENTENCE, &node);
+
+        Writer writer;
+        StringBuffer actual;
+        const bool actualResult = writer.writeNode(&actual, format, SENTENCE, &node);
+
+        EXPECT_EQ(expectResult, actualResult);
+        if(expectResult && actualResult)
+        {
+            EXPECT_EQ(getOutput(expect), getOutput(actual));
+        }
+    }
+
+    /** the number of nodes, including BOS and EOS */
+    static const int NODE_NUM = 5;
+
+    /** the number of paths */
+    static const int PATH_NUM = 2;
+
+    /** the nodes */
+    Node nodes_[NODE_NUM];
+
+    /** the paths */
+    Path paths_[PATH_NUM];
+};
+
+TEST_F(MeCab_WriterTest, compileFormat) {
+    for(int i=0; i<FORMAT_NUM; ++i)
+    {
+        for(int j=0; j<FEATURE_NUM; ++j)
+        {
+            // except BOS node, as %pC and %pn need the previous node
+            for(int k=1; k<NODE_NUM; ++k)
+            {
+                nodes_[k].feature = FEATURES[j];
+                checkFormat(FORMATS[i], nodes_[k]);
+            }
+        }
+    }
+}
+
+TEST_F(MeCab_WriterTest, compileOnce) {
+    // a compiled format is used on different nodes and features
+    Writer writer;
+    Writer::Format format;
+    const char* fmt = "%m\\t%f[0]\\t%F-[6,1]\\t%H\\n";
+    ASSERT_TRUE(writer.compile(fmt, &format));
+
+    InterpretedWriter interpreter;
+    StringBuffer expect, actual;
+    for(int j=0; j<FEATURE_NUM - 1; ++j)
+    {
+        for(int k=1; k+1<NODE_NUM; ++k)
+        {
+            nodes_[k].feature = FEATURES[j];
+            ASSERT_TRUE(interpreter.writeNode(&expect, fmt, SENTENCE, &nodes_[k]));
+            ASSERT_TRUE(writer.writeNode(&actual, format, SENTENCE, &nodes_[k]));
+        }
+    }
+    EXPECT_EQ(getOutput(expect), getOutput(actual));
+}
+
+TEST_F(MeCab_WriterTest, quotedFeature) {
+    // the quoted columns are unescaped by tokenizeCSV()
+    Writer writer;
+    StringBuffer buffer;
+    nodes_[1].feature = FEATURES[1];
+    ASSERT_TRUE(writer.writeNode(&buffer, "%f[1]|%f[6]|%F,[7,8]", SENTENCE, &nodes_[1]));
+    EXPECT_EQ("固有名詞,人名|\"高さ\"|タカサ,タカサ", getOutput(buffer));
+}
+
+TEST_F(MeCab_WriterTest, escapeFormat) {
+    Writer writer;
+    StringBuffer buffer;
+    nodes_[1].feature = FEATURES[0];
+    ASSERT_TRUE(writer.writeNode(&buffer, "\\t\\n\\s\\\\%%%m%%", SENTENCE, &nodes_[1]));
+    EXPECT_EQ("\t\n \\%高さ%", getOutput(buffer));
+}
+
+TEST_F(MeCab_WriterTest, unknownDirective) {
+    const char* formats[] = {
+        "%x", "%m%", "%pz", "%phx", "%ppx,", "%f", "%f(0)", "%f[0", "%f[a]", "%F-0]"
+    };
+    const int formatNum = sizeof(formats) / sizeof(formats[0]);
+
+    nodes_[1].feature = FEATURES[0];
+    for(int i=0; i<formatNum; ++i)
+    {
+        SCOPED_TRACE(formats[i]);
+
+        Writer writer;
+        Writer::Format format;
+        EXPECT_FALSE(writer.compile(formats[i], &format));
+        EXPECT_STRNE("", writer.what());
+
+        StringBuffer buffer;
+        EXPECT_FALSE(writer.writeNode(&buffer, formats[i], SENTENCE, &nodes_[1]));
+    }
+}
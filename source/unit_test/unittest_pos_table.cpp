@@ -0,0 +1,192 @@
+/** \file unittest_pos_table.cpp
+ * Unit test of class POSTable.
+ *
+ * \version 0.1
+ * \date Oct 18, 2026
+ */
+
+#include <gtest/gtest.h>
+#include <jma_knowledge.h>
+#include <pos_table.h>
+#include <mecab.h> // MeCab::Node
+#include "../../test_src/test_jma_common.h"
+
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <algorithm> // equal
+#include <cstring> // memset
+
+using namespace jma;
+using namespace std;
+
+namespace
+{
+/**
+ * Rule is a combination rule in "compound.def" with POS index codes.
+ */
+struct Rule
+{
+    /** the POS to combine from */
+    vector<int> sources_;
+
+    /** the POS as combination result */
+    int target_;
+};
+
+/**
+ * Load the combination rules, in which the rules with unknown POS are ignored as \e POSTable::loadCombineRule().
+ * \param fileName the rule file name
+ * \param table the POS table to get index code
+ * \param rules the rules loaded
+ */
+void loadRules(const string& fileName, const POSTable& table, vector<Rule>& rules)
+{
+    ifstream from(fileName.c_str());
+    ASSERT_TRUE(from);
+
+    string line, pos;
+    while(getline(from, line))
+    {
+        if(line.empty() || line[0] == ';' || line[0] == '#')
+            continue;
+
+        istringstream iss(line);
+        vector<int> posVec;
+        bool isValid = true;
+        while(iss >> pos)
+        {
+            posVec.push_back(table.getIndexFromAlphaPOS(pos));
+            if(posVec.back() < 0)
+                isValid = false;
+        }
+
+        if(posVec.size() < 2 || ! isValid)
+            continue;
+
+        Rule rule;
+        rule.sources_.assign(posVec.begin(), posVec.end() - 1);
+        rule.target_ = posVec.back();
+        rules.push_back(rule);
+    }
+}
+
+/**
+ * Get the longest rule matched from the start of POS sequence by checking each rule,
+ * which is the reference result of the rule automaton.
+ * \param rules the rules
+ * \param posSeq the POS sequence
+ * \return the rule index, -1 for no rule is matched
+ */
+int searchRule(const vector<Rule>& rules, const vector<int>& posSeq)
+{
+    int result = -1;
+    for(unsigned int i=0; i<rules.size(); ++i)
+    {
+        const vector<int>& sources = rules[i].sources_;
+        if(sources.size() > posSeq.size() || ! equal(sources.begin(), sources.end(), posSeq.begin()))
+            continue;
+
+        // the first rule is used for the same sources
+        if(result < 0 || sources.size() > rules[result].sources_.size())
+            result = i;
+    }
+
+    return result;
+}
+
+/**
+ * Compare the rule got by \e POSTable::getCombineRule() on the POS sequence with the reference result.
+ * \param table the POS table
+ * \param rules the rules
+ * \param posSeq the POS sequence, which is followed by the end-of-sentence node
+ * \return true if a rule is matched, false for no rule
+ */
+bool checkRule(const POSTable& table, const vector<Rule>& rules, const vector<int>& posSeq)
+{
+    // the nodes next to start node, and the end-of-sentence node
+    vector<MeCab::Node> nodes(posSeq.size());
+    memset(&nodes[0], 0, nodes.size() * sizeof(MeCab::Node));
+    for(unsigned int i=1; i<posSeq.size(); ++i)
+    {
+        nodes[i-1].posid = posSeq[i];
+        nodes[i-1].next = &nodes[i];
+    }
+
+    const RuleNode* ruleNode = table.getCombineRule(posSeq[0], &nodes[0]);
+    const int expect = searchRule(rules, posSeq);
+    if(expect < 0)
+    {
+        EXPECT_TRUE(ruleNode == 0);
+        return false;
+    }
+
+    EXPECT_TRUE(ruleNode != 0);
+    if(ruleNode)
+    {
+        EXPECT_EQ(static_cast<int>(rules[expect].sources_.size()), ruleNode->level_);
+        EXPECT_EQ(rules[expect].target_, ruleNode->target_);
+    }
+    return true;
+}
+}
+
+TEST(POSTableTest, getCombineRule) {
+    JMA_Knowledge knowledge;
+    knowledge.setSystemDict(TEST_JMA_DEFAULT_SYSTEM_DICT);
+    ASSERT_EQ(1, knowledge.loadDict());
+    const POSTable& table = knowledge.getPOSTable();
+
+    vector<Rule> rules;
+    loadRules(string(TEST_JMA_DEFAULT_SYSTEM_DICT) + "/compound.def", table, rules);
+    ASSERT_FALSE(rules.empty());
+
+    int posNum = 0;
+    while(*table.getPOS(posNum, POSTable::POS_FORMAT_ALPHABET))
+        ++posNum;
+    ASSERT_GT(posNum, 0);
+
+    unsigned int matchCount = 0, noRuleCount = 0;
+    for(unsigned int i=0; i<rules.size(); ++i)
+    {
+        // each rule, followed by another POS which might match a longer rule
+        vector<int> posSeq = rules[i].sources_;
+        EXPECT_TRUE(checkRule(table, rules, posSeq));
+        posSeq.push_back(0);
+        for(int pos=0; pos<posNum; ++pos)
+        {
+            posSeq.back() = pos;
+            EXPECT_TRUE(checkRule(table, rules, posSeq));
+        }
+
+        // the rule cut before end-of-sentence
+        if(rules[i].sources_.size() > 1)
+        {
+            posSeq.assign(rules[i].sources_.begin(), rules[i].sources_.end() - 1);
+            checkRule(table, rules, posSeq);
+        }
+    }
+
+    // each pair of POS, including those no rule starts from
+    vector<int> pairSeq(2);
+    for(int first=0; first<posNum; ++first)
+    {
+        for(int second=0; second<posNum; ++second)
+        {
+            pairSeq[0] = first;
+            pairSeq[1] = second;
+            if(checkRule(table, rules, pairSeq))
+                ++matchCount;
+            else
+                ++noRuleCount;
+        }
+    }
+    EXPECT_GT(matchCount, 0U);
+    EXPECT_GT(noRuleCount, 0U);
+
+    // the POS out of table
+    MeCab::Node eosNode;
+    memset(&eosNode, 0, sizeof(eosNode));
+    EXPECT_TRUE(table.getCombineRule(posNum, &eosNode) == 0);
+}
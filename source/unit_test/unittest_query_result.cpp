@@ -0,0 +1,42 @@
+/** \file unittest_query_result.cpp
+ * Unit test of class QueryResult.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include <gtest/gtest.h>
+#include <ijma/query_result.h>
+
+using namespace jma;
+using namespace std;
+
+TEST(QueryResultTest, inlineAndMore) {
+    QueryResult result;
+    EXPECT_TRUE(result.empty());
+    EXPECT_EQ(0u, result.size());
+
+    const unsigned int count = QueryResult::INLINE_CAPACITY * 2 + 1;
+    for(int round=0; round<2; ++round)
+    {
+        result.clear();
+        for(unsigned int i=0; i<count; ++i)
+        {
+            MorphemeView view;
+            view.byteOffset_ = i;
+            view.posCode_ = round;
+            result.push_back(view);
+        }
+
+        ASSERT_EQ(count, result.size());
+        EXPECT_FALSE(result.empty());
+        for(unsigned int i=0; i<count; ++i)
+        {
+            EXPECT_EQ(i, result[i].byteOffset_);
+            EXPECT_EQ(round, result[i].posCode_);
+        }
+    }
+
+    result.clear();
+    EXPECT_TRUE(result.empty());
+}
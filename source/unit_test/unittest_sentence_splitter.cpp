@@ -0,0 +1,92 @@
+/** \file unittest_sentence_splitter.cpp
+ * Unit test of class SentenceSplitter.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include <gtest/gtest.h>
+#include <sentence_splitter.h>
+#include <jma_ctype.h>
+
+#include <string>
+#include <cstring> // strlen
+
+using namespace jma;
+using namespace std;
+
+namespace
+{
+/**
+ * Split a string, and join the sentences with "|".
+ */
+string split(const SentenceSplitter& splitter, const char* str, const unsigned char* charLengths = 0)
+{
+    SentenceSpanList spans;
+    splitter.split(str, strlen(str), spans, charLengths);
+
+    string result;
+    unsigned int prevEnd = 0;
+    for(unsigned int i=0; i<spans.size(); ++i)
+    {
+        // the spans are contiguous
+        EXPECT_EQ(prevEnd, spans[i].offset_);
+        prevEnd = spans[i].offset_ + spans[i].length_;
+
+        if(i)
+            result += "|";
+        result.append(str + spans[i].offset_, spans[i].length_);
+    }
+    EXPECT_EQ(strlen(str), prevEnd);
+
+    return result;
+}
+}
+
+TEST(SentenceSplitterTest, empty) {
+    SentenceSplitter splitter;
+    EXPECT_EQ("", split(splitter, ""));
+    EXPECT_EQ("abc。def", split(splitter, "abc。def"));
+
+    splitter.build(set<string>(), JMA_CType::instance(Knowledge::ENCODE_TYPE_UTF8), true);
+    EXPECT_EQ("abc。def", split(splitter, "abc。def"));
+}
+
+TEST(SentenceSplitterTest, utf8) {
+    set<string> seps;
+    seps.insert("!");
+    seps.insert("。");
+    seps.insert("！");
+    seps.insert("ab"); // not a character
+
+    SentenceSplitter splitter;
+    splitter.build(seps, JMA_CType::instance(Knowledge::ENCODE_TYPE_UTF8), true);
+
+    EXPECT_EQ("!", split(splitter, "!"));
+    EXPECT_EQ("。|。", split(splitter, "。。"));
+    EXPECT_EQ("ab,ab.ab", split(splitter, "ab,ab.ab"));
+
+    // longer than a word to pass through the word scan
+    EXPECT_EQ("abcdefghijklmnopqrstuvwxyz!|これは、テストです。|ｘｙｚ！|tail", split(splitter, "abcdefghijklmnopqrstuvwxyz!これは、テストです。ｘｙｚ！tail"));
+
+    // the same lead byte as separator
+    EXPECT_EQ("あいう、えお。|ゆ", split(splitter, "あいう、えお。ゆ"));
+}
+
+TEST(SentenceSplitterTest, eucjp) {
+    set<string> seps;
+    seps.insert("?");
+    seps.insert("\xA1\xA3"); // "。"
+
+    SentenceSplitter splitter;
+    splitter.build(seps, JMA_CType::instance(Knowledge::ENCODE_TYPE_EUCJP), false);
+
+    // the separator bytes within two characters are not matched
+    EXPECT_EQ("\xB0\xA1\xA3\xB0\xA1\xA3|\xB0\xA1?|ab", split(splitter, "\xB0\xA1\xA3\xB0\xA1\xA3\xB0\xA1?ab"));
+
+    // the characters already decoded are not decoded again
+    const unsigned char charLengths[] = {2, 0, 2, 0, 2, 0, 2, 0, 1, 1, 1};
+    EXPECT_EQ("\xB0\xA1\xA3\xB0\xA1\xA3|\xB0\xA1?|ab", split(splitter, "\xB0\xA1\xA3\xB0\xA1\xA3\xB0\xA1?ab", charLengths));
+    const unsigned char otherLengths[] = {1, 2, 0, 2, 0, 1, 2, 0, 1, 1, 1};
+    EXPECT_EQ("\xB0\xA1\xA3|\xB0\xA1\xA3\xB0\xA1?|ab", split(splitter, "\xB0\xA1\xA3\xB0\xA1\xA3\xB0\xA1?ab", otherLengths));
+}
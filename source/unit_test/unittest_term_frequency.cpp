@@ -0,0 +1,110 @@
+/** \file unittest_term_frequency.cpp
+ * Unit test of class TermFrequency.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include <gtest/gtest.h>
+#include <ijma/term_frequency.h>
+
+#include <string>
+#include <cstring> // strlen
+#include <cstdio> // sprintf
+
+using namespace jma;
+using namespace std;
+
+namespace
+{
+/**
+ * Get the string of a term.
+ */
+string getString(const TermFrequency& table, unsigned int i)
+{
+    const TermFrequency::Entry& entry = table.getEntry(i);
+    return string(table.getString(entry), entry.length_);
+}
+}
+
+TEST(TermFrequencyTest, termId) {
+    TermFrequency table;
+    EXPECT_EQ(TermFrequency::KEY_TERM_ID, table.getKeyType());
+    EXPECT_EQ(0u, table.size());
+
+    table.add(10, "abc", 3);
+    table.add(-1, "abc", 3);
+    table.add(10, "abd", 3); // identified by term id
+    table.add(-1, "xy", 2);
+    table.add(-1, "abc", 3);
+
+    ASSERT_EQ(3u, table.size());
+    EXPECT_EQ(5u, table.getTotal());
+
+    // in the order of first occurrence
+    EXPECT_EQ(10, table.getEntry(0).termId_);
+    EXPECT_EQ("abc", getString(table, 0));
+    EXPECT_EQ(2u, table.getEntry(0).count_);
+    EXPECT_EQ(-1, table.getEntry(1).termId_);
+    EXPECT_EQ("abc", getString(table, 1));
+    EXPECT_EQ(2u, table.getEntry(1).count_);
+    EXPECT_EQ("xy", getString(table, 2));
+    EXPECT_EQ(1u, table.getEntry(2).count_);
+
+    EXPECT_EQ(2u, table.getCount(10, "", 0));
+    EXPECT_EQ(2u, table.getCount(-1, "abc", 3));
+    EXPECT_EQ(0u, table.getCount(11, "abc", 3));
+    EXPECT_EQ(0u, table.getCount(-1, "ab", 2));
+
+    table.clear();
+    EXPECT_EQ(0u, table.size());
+    EXPECT_EQ(0u, table.getTotal());
+    EXPECT_EQ(0u, table.getCount(10, "", 0));
+}
+
+TEST(TermFrequencyTest, baseForm) {
+    TermFrequency table(TermFrequency::KEY_BASE_FORM);
+
+    table.add(10, "abc", 3);
+    table.add(11, "abc", 3); // identified by string
+    table.add(-1, "", 0);
+
+    ASSERT_EQ(2u, table.size());
+    EXPECT_EQ(-1, table.getEntry(0).termId_);
+    EXPECT_EQ(2u, table.getCount(12, "abc", 3));
+    EXPECT_EQ(1u, table.getCount(-1, "", 0));
+
+    table.setKeyType(TermFrequency::KEY_TERM_ID);
+    EXPECT_EQ(0u, table.size());
+}
+
+TEST(TermFrequencyTest, grow) {
+    TermFrequency table;
+    char buf[16];
+    for(int round=0; round<2; ++round)
+    {
+        // the table grows in the first round, and is reused for fewer terms in the second round
+        const int termNum = round ? 10 : 5000;
+        for(int i=0; i<termNum; ++i)
+        {
+            sprintf(buf, "t%d", i);
+            for(int j=0; j<=i%3; ++j)
+            {
+                table.add(i, buf, strlen(buf));
+                table.add(-1, buf, strlen(buf));
+            }
+        }
+
+        ASSERT_EQ(static_cast<unsigned int>(termNum * 2), table.size());
+        for(int i=0; i<termNum; ++i)
+        {
+            sprintf(buf, "t%d", i);
+            EXPECT_EQ(static_cast<unsigned int>(i%3 + 1), table.getCount(i, buf, strlen(buf)));
+            EXPECT_EQ(static_cast<unsigned int>(i%3 + 1), table.getCount(-1, buf, strlen(buf)));
+        }
+
+        table.clear();
+        for(int i=0; i<termNum; ++i)
+            EXPECT_EQ(0u, table.getCount(i, "", 0));
+    }
+}
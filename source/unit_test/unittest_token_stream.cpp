@@ -0,0 +1,232 @@
+/** \file unittest_token_stream.cpp
+ * Unit test of class TokenStreamWriter and TokenStreamReader.
+ *
+ * \version 0.1
+ * \date Oct 17, 2026
+ */
+
+#include <gtest/gtest.h>
+#include <ijma/token_stream.h>
+
+#include <string>
+#include <cstring>
+
+using namespace jma;
+using namespace std;
+
+namespace
+{
+/**
+ * Create a morpheme view.
+ */
+MorphemeView createView(const char* lexicon, int termId, int posCode, const char* posStr,
+        unsigned int byteOffset, unsigned int charOffset, unsigned int charLength)
+{
+    MorphemeView view;
+    view.lexicon_ = lexicon;
+    view.lexiconLength_ = strlen(lexicon);
+    view.termId_ = termId;
+    view.posCode_ = posCode;
+    view.posStr_ = posStr;
+    view.byteOffset_ = byteOffset;
+    view.byteLength_ = view.lexiconLength_;
+    view.charOffset_ = charOffset;
+    view.charLength_ = charLength;
+    return view;
+}
+
+/**
+ * Create a document from its payload, whose length is less than 128 bytes.
+ */
+string createDocument(const string& payload)
+{
+    return string(1, static_cast<char>(payload.size())) + payload;
+}
+}
+
+TEST(TokenStreamTest, empty) {
+    TokenStreamReader reader("", 0);
+    EXPECT_FALSE(reader.nextDocument());
+    EXPECT_FALSE(reader.isError());
+
+    string output;
+    TokenStreamWriter writer;
+    writer.beginDocument();
+    writer.endDocument(output, 0);
+
+    TokenStreamReader emptyDoc(output.data(), output.size());
+    ASSERT_TRUE(emptyDoc.nextDocument());
+    EXPECT_EQ(0U, emptyDoc.getTokenCount());
+    EXPECT_EQ(0U, emptyDoc.getTextLength());
+    TokenRecord token;
+    EXPECT_FALSE(emptyDoc.nextToken(token));
+    EXPECT_FALSE(emptyDoc.nextDocument());
+    EXPECT_FALSE(emptyDoc.isError());
+}
+
+TEST(TokenStreamTest, readWrite) {
+    const MorphemeView views[] = {
+        createView("田中", 100, 3, "名詞,固有名詞", 0, 0, 2),
+        createView("abc", -1, 45, "名詞", 1000000, 300000, 3),
+        // decomposed part might be before the previous one
+        createView("野球", 0, 0, "", 10, 5, 2),
+    };
+    const unsigned int viewNum = sizeof(views) / sizeof(views[0]);
+    const unsigned int textLength = 2000000;
+
+    string output;
+    TokenStreamWriter writer;
+    EXPECT_EQ(0, writer.getFields());
+    for(int fields=0; fields<=(TOKEN_STREAM_LEXICON | TOKEN_STREAM_POS_STR); ++fields)
+    {
+        writer.setFields(fields);
+        writer.beginDocument();
+        for(unsigned int i=0; i<viewNum; ++i)
+            writer.addToken(views[i]);
+        writer.endDocument(output, textLength);
+    }
+
+    // the tokens not ended are discarded
+    writer.beginDocument();
+    writer.addToken(views[0]);
+    writer.beginDocument();
+    writer.endDocument(output, 0);
+
+    TokenStreamReader reader(output.data(), output.size());
+    TokenRecord token;
+    for(int fields=0; fields<=(TOKEN_STREAM_LEXICON | TOKEN_STREAM_POS_STR); ++fields)
+    {
+        ASSERT_TRUE(reader.nextDocument());
+        EXPECT_EQ(fields, reader.getFields());
+        ASSERT_EQ(viewNum, reader.getTokenCount());
+        EXPECT_EQ(textLength, reader.getTextLength());
+
+        for(unsigned int i=0; i<viewNum; ++i)
+        {
+            ASSERT_TRUE(reader.nextToken(token));
+            EXPECT_EQ(views[i].termId_, token.termId_);
+            EXPECT_EQ(views[i].posCode_, token.posCode_);
+            EXPECT_EQ(views[i].byteOffset_, token.byteOffset_);
+            EXPECT_EQ(views[i].byteLength_, token.byteLength_);
+            EXPECT_EQ(views[i].charOffset_, token.charOffset_);
+            EXPECT_EQ(views[i].charLength_, token.charLength_);
+
+            const string lexicon(token.lexicon_, token.lexiconLength_);
+            EXPECT_EQ((fields & TOKEN_STREAM_LEXICON) ? views[i].lexicon_ : "", lexicon);
+            const string posStr(token.posStr_, token.posStrLength_);
+            EXPECT_EQ((fields & TOKEN_STREAM_POS_STR) ? views[i].posStr_ : "", posStr);
+        }
+        EXPECT_FALSE(reader.nextToken(token));
+    }
+
+    ASSERT_TRUE(reader.nextDocument());
+    EXPECT_EQ(0U, reader.getTokenCount());
+    EXPECT_FALSE(reader.nextDocument());
+    EXPECT_FALSE(reader.isError());
+
+    // the rest tokens are skipped
+    TokenStreamReader skipReader(output.data(), output.size());
+    ASSERT_TRUE(skipReader.nextDocument());
+    ASSERT_TRUE(skipReader.nextToken(token));
+    ASSERT_TRUE(skipReader.nextDocument());
+    ASSERT_TRUE(skipReader.nextToken(token));
+    EXPECT_EQ(views[0].byteOffset_, token.byteOffset_);
+    EXPECT_EQ(TOKEN_STREAM_LEXICON, skipReader.getFields());
+}
+
+TEST(TokenStreamTest, corrupted) {
+    string output;
+    TokenStreamWriter writer(TOKEN_STREAM_LEXICON);
+    writer.beginDocument();
+    writer.addToken(createView("田中", 100, 3, "", 0, 0, 2));
+    writer.endDocument(output, strlen("田中"));
+
+    // truncated at each byte
+    for(unsigned int len=1; len<output.size(); ++len)
+    {
+        TokenStreamReader reader(output.data(), len);
+        EXPECT_FALSE(reader.nextDocument());
+        EXPECT_TRUE(reader.isError());
+    }
+
+    // the string length exceeds the document
+    string badStr = output;
+    badStr[badStr.size() - strlen("田中") - 1] = 100;
+    TokenStreamReader reader(badStr.data(), badStr.size());
+    ASSERT_TRUE(reader.nextDocument());
+    TokenRecord token;
+    EXPECT_FALSE(reader.nextToken(token));
+    EXPECT_TRUE(reader.isError());
+    EXPECT_FALSE(reader.nextDocument());
+
+    // truncated in token, with the payload length updated
+    for(unsigned int len=output.size()-1; len>output.size()-strlen("田中")-8; --len)
+    {
+        const string truncated = createDocument(output.substr(1, len - 1));
+        TokenStreamReader truncReader(truncated.data(), truncated.size());
+        ASSERT_TRUE(truncReader.nextDocument());
+        EXPECT_FALSE(truncReader.nextToken(token));
+        EXPECT_TRUE(truncReader.isError());
+    }
+}
+
+TEST(TokenStreamTest, overlongVarint) {
+    // fields, token count, text length, and a token without strings
+    const string header("\x00\x01\x0A", 3);
+    const string range("\x00\x02\x00\x02", 4);
+    TokenRecord token;
+
+    // the maximum unsigned int in 5 bytes
+    const string maxStr = createDocument(header + "\xFF\xFF\xFF\xFF\x0F" + "\x01" + range);
+    TokenStreamReader maxReader(maxStr.data(), maxStr.size());
+    ASSERT_TRUE(maxReader.nextDocument());
+    ASSERT_TRUE(maxReader.nextToken(token));
+    EXPECT_EQ(-2, token.termId_);
+    EXPECT_FALSE(maxReader.isError());
+
+    // the high bits beyond unsigned int in the 5th byte, and more than 5 bytes
+    const char* overlongs[] = {"\xFF\xFF\xFF\xFF\x1F", "\x80\x80\x80\x80\x40", "\x80\x80\x80\x80\x80\x00"};
+    for(unsigned int i=0; i<sizeof(overlongs) / sizeof(overlongs[0]); ++i)
+    {
+        const string overStr = createDocument(header + overlongs[i] + string(1, '\0') + "\x01" + range);
+        TokenStreamReader reader(overStr.data(), overStr.size());
+        ASSERT_TRUE(reader.nextDocument());
+        EXPECT_FALSE(reader.nextToken(token));
+        EXPECT_TRUE(reader.isError());
+    }
+
+    // the overlong payload length
+    const string overLength("\x80\x80\x80\x80\x10", 5);
+    TokenStreamReader lengthReader(overLength.data(), overLength.size());
+    EXPECT_FALSE(lengthReader.nextDocument());
+    EXPECT_TRUE(lengthReader.isError());
+}
+
+TEST(TokenStreamTest, outOfText) {
+    // fields, token count, text length 10, term id and POS code
+    const string header("\x00\x01\x0A\x01\x01", 5);
+    TokenRecord token;
+
+    // byte offset delta, byte length, char offset delta, char length, zigzag encoded deltas
+    const char* ranges[] = {
+        "\x14\x00\x00\x00", // byte range at the text end
+        "\x00\x0A\x00\x0A", // the whole text
+        "\x16\x00\x00\x00", // byte offset after the text end
+        "\x00\x0B\x00\x00", // byte length exceeds the text
+        "\x01\x00\x00\x00", // byte offset before the text start
+        "\x02\x0A\x00\x00", // byte range exceeds the text
+        "\x00\x00\x00\x0B", // char length exceeds the text
+        "\x00\x00\x03\x00" // char offset before the text start
+    };
+    const unsigned int rangeNum = sizeof(ranges) / sizeof(ranges[0]);
+    const unsigned int validNum = 2;
+
+    for(unsigned int i=0; i<rangeNum; ++i)
+    {
+        const string doc = createDocument(header + string(ranges[i], 4));
+        TokenStreamReader reader(doc.data(), doc.size());
+        ASSERT_TRUE(reader.nextDocument());
+        EXPECT_EQ(i < validNum, reader.nextToken(token)) << i;
+        EXPECT_EQ(i >= validNum, reader.isError()) << i;
+    }
+}